@@ -0,0 +1,129 @@
+// Signatures per second for the websocket/REST auth headers.
+//
+// Usage: auth_sign_bench [--signatures N] [--bits N]
+//
+// Generates a throwaway RSA key, then compares three ways of getting a
+// signed header set:
+// - sign_ws_message, which parses the PEM on every call
+// - AuthSigner::build_headers, with the key parsed once and a prepared
+//   digest context
+// - AuthSigner::presigned, which is what a reconnect pays when the
+//   background presigner has already signed
+// One signature from each signing path is verified against the public key.
+
+#include "bench_support.hpp"
+
+#include "kalshi/core/auth.hpp"
+#include "kalshi/core/ws_endpoints.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using PkeyPtr = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+
+std::string to_pem(EVP_PKEY* pkey)
+{
+  std::unique_ptr<BIO, decltype(&BIO_free)> bio(BIO_new(BIO_s_mem()), &BIO_free);
+  if (!bio || PEM_write_bio_PrivateKey(bio.get(), pkey, nullptr, nullptr, 0, nullptr, nullptr) != 1)
+  {
+    return {};
+  }
+  char* data = nullptr;
+  auto len = BIO_get_mem_data(bio.get(), &data);
+  return std::string(data, static_cast<std::size_t>(len));
+}
+
+bool verify(EVP_PKEY* pkey, std::string_view message, std::string_view signature_b64)
+{
+  std::vector<unsigned char> signature(signature_b64.size());
+  auto len = EVP_DecodeBlock(signature.data(),
+                             reinterpret_cast<const unsigned char*>(signature_b64.data()),
+                             static_cast<int>(signature_b64.size()));
+  if (len <= 0)
+  {
+    return false;
+  }
+  // EVP_DecodeBlock counts base64 padding as zero bytes.
+  auto padding = signature_b64.ends_with("==") ? 2 : signature_b64.ends_with("=") ? 1 : 0;
+  signature.resize(static_cast<std::size_t>(len - padding));
+
+  std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+  EVP_PKEY_CTX* pkey_ctx = nullptr;
+  return ctx && EVP_DigestVerifyInit(ctx.get(), &pkey_ctx, EVP_sha256(), nullptr, pkey) > 0 &&
+         EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) > 0 &&
+         EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1) > 0 &&
+         EVP_DigestVerify(ctx.get(), signature.data(), signature.size(),
+                          reinterpret_cast<const unsigned char*>(message.data()), message.size()) == 1;
+}
+
+template <typename Fn>
+void report(std::string_view label, std::uint64_t count, Fn fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < count; ++i)
+  {
+    fn(static_cast<std::int64_t>(i));
+  }
+  auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  auto per = static_cast<double>(ns) / static_cast<double>(count);
+  std::printf("%-24.*s %10.0f /s %12.0f ns/op\n",
+              static_cast<int>(label.size()),
+              label.data(),
+              1e9 / per,
+              per);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto count = kalshi::bench::arg_uint(argc, argv, "--signatures", 2000);
+  auto bits = kalshi::bench::arg_uint(argc, argv, "--bits", 2048);
+
+  PkeyPtr pkey(EVP_RSA_gen(static_cast<unsigned>(bits)), &EVP_PKEY_free);
+  if (!pkey)
+  {
+    std::printf("key generation failed\n");
+    return 1;
+  }
+  kalshi::AuthConfig auth{.key_id = "bench-key", .private_key_pem = to_pem(pkey.get())};
+  auto signer = kalshi::AuthSigner::create(auth);
+  if (!signer)
+  {
+    std::printf("signer: %s (%s)\n", kalshi::to_string(signer.error()), kalshi::last_sign_error());
+    return 1;
+  }
+
+  const std::string path = kalshi::WS_PATH;
+  auto message = [&](std::int64_t ts) { return std::to_string(ts) + "GET" + path; };
+
+  auto legacy = kalshi::sign_ws_message(auth.private_key_pem, message(1));
+  auto cached = signer->build_headers("GET", path, 1);
+  bool ok = legacy && cached && verify(pkey.get(), message(1), *legacy) &&
+            verify(pkey.get(), message(1), (*cached)[1].second);
+  std::printf("rsa_bits=%llu signatures_verify=%s\n",
+              static_cast<unsigned long long>(bits),
+              ok ? "ok" : "FAILED");
+
+  std::size_t sink = 0;
+  report("parse_per_call", count, [&](std::int64_t ts)
+         { sink += kalshi::sign_ws_message(auth.private_key_pem, message(ts))->size(); });
+  report("auth_signer", count, [&](std::int64_t ts)
+         { sink += signer->build_headers("GET", path, ts)->size(); });
+
+  (void)signer->presign("GET", path, 1000);
+  report("presigned_lookup", count * 100, [&](std::int64_t)
+         { sink += signer->presigned("GET", path, 1000, 4000)->size(); });
+  return sink == 0 ? 1 : 0;
+}
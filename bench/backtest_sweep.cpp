@@ -0,0 +1,216 @@
+// Parameter sweep of the sample market maker over captures.
+//
+// Usage: backtest_sweep [--captures A,B,...] [--logs N] [--messages N] [--markets N]
+//                       [--dir PATH] [--threads N] [--half-spreads 1,2,3] [--sizes 5,10]
+//                       [--requote-moves 1,2]
+//
+// Each capture (or, without --captures, N generated ones written to --dir)
+// is parsed once into an event log next to it (<capture>.evlog) and mapped
+// read-only. Every (log, parameter set) pair is then one backtest job on a
+// work-stealing pool. The sweep runs on one thread and again on --threads
+// to show scaling, and the summary lists parameter sets by total net P&L
+// across logs, with the worst and best single log.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+
+#include "kalshi/core/work_stealing_pool.hpp"
+#include "kalshi/sim/backtest.hpp"
+#include "kalshi/sim/event_log.hpp"
+#include "kalshi/sim/sweep.hpp"
+#include "kalshi/strategy/market_maker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+std::vector<std::string> split(const std::string& list)
+{
+  std::vector<std::string> items;
+  std::size_t start = 0;
+  while (start <= list.size())
+  {
+    auto end = list.find(',', start);
+    if (end == std::string::npos)
+    {
+      end = list.size();
+    }
+    if (end > start)
+    {
+      items.push_back(list.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+  return items;
+}
+
+std::vector<std::uint32_t> split_uints(const std::string& list)
+{
+  std::vector<std::uint32_t> values;
+  for (const auto& item : split(list))
+  {
+    values.push_back(static_cast<std::uint32_t>(std::stoul(item)));
+  }
+  return values;
+}
+
+double cents_to_dollars(std::int64_t cents) { return static_cast<double>(cents) / 100.0; }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto captures = split(kalshi::bench::arg_value(argc, argv, "--captures", {}));
+  auto logs_wanted = kalshi::bench::arg_uint(argc, argv, "--logs", 8);
+  auto messages = kalshi::bench::arg_uint(argc, argv, "--messages", 500000);
+  auto markets = kalshi::bench::arg_uint(argc, argv, "--markets", 200);
+  auto dir = kalshi::bench::arg_value(argc, argv, "--dir", "/tmp");
+  auto threads = kalshi::bench::arg_uint(argc, argv, "--threads", std::max(1u, std::thread::hardware_concurrency()));
+  auto half_spreads = split_uints(kalshi::bench::arg_value(argc, argv, "--half-spreads", "1,2,3,4"));
+  auto sizes = split_uints(kalshi::bench::arg_value(argc, argv, "--sizes", "5,10"));
+  auto requote_moves = split_uints(kalshi::bench::arg_value(argc, argv, "--requote-moves", "1,2"));
+
+  if (captures.empty())
+  {
+    for (std::uint64_t i = 0; i < logs_wanted; ++i)
+    {
+      kalshi::bench::GeneratorOptions generator_options;
+      generator_options.markets = markets;
+      generator_options.seed = 1000 + i;
+      kalshi::bench::MarketDataGenerator generator(generator_options);
+      auto path = dir + "/backtest_sweep_" + std::to_string(i) + ".jsonl";
+      if (!generator.generate(messages).write_capture(path))
+      {
+        std::fprintf(stderr, "failed to write %s\n", path.c_str());
+        return 1;
+      }
+      captures.push_back(path);
+    }
+  }
+
+  std::vector<kalshi::sim::EventLog> logs;
+  auto convert_start = std::chrono::steady_clock::now();
+  std::uint64_t converted_messages = 0;
+  for (const auto& capture : captures)
+  {
+    auto log_path = capture + ".evlog";
+    auto stats = kalshi::sim::convert_capture(capture, log_path);
+    if (!stats)
+    {
+      std::fprintf(stderr, "%s: %s\n", capture.c_str(), kalshi::sim::to_string(stats.error()));
+      return 1;
+    }
+    converted_messages += stats->messages;
+    auto log = kalshi::sim::EventLog::open(log_path);
+    if (!log)
+    {
+      std::fprintf(stderr, "%s: %s\n", log_path.c_str(), kalshi::sim::to_string(log.error()));
+      return 1;
+    }
+    logs.push_back(std::move(*log));
+  }
+  auto convert_ns = kalshi::bench::elapsed_ns(convert_start, std::chrono::steady_clock::now());
+  std::uint64_t events = 0;
+  for (const auto& log : logs)
+  {
+    events += log.events().size();
+  }
+  std::printf("logs=%zu messages=%llu records=%llu convert=%.2f M msg/s\n",
+              logs.size(),
+              static_cast<unsigned long long>(converted_messages),
+              static_cast<unsigned long long>(events),
+              static_cast<double>(converted_messages) * 1e3 / static_cast<double>(convert_ns));
+
+  std::vector<kalshi::strategy::MarketMakerParams> grid;
+  for (auto half_spread : half_spreads)
+  {
+    for (auto size : sizes)
+    {
+      for (auto requote_move : requote_moves)
+      {
+        grid.push_back(kalshi::strategy::MarketMakerParams{.half_spread = static_cast<kalshi::md::Price>(half_spread),
+                                                           .size = size,
+                                                           .min_book_width = 2,
+                                                           .requote_move = static_cast<kalshi::md::Price>(requote_move)});
+      }
+    }
+  }
+
+  kalshi::sim::BacktestOptions options;
+  options.limits.max_position = 1'000'000;
+  options.limits.max_market_open_orders = 16;
+  options.limits.max_total_open_orders = 1'000'000;
+  options.limits.max_total_notional = 1'000'000'000'000;
+  auto run = [&options](const kalshi::sim::EventLog& log, const kalshi::strategy::MarketMakerParams& params)
+  {
+    kalshi::strategy::MarketMaker maker(std::max<std::uint32_t>(1, log.market_count()), params);
+    return kalshi::sim::run_backtest(log, maker, options);
+  };
+
+  std::vector<std::uint64_t> thread_counts{1};
+  if (threads > 1)
+  {
+    thread_counts.push_back(threads);
+  }
+  kalshi::sim::SweepReport report;
+  double single_ns = 0.0;
+  for (auto count : thread_counts)
+  {
+    kalshi::WorkStealingPool pool(count);
+    auto start = std::chrono::steady_clock::now();
+    report = kalshi::sim::run_sweep(pool,
+                                    std::span<const kalshi::sim::EventLog>(logs),
+                                    std::span<const kalshi::strategy::MarketMakerParams>(grid),
+                                    run);
+    auto ns = static_cast<double>(kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+    single_ns = count == 1 ? ns : single_ns;
+    auto jobs = logs.size() * grid.size();
+    std::printf("threads=%-3llu jobs=%zu %.2f s  %.1f M events/s  speedup=%.2fx steals=%llu\n",
+                static_cast<unsigned long long>(count),
+                jobs,
+                ns / 1e9,
+                static_cast<double>(events * grid.size()) * 1e3 / ns,
+                single_ns / ns,
+                static_cast<unsigned long long>(pool.steals()));
+  }
+
+  auto summaries = report.summaries;
+  std::sort(summaries.begin(),
+            summaries.end(),
+            [](const auto& a, const auto& b) { return a.total.net > b.total.net; });
+  std::printf("%-6s %-5s %-7s %12s %12s %12s %10s %9s %10s %11s %11s\n",
+              "spread",
+              "size",
+              "requote",
+              "net$",
+              "realized$",
+              "unreal$",
+              "fees$",
+              "fills",
+              "contracts",
+              "worst_log$",
+              "best_log$");
+  for (const auto& summary : summaries)
+  {
+    const auto& params = grid[summary.params];
+    std::printf("%-6u %-5u %-7u %12.2f %12.2f %12.2f %10.2f %9llu %10llu %11.2f %11.2f\n",
+                params.half_spread,
+                params.size,
+                params.requote_move,
+                cents_to_dollars(summary.total.net),
+                cents_to_dollars(summary.total.realized),
+                cents_to_dollars(summary.total.unrealized),
+                cents_to_dollars(summary.total.fees),
+                static_cast<unsigned long long>(summary.total.fills),
+                static_cast<unsigned long long>(summary.total.contracts),
+                cents_to_dollars(summary.worst_net),
+                cents_to_dollars(summary.best_net));
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "kalshi/logging/logger.hpp"
+
+namespace kalshi::bench
+{
+
+/** Logger that discards everything; keeps logging cost out of measurements. */
+class NullLogger : public kalshi::logging::Logger
+{
+public:
+  using Logger::log;
+
+  void log(kalshi::logging::LogEvent) override {}
+
+  [[nodiscard]] kalshi::logging::LogLevel level() const override
+  {
+    return kalshi::logging::LogLevel::Error;
+  }
+};
+
+/** Latency percentiles in nanoseconds. */
+struct LatencySummary
+{
+  std::size_t samples = 0;
+  std::int64_t p50 = 0;
+  std::int64_t p90 = 0;
+  std::int64_t p99 = 0;
+  std::int64_t p999 = 0;
+  std::int64_t max = 0;
+};
+
+/**
+ * Summarize latency samples. Sorts the input in place.
+ * @param samples_ns Samples in nanoseconds.
+ * @return Percentile summary.
+ */
+inline LatencySummary summarize(std::vector<std::int64_t>& samples_ns)
+{
+  LatencySummary out;
+  out.samples = samples_ns.size();
+  if (samples_ns.empty())
+  {
+    return out;
+  }
+  std::sort(samples_ns.begin(), samples_ns.end());
+  auto at = [&](double q)
+  {
+    auto idx = static_cast<std::size_t>(q * static_cast<double>(samples_ns.size() - 1));
+    return samples_ns[idx];
+  };
+  out.p50 = at(0.50);
+  out.p90 = at(0.90);
+  out.p99 = at(0.99);
+  out.p999 = at(0.999);
+  out.max = samples_ns.back();
+  return out;
+}
+
+/**
+ * Print a latency summary line.
+ * @param label Row label.
+ * @param s Summary to print.
+ * @return void.
+ */
+inline void print_latency(std::string_view label, const LatencySummary& s)
+{
+  std::printf("%-28.*s n=%zu p50=%lldns p90=%lldns p99=%lldns p99.9=%lldns max=%lldns\n",
+              static_cast<int>(label.size()),
+              label.data(),
+              s.samples,
+              static_cast<long long>(s.p50),
+              static_cast<long long>(s.p90),
+              static_cast<long long>(s.p99),
+              static_cast<long long>(s.p999),
+              static_cast<long long>(s.max));
+}
+
+/**
+ * Return the value following `--name` on the command line.
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @param name Flag name including leading dashes.
+ * @param fallback Value when the flag is absent.
+ * @return Flag value or fallback.
+ */
+inline std::string arg_value(int argc, char** argv, std::string_view name, std::string fallback)
+{
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (name == argv[i])
+    {
+      return argv[i + 1];
+    }
+  }
+  return fallback;
+}
+
+/**
+ * Return an unsigned flag value or fallback.
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @param name Flag name including leading dashes.
+ * @param fallback Value when the flag is absent.
+ * @return Parsed value or fallback.
+ */
+inline std::uint64_t arg_uint(int argc, char** argv, std::string_view name, std::uint64_t fallback)
+{
+  auto value = arg_value(argc, argv, name, {});
+  if (value.empty())
+  {
+    return fallback;
+  }
+  return std::stoull(value);
+}
+
+/**
+ * Elapsed nanoseconds between two steady clock points.
+ * @param from Start time.
+ * @param to End time.
+ * @return Nanoseconds.
+ */
+inline std::int64_t elapsed_ns(std::chrono::steady_clock::time_point from,
+                               std::chrono::steady_clock::time_point to)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+} // namespace kalshi::bench
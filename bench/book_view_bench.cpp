@@ -0,0 +1,251 @@
+// Reader/writer interference on seqlocked book views.
+//
+// Usage: book_view_bench [--messages N] [--markets N] [--readers N] [--iterations N] [--pin 0|1]
+//
+// A writer thread replays deltas into BookViews. Each row adds reader
+// threads that spin reading depth views, then top of book, with
+// Seqlock::try_read(). "hot" readers all read the busiest market, which is
+// the one the writer touches most. "spread" readers cycle through every
+// market. Each row reports:
+// - the writer's cost per delta
+// - reads per second per reader
+// - how often a read had to be retried
+// Readers also check every depth view they get (prices strictly
+// descending, sizes non-zero), so a torn read that slipped through shows up
+// as "invalid". With --pin 1 the writer runs on CPU 0 and reader i on
+// CPU i + 1, so the readers share cache lines with the writer across cores.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+
+#include "kalshi/md/model/book_views.hpp"
+#include "kalshi/md/parse/event_parser.hpp"
+#include "kalshi/md/parse/message_parser.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct ReaderStats
+{
+  std::uint64_t reads = 0;
+  std::uint64_t retries = 0;
+  std::uint64_t invalid = 0;
+};
+
+struct Row
+{
+  double writer_ns = 0.0;
+  double reads_per_sec = 0.0;
+  double retry_pct = 0.0;
+  std::uint64_t invalid = 0;
+};
+
+void pin_to(unsigned cpu)
+{
+  auto cpus = std::max(1u, std::thread::hardware_concurrency());
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % cpus, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+bool valid(const kalshi::md::DepthView& view)
+{
+  auto check = [](const auto& levels, std::uint32_t count)
+  {
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+      if (levels[i].size == 0 || (i > 0 && levels[i].price >= levels[i - 1].price))
+      {
+        return false;
+      }
+    }
+    return count <= kalshi::md::BOOK_VIEW_DEPTH;
+  };
+  return check(view.yes, view.yes_count) && check(view.no, view.no_count);
+}
+
+template <typename T>
+void read_counted(const kalshi::md::Seqlock<T>& lock, T& out, ReaderStats& stats)
+{
+  while (!lock.try_read(out))
+  {
+    ++stats.retries;
+    kalshi::md::cpu_relax();
+  }
+  ++stats.reads;
+}
+
+Row run(kalshi::md::BookViews& views,
+        const std::vector<kalshi::md::OrderbookDelta>& deltas,
+        std::uint64_t iterations,
+        std::size_t readers,
+        bool hot,
+        kalshi::md::MarketId hot_market,
+        bool pin)
+{
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> started{0};
+  std::vector<ReaderStats> stats(readers);
+  std::vector<std::thread> threads;
+  for (std::size_t r = 0; r < readers; ++r)
+  {
+    threads.emplace_back(
+        [&, r]
+        {
+          if (pin)
+          {
+            pin_to(static_cast<unsigned>(r + 1));
+          }
+          auto& mine = stats[r];
+          auto markets = views.market_count();
+          kalshi::md::MarketId next = 0;
+          kalshi::md::DepthView depth;
+          kalshi::md::TopOfBook top;
+          started.fetch_add(1);
+          while (!stop.load(std::memory_order_relaxed))
+          {
+            auto id = hot ? hot_market : next;
+            next = next + 1 == markets ? 0 : next + 1;
+            read_counted(views.depth_lock(id), depth, mine);
+            if (!valid(depth))
+            {
+              ++mine.invalid;
+            }
+            read_counted(views.top_lock(id), top, mine);
+          }
+        });
+  }
+  while (started.load() != readers)
+  {
+    std::this_thread::yield();
+  }
+
+  if (pin)
+  {
+    pin_to(0);
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < iterations; ++i)
+  {
+    for (const auto& d : deltas)
+    {
+      views.on_delta(d);
+    }
+  }
+  auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  stop.store(true);
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+
+  Row row;
+  row.writer_ns = static_cast<double>(ns) / static_cast<double>(iterations * deltas.size());
+  std::uint64_t reads = 0;
+  std::uint64_t retries = 0;
+  for (const auto& s : stats)
+  {
+    reads += s.reads;
+    retries += s.retries;
+    row.invalid += s.invalid;
+  }
+  if (readers > 0)
+  {
+    row.reads_per_sec = static_cast<double>(reads) / static_cast<double>(readers) /
+                        (static_cast<double>(ns) / 1e9);
+    row.retry_pct = reads == 0 ? 0.0 : 100.0 * static_cast<double>(retries) / static_cast<double>(reads);
+  }
+  return row;
+}
+
+void print(std::string_view label, std::size_t readers, const Row& row)
+{
+  std::printf("%-6.*s readers=%zu writer=%6.1f ns/delta reads=%10.0f /s/reader retries=%6.2f%% "
+              "invalid=%llu\n",
+              static_cast<int>(label.size()),
+              label.data(),
+              readers,
+              row.writer_ns,
+              row.reads_per_sec,
+              row.retry_pct,
+              static_cast<unsigned long long>(row.invalid));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto total = kalshi::bench::arg_uint(argc, argv, "--messages", 200000);
+  auto max_readers = kalshi::bench::arg_uint(argc, argv, "--readers", 3);
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 5);
+  auto pin = kalshi::bench::arg_uint(argc, argv, "--pin", 1) != 0;
+
+  kalshi::bench::GeneratorOptions generator_options;
+  generator_options.markets = kalshi::bench::arg_uint(argc, argv, "--markets", 500);
+  kalshi::bench::MarketDataGenerator generator(generator_options);
+  auto buffer = generator.generate(total);
+
+  kalshi::md::BookViews views(static_cast<std::uint32_t>(generator_options.markets));
+  std::vector<kalshi::md::OrderbookDelta> deltas;
+  deltas.reserve(buffer.size());
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+  {
+    auto type = kalshi::md::parse_message_type(buffer[i]);
+    if (!type)
+    {
+      continue;
+    }
+    if (*type == kalshi::md::MessageType::OrderbookSnapshot)
+    {
+      if (auto snapshot = kalshi::md::parse_orderbook_snapshot(buffer[i]))
+      {
+        views.on_snapshot(*snapshot);
+      }
+    }
+    else if (*type == kalshi::md::MessageType::OrderbookDelta)
+    {
+      if (auto delta = kalshi::md::parse_orderbook_delta(buffer[i]))
+      {
+        deltas.push_back(std::move(*delta));
+      }
+    }
+  }
+
+  // The busiest market is the one hot readers contend on.
+  kalshi::md::BookViewIndex index(views);
+  std::vector<std::size_t> per_market(views.market_count(), 0);
+  for (const auto& d : deltas)
+  {
+    if (auto id = index.find(d.market_ticker))
+    {
+      ++per_market[*id];
+    }
+  }
+  auto hot_market = static_cast<kalshi::md::MarketId>(
+      std::max_element(per_market.begin(), per_market.end()) - per_market.begin());
+  std::printf("deltas=%zu markets=%u hot_market_share=%.1f%% cpus=%u\n",
+              deltas.size(),
+              views.market_count(),
+              100.0 * static_cast<double>(per_market[hot_market]) / static_cast<double>(deltas.size()),
+              std::thread::hardware_concurrency());
+
+  print("none", 0, run(views, deltas, iterations, 0, false, hot_market, pin));
+  for (std::size_t readers = 1; readers <= max_readers; ++readers)
+  {
+    print("hot", readers, run(views, deltas, iterations, readers, true, hot_market, pin));
+    print("spread", readers, run(views, deltas, iterations, readers, false, hot_market, pin));
+  }
+  return 0;
+}
@@ -0,0 +1,217 @@
+// orderbook_delta parse cost: compact-layout scanner vs the simdjson path.
+//
+// Usage: delta_parse_bench [--messages N] [--markets N] [--iterations N]
+//
+// Before timing, every generated delta plus a set of hand-written edge cases
+// is run through both scan_orderbook_delta and parse_orderbook_delta. The
+// scanner may decline a message, but whenever it accepts one the result must
+// match the simdjson path field for field; any mismatch exits non-zero.
+// Timings are reported per message for the bare parsers and for
+// Dispatcher::on_message with the fast path on and off.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+
+#include "kalshi/md/dispatcher.hpp"
+#include "kalshi/md/parse/delta_scanner.hpp"
+#include "kalshi/md/parse/event_parser.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+/** Sink that only counts, so the dispatcher rows measure parsing. */
+struct CountingSink
+{
+  void on_snapshot(const kalshi::md::OrderbookSnapshot&) { ++events; }
+  void on_delta(const kalshi::md::OrderbookDelta& d) { sum += d.price; ++events; }
+  void on_trade(const kalshi::md::TradeEvent&) { ++events; }
+  void on_status(const kalshi::md::MarketStatusUpdate&) { ++events; }
+
+  std::size_t events = 0;
+  std::uint64_t sum = 0;
+};
+
+bool same_delta(const kalshi::md::OrderbookDelta& a, const kalshi::md::OrderbookDelta& b)
+{
+  return a.market_ticker == b.market_ticker && a.sequence == b.sequence && a.price == b.price &&
+         a.delta == b.delta && a.side == b.side && a.client_order_id == b.client_order_id &&
+         a.ts == b.ts;
+}
+
+/** Layouts the scanner must accept and parse exactly like simdjson. */
+const std::vector<std::string_view> ACCEPTED_CASES = {
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED-23DEC-T3.00","price":96,"delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED-23DEC-T3.00","price":96,"delta":-54,"side":"no","client_order_id":"abc-1"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":0,"delta":0,"side":"no","ts":"2022-11-22T20:44:01Z"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":1,"delta":7,"side":"yes","ts":1767225600,"x":null}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":1,"delta":7,"side":"yes","client_order_id":"a","client_order_id":"b"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":9999999999999999999,"msg":{"market_ticker":"FED","price":100,"delta":-2147483648,"side":"yes"}})",
+};
+
+/** Layouts the scanner must leave to the simdjson path. */
+const std::vector<std::string_view> DECLINED_CASES = {
+    R"({"type": "orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"}})",
+    R"({"sid":2,"type":"orderbook_delta","seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"price":96,"market_ticker":"FED","delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"F\"D","price":96,"delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":101,"delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96.0,"delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":096,"delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-0,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":2147483648,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"maybe"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes","price":5}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes","client_order_id":7}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes","extra":{"a":1}}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"},"id":1})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"}} )",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"})",
+    R"({"type":"orderbook_delta","sid":2,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"}})",
+    R"({"type":"orderbook_delta","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"}}garbage)",
+    R"({"type":"trade","sid":2,"seq":3,"msg":{"market_ticker":"FED","price":96,"delta":-54,"side":"yes"}})",
+};
+
+struct DiffResult
+{
+  std::size_t accepted = 0;
+  std::size_t declined = 0;
+  std::size_t mismatches = 0;
+};
+
+void check(std::string_view json, DiffResult& result)
+{
+  auto fast = kalshi::md::scan_orderbook_delta(json);
+  if (!fast)
+  {
+    ++result.declined;
+    return;
+  }
+  ++result.accepted;
+  auto slow = kalshi::md::parse_orderbook_delta(json);
+  if (!slow || !same_delta(*fast, *slow))
+  {
+    ++result.mismatches;
+    std::fprintf(stderr, "mismatch: %.*s\n", static_cast<int>(json.size()), json.data());
+  }
+}
+
+template <typename Fn>
+double ns_per_message(const std::vector<std::string_view>& deltas, std::uint64_t iterations, Fn fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < iterations; ++i)
+  {
+    for (auto json : deltas)
+    {
+      fn(json);
+    }
+  }
+  auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  return static_cast<double>(ns) / static_cast<double>(iterations * deltas.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto total = kalshi::bench::arg_uint(argc, argv, "--messages", 200000);
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 5);
+
+  kalshi::bench::GeneratorOptions generator_options;
+  generator_options.markets = kalshi::bench::arg_uint(argc, argv, "--markets", 100);
+  kalshi::bench::MarketDataGenerator generator(generator_options);
+  auto buffer = generator.generate(total);
+
+  std::vector<std::string_view> deltas;
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+  {
+    auto type = kalshi::md::parse_message_type(buffer[i]);
+    if (type && *type == kalshi::md::MessageType::OrderbookDelta)
+    {
+      deltas.push_back(buffer[i]);
+    }
+  }
+  if (deltas.empty())
+  {
+    std::fprintf(stderr, "no deltas generated\n");
+    return 1;
+  }
+
+  DiffResult generated;
+  for (auto json : deltas)
+  {
+    check(json, generated);
+  }
+  DiffResult accepted;
+  for (auto json : ACCEPTED_CASES)
+  {
+    check(json, accepted);
+  }
+  DiffResult declined;
+  for (auto json : DECLINED_CASES)
+  {
+    check(json, declined);
+  }
+  std::printf("differential generated: accepted=%zu declined=%zu mismatches=%zu\n",
+              generated.accepted,
+              generated.declined,
+              generated.mismatches);
+  std::printf("differential edge cases: accepted=%zu/%zu declined=%zu/%zu mismatches=%zu\n",
+              accepted.accepted,
+              ACCEPTED_CASES.size(),
+              declined.declined,
+              DECLINED_CASES.size(),
+              accepted.mismatches + declined.mismatches);
+  if (generated.mismatches != 0 || generated.declined != 0 || accepted.mismatches != 0 ||
+      accepted.accepted != ACCEPTED_CASES.size() || declined.mismatches != 0 ||
+      declined.declined != DECLINED_CASES.size())
+  {
+    return 1;
+  }
+
+  std::uint64_t sink_guard = 0;
+  auto simdjson_ns = ns_per_message(deltas,
+                                    iterations,
+                                    [&](std::string_view json)
+                                    {
+                                      auto d = kalshi::md::parse_orderbook_delta(json);
+                                      sink_guard += d ? d->price : 0;
+                                    });
+  auto scan_ns = ns_per_message(deltas,
+                                iterations,
+                                [&](std::string_view json)
+                                {
+                                  auto d = kalshi::md::scan_orderbook_delta(json);
+                                  sink_guard += d ? d->price : 0;
+                                });
+
+  CountingSink sink;
+  kalshi::md::Dispatcher<CountingSink> dispatcher(sink);
+  dispatcher.set_fast_delta_scan(false);
+  auto dispatch_slow_ns = ns_per_message(
+      deltas, iterations, [&](std::string_view json) { (void)dispatcher.on_message(json); });
+  dispatcher.set_fast_delta_scan(true);
+  auto dispatch_fast_ns = ns_per_message(
+      deltas, iterations, [&](std::string_view json) { (void)dispatcher.on_message(json); });
+
+  std::printf("deltas=%zu iterations=%llu\n",
+              deltas.size(),
+              static_cast<unsigned long long>(iterations));
+  std::printf("%-28s %8.1f ns/msg\n", "parse_orderbook_delta", simdjson_ns);
+  std::printf("%-28s %8.1f ns/msg (%.1fx)\n", "scan_orderbook_delta", scan_ns, simdjson_ns / scan_ns);
+  std::printf("%-28s %8.1f ns/msg\n", "dispatcher simdjson", dispatch_slow_ns);
+  std::printf("%-28s %8.1f ns/msg (%.1fx)\n",
+              "dispatcher fast_delta_scan",
+              dispatch_fast_ns,
+              dispatch_slow_ns / dispatch_fast_ns);
+  std::printf("checksum=%llu events=%zu\n",
+              static_cast<unsigned long long>(sink_guard + sink.sum),
+              sink.events);
+  return 0;
+}
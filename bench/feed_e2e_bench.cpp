@@ -0,0 +1,195 @@
+// End-to-end FeedHandler throughput/latency against the loopback mock exchange.
+//
+// Usage: feed_e2e_bench [--messages N] [--rate MSGS_PER_SEC] [--markets N] [--capture PATH]
+//                       [--hot-standby 0|1] [--stall-every N] [--stall-us US]
+//                       [--fast-delta-scan 0|1]
+//
+// The server and the feed run on separate threads in one process so send and
+// receive timestamps share the same steady clock. --stall-every/--stall-us
+// make each server session pause periodically (staggered per session), which
+// shows how hot-standby arbitration hides a stalled connection.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+#include "mock_exchange_server.hpp"
+
+#include "kalshi/md/feed_handler.hpp"
+#include "kalshi/md/protocol/subscribe.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/** Sink that timestamps every event it receives. */
+class LatencySink
+{
+public:
+  explicit LatencySink(std::size_t expected)
+  {
+    recv_.reserve(expected);
+  }
+
+  void on_snapshot(const kalshi::md::OrderbookSnapshot&)
+  {
+    stamp();
+  }
+  void on_delta(const kalshi::md::OrderbookDelta&)
+  {
+    stamp();
+  }
+  void on_trade(const kalshi::md::TradeEvent&)
+  {
+    stamp();
+  }
+  void on_status(const kalshi::md::MarketStatusUpdate&)
+  {
+    stamp();
+  }
+
+  [[nodiscard]] const std::vector<std::chrono::steady_clock::time_point>& recv_times() const
+  {
+    return recv_;
+  }
+
+private:
+  void stamp()
+  {
+    recv_.push_back(std::chrono::steady_clock::now());
+  }
+
+  std::vector<std::chrono::steady_clock::time_point> recv_;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto total = kalshi::bench::arg_uint(argc, argv, "--messages", 200000);
+  auto rate = kalshi::bench::arg_uint(argc, argv, "--rate", 0);
+  auto capture = kalshi::bench::arg_value(argc, argv, "--capture", {});
+  auto hot_standby = kalshi::bench::arg_uint(argc, argv, "--hot-standby", 0) != 0;
+  auto stall_every = kalshi::bench::arg_uint(argc, argv, "--stall-every", 0);
+  auto stall_us = kalshi::bench::arg_uint(argc, argv, "--stall-us", 0);
+  auto fast_delta_scan = kalshi::bench::arg_uint(argc, argv, "--fast-delta-scan", 1) != 0;
+
+  kalshi::bench::GeneratorOptions generator_options;
+  generator_options.markets = kalshi::bench::arg_uint(argc, argv, "--markets", 100);
+  kalshi::bench::MarketDataGenerator generator(generator_options);
+
+  std::vector<std::string> messages;
+  if (capture.empty())
+  {
+    // Cycling repeats sequence numbers, which arbitration would drop as
+    // duplicates, so hot-standby runs generate the full stream.
+    auto count = hot_standby ? total : std::min<std::uint64_t>(total, 200000);
+    messages = generator.generate(count).to_strings();
+  }
+  else
+  {
+    auto loaded = kalshi::bench::load_capture(capture);
+    if (!loaded)
+    {
+      std::fprintf(stderr, "failed to load capture %s\n", capture.c_str());
+      return 1;
+    }
+    messages = std::move(*loaded);
+  }
+
+  boost::asio::io_context server_ioc;
+  auto server = kalshi::bench::MockExchangeServer::create(
+      server_ioc,
+      kalshi::bench::MockExchangeOptions{
+          .rate = rate,
+          .total_messages = total,
+          .stall_every = stall_every,
+          .stall = std::chrono::microseconds(static_cast<std::int64_t>(stall_us))},
+      std::move(messages));
+  if (!server)
+  {
+    std::fprintf(stderr, "mock exchange failed to start (%d)\n", static_cast<int>(server.error()));
+    return 1;
+  }
+  (*server)->start();
+  std::thread server_thread([&server_ioc] { server_ioc.run(); });
+
+  kalshi::bench::NullLogger logger;
+  LatencySink sink(total);
+  kalshi::md::FeedHandler<LatencySink> handler(sink, logger);
+
+  boost::asio::io_context ioc;
+  boost::asio::ssl::context ssl_ctx(boost::asio::ssl::context::tls_client);
+  ssl_ctx.set_verify_mode(boost::asio::ssl::verify_none);
+
+  std::size_t legs = hot_standby ? kalshi::md::HOT_STANDBY_LEGS : 1;
+  kalshi::md::SubscribeRequest subscription{
+      .id = 1, .channels = {"orderbook_delta", "trade"}, .market_tickers = generator.tickers()};
+
+  kalshi::md::FeedHandler<LatencySink>::RunOptions options{
+      .ws_url = (*server)->ws_url(),
+      .headers = {},
+      .refresh_headers = {},
+      .subscription = subscription,
+      .output_path = "/dev/null",
+      .include_raw_on_parse_error = false,
+      .log_raw_messages = false,
+      .auto_reconnect = false,
+      .reconnect_initial_delay = std::chrono::milliseconds(500),
+      .reconnect_max_delay = std::chrono::milliseconds(30000),
+      .handshake_timeout = std::chrono::milliseconds(30000),
+      .idle_timeout = std::chrono::milliseconds(60000),
+      .keep_alive_pings = true,
+      // One `subscribed` acknowledgement per channel per connection.
+      .max_messages = total + subscription.channels.size() * legs,
+      .tls_session_resumption = true,
+      .dns_cache_ttl = std::chrono::milliseconds(60000),
+      .hot_standby = hot_standby,
+      .fast_delta_scan = fast_delta_scan};
+
+  auto run = handler.run(ioc, ssl_ctx, std::move(options));
+
+  (*server)->stop();
+  server_ioc.stop();
+  server_thread.join();
+
+  if (!run)
+  {
+    std::fprintf(stderr, "feed handler failed to start\n");
+    return 1;
+  }
+
+  const auto& sent = (*server)->send_times();
+  const auto& recv = sink.recv_times();
+  auto n = std::min(sent.size(), recv.size());
+  if (n < 2)
+  {
+    std::fprintf(stderr, "no messages received\n");
+    return 1;
+  }
+
+  std::vector<std::int64_t> latencies;
+  latencies.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    latencies.push_back(kalshi::bench::elapsed_ns(sent[i], recv[i]));
+  }
+
+  auto window_ns = kalshi::bench::elapsed_ns(recv.front(), recv[n - 1]);
+  double msgs_per_sec =
+      window_ns > 0 ? static_cast<double>(n - 1) * 1e9 / static_cast<double>(window_ns) : 0.0;
+
+  std::printf("messages=%zu target_rate=%llu sustained=%.0f msgs/sec hot_standby=%d\n",
+              n,
+              static_cast<unsigned long long>(rate),
+              msgs_per_sec,
+              hot_standby ? 1 : 0);
+  kalshi::bench::print_latency("server_send->sink", kalshi::bench::summarize(latencies));
+  return 0;
+}
@@ -0,0 +1,419 @@
+#include "market_data_generator.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+
+#include "kalshi/md/parse/json_fields.hpp"
+#include "kalshi/md/protocol/message_types.hpp"
+
+namespace kalshi::bench
+{
+
+namespace
+{
+
+using kalshi::md::Price;
+using kalshi::md::PRICE_MAX;
+using kalshi::md::Size;
+
+/** 2026-01-01T00:00:00Z; trade `ts` values are seconds from here. */
+constexpr std::int64_t EPOCH_BASE_SECONDS = 1767225600;
+constexpr double IMPROVE_TOUCH_PROBABILITY = 0.05;
+constexpr double CANCEL_PROBABILITY = 0.45;
+constexpr Size MAX_LEVEL_SIZE = 5000;
+
+void append_uint(std::string& out, std::uint64_t value)
+{
+  char buf[24];
+  auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+  (void)ec;
+  out.append(buf, end);
+}
+
+void append_int(std::string& out, std::int64_t value)
+{
+  char buf[24];
+  auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+  (void)ec;
+  out.append(buf, end);
+}
+
+void append_key(std::string& out, const char* key)
+{
+  out += '"';
+  out += key;
+  out += "\":";
+}
+
+void append_string_field(std::string& out, const char* key, std::string_view value)
+{
+  append_key(out, key);
+  out += '"';
+  out += value;
+  out += '"';
+}
+
+void append_header(std::string& out, const char* type, std::uint32_t sid, std::uint64_t seq)
+{
+  out += '{';
+  append_string_field(out, kalshi::md::FIELD_TYPE, type);
+  out += ',';
+  append_key(out, kalshi::md::FIELD_SID);
+  append_uint(out, sid);
+  out += ',';
+  append_key(out, kalshi::md::FIELD_SEQ);
+  append_uint(out, seq);
+  out += ',';
+  append_key(out, kalshi::md::FIELD_MSG);
+  out += '{';
+}
+
+void append_levels(std::string& out,
+                   const char* key,
+                   const std::array<Size, PRICE_MAX + 1>& levels)
+{
+  append_key(out, key);
+  out += '[';
+  bool first = true;
+  for (std::size_t price = 1; price < levels.size(); ++price)
+  {
+    if (levels[price] == 0)
+    {
+      continue;
+    }
+    if (!first)
+    {
+      out += ',';
+    }
+    first = false;
+    out += '[';
+    append_uint(out, price);
+    out += ',';
+    append_uint(out, levels[price]);
+    out += ']';
+  }
+  out += ']';
+}
+
+Price next_touch(const std::array<Size, PRICE_MAX + 1>& levels, Price from)
+{
+  for (Price p = from; p > 0; --p)
+  {
+    if (levels[p] > 0)
+    {
+      return p;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+void MessageBuffer::reserve(std::size_t messages, std::size_t bytes)
+{
+  data_.reserve(bytes);
+  ends_.reserve(messages);
+  ts_ns_.reserve(messages);
+}
+
+void MessageBuffer::append(std::string_view json, std::int64_t ts_ns)
+{
+  data_.append(json);
+  ends_.push_back(data_.size());
+  ts_ns_.push_back(ts_ns);
+}
+
+std::vector<std::string> MessageBuffer::to_strings() const
+{
+  std::vector<std::string> out;
+  out.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i)
+  {
+    out.emplace_back((*this)[i]);
+  }
+  return out;
+}
+
+std::expected<void, GeneratorError> MessageBuffer::write_capture(std::string_view path) const
+{
+  std::ofstream out{std::string(path), std::ios::out | std::ios::binary};
+  if (!out.is_open())
+  {
+    return std::unexpected(GeneratorError::OutputOpenFailed);
+  }
+  for (std::size_t i = 0; i < size(); ++i)
+  {
+    auto msg = (*this)[i];
+    out.write(msg.data(), static_cast<std::streamsize>(msg.size()));
+    out.put('\n');
+  }
+  if (!out)
+  {
+    return std::unexpected(GeneratorError::WriteFailed);
+  }
+  return {};
+}
+
+MarketDataGenerator::MarketDataGenerator(GeneratorOptions options)
+  : options_(options), rng_(options.seed)
+{
+  options_.markets = std::max<std::size_t>(options_.markets, 1);
+  options_.level_decay = std::clamp(options_.level_decay, 0.0, 0.95);
+  options_.snapshot_depth = std::min<std::size_t>(options_.snapshot_depth, 40);
+
+  tickers_.reserve(options_.markets);
+  markets_.resize(options_.markets);
+  popularity_cdf_.reserve(options_.markets);
+
+  double total = 0.0;
+  for (std::size_t i = 0; i < options_.markets; ++i)
+  {
+    tickers_.push_back("KXSYN" + std::to_string(i) + "-26DEC31");
+    init_market(markets_[i]);
+    total += 1.0 / std::pow(static_cast<double>(i + 1), options_.market_skew);
+    popularity_cdf_.push_back(total);
+  }
+  for (auto& weight : popularity_cdf_)
+  {
+    weight /= total;
+  }
+  scratch_.reserve(1024);
+}
+
+MessageBuffer MarketDataGenerator::generate(std::size_t count)
+{
+  MessageBuffer out;
+  out.reserve(count, count * 128);
+  generate_into(out, count);
+  return out;
+}
+
+void MarketDataGenerator::generate_into(MessageBuffer& out, std::size_t count)
+{
+  std::size_t emitted = 0;
+  while (emitted < count && options_.initial_snapshots && snapshots_emitted_ < markets_.size())
+  {
+    emit_snapshot(out, snapshots_emitted_++);
+    ++emitted;
+  }
+
+  std::bernoulli_distribution is_trade(options_.trade_ratio);
+  while (emitted < count)
+  {
+    auto market = pick_market();
+    // A trade is followed by the delta that removes the consumed liquidity.
+    if (count - emitted >= 2 && is_trade(rng_))
+    {
+      emit_trade(out, market);
+      emitted += 2;
+      continue;
+    }
+    emit_delta(out, market);
+    ++emitted;
+  }
+}
+
+void MarketDataGenerator::init_market(MarketState& market)
+{
+  std::uniform_int_distribution<int> mid_dist(15, 85);
+  std::uniform_int_distribution<Size> size_dist(10, 500);
+
+  auto mid = mid_dist(rng_);
+  market.yes_touch = static_cast<Price>(mid - 1);
+  market.no_touch = static_cast<Price>(PRICE_MAX - mid - 1);
+
+  for (std::size_t i = 0; i < options_.snapshot_depth; ++i)
+  {
+    if (market.yes_touch > i)
+    {
+      market.yes[market.yes_touch - i] = size_dist(rng_);
+    }
+    if (market.no_touch > i)
+    {
+      market.no[market.no_touch - i] = size_dist(rng_);
+    }
+  }
+}
+
+void MarketDataGenerator::emit_snapshot(MessageBuffer& out, std::size_t market)
+{
+  const auto& state = markets_[market];
+  scratch_.clear();
+  append_header(scratch_, kalshi::md::ORDERBOOK_SNAPSHOT, options_.orderbook_sid, ++orderbook_seq_);
+  append_string_field(scratch_, kalshi::md::FIELD_MARKET_TICKER, tickers_[market]);
+  scratch_ += ',';
+  append_levels(scratch_, kalshi::md::FIELD_YES, state.yes);
+  scratch_ += ',';
+  append_levels(scratch_, kalshi::md::FIELD_NO, state.no);
+  scratch_ += "}}";
+  out.append(scratch_, next_timestamp());
+}
+
+void MarketDataGenerator::emit_delta(MessageBuffer& out, std::size_t market)
+{
+  auto& state = markets_[market];
+  bool yes_side = std::bernoulli_distribution(0.5)(rng_);
+  auto& levels = yes_side ? state.yes : state.no;
+  auto& touch = yes_side ? state.yes_touch : state.no_touch;
+  auto opposite = yes_side ? state.no_touch : state.yes_touch;
+
+  // Highest price this side may quote without crossing the other side.
+  auto ceiling = static_cast<int>(PRICE_MAX) - static_cast<int>(opposite) - 1;
+  int anchor = touch == 0 ? ceiling : touch;
+
+  int price = anchor;
+  if (touch != 0 && touch < ceiling && std::bernoulli_distribution(IMPROVE_TOUCH_PROBABILITY)(rng_))
+  {
+    price = touch + 1;
+  }
+  else
+  {
+    std::geometric_distribution<int> distance(1.0 - options_.level_decay);
+    price = anchor - distance(rng_);
+  }
+  price = std::clamp(price, 1, std::max(ceiling, 1));
+
+  auto& size = levels[static_cast<std::size_t>(price)];
+  std::int64_t delta = 0;
+  if (size > 0 && std::bernoulli_distribution(CANCEL_PROBABILITY)(rng_))
+  {
+    std::uniform_int_distribution<Size> cancel(1, size);
+    delta = -static_cast<std::int64_t>(cancel(rng_));
+  }
+  else
+  {
+    std::uniform_int_distribution<Size> add(1, 200);
+    delta = std::min<std::int64_t>(add(rng_), static_cast<std::int64_t>(MAX_LEVEL_SIZE - size));
+    if (delta == 0)
+    {
+      delta = -1;
+    }
+  }
+  size = static_cast<Size>(static_cast<std::int64_t>(size) + delta);
+
+  if (size > 0 && price > touch)
+  {
+    touch = static_cast<Price>(price);
+  }
+  else if (size == 0 && price == touch)
+  {
+    touch = next_touch(levels, touch);
+  }
+
+  scratch_.clear();
+  append_header(scratch_, kalshi::md::ORDERBOOK_DELTA, options_.orderbook_sid, ++orderbook_seq_);
+  append_string_field(scratch_, kalshi::md::FIELD_MARKET_TICKER, tickers_[market]);
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_PRICE);
+  append_uint(scratch_, static_cast<std::uint64_t>(price));
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_DELTA);
+  append_int(scratch_, delta);
+  scratch_ += ',';
+  append_string_field(scratch_,
+                      kalshi::md::FIELD_SIDE,
+                      yes_side ? kalshi::md::VALUE_SIDE_YES : kalshi::md::VALUE_SIDE_NO);
+  scratch_ += "}}";
+  out.append(scratch_, next_timestamp());
+}
+
+void MarketDataGenerator::emit_trade(MessageBuffer& out, std::size_t market)
+{
+  auto& state = markets_[market];
+  // A yes taker lifts resting no bids and vice versa.
+  bool yes_taker = std::bernoulli_distribution(0.5)(rng_);
+  auto& levels = yes_taker ? state.no : state.yes;
+  auto& touch = yes_taker ? state.no_touch : state.yes_touch;
+  if (touch == 0)
+  {
+    emit_delta(out, market);
+    emit_delta(out, market);
+    return;
+  }
+
+  auto resting_price = touch;
+  auto& resting = levels[resting_price];
+  std::uniform_int_distribution<Size> fill(1, std::max<Size>(1, std::min<Size>(resting, 100)));
+  Size count = fill(rng_);
+  resting -= count;
+  if (resting == 0)
+  {
+    touch = next_touch(levels, touch);
+  }
+
+  auto ts = next_timestamp();
+  Price yes_price = yes_taker ? static_cast<Price>(PRICE_MAX - resting_price) : resting_price;
+
+  scratch_.clear();
+  append_header(scratch_, kalshi::md::TRADE, options_.trade_sid, ++trade_seq_);
+  append_string_field(scratch_, kalshi::md::FIELD_MARKET_TICKER, tickers_[market]);
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_YES_PRICE);
+  append_uint(scratch_, yes_price);
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_NO_PRICE);
+  append_uint(scratch_, static_cast<std::uint64_t>(PRICE_MAX - yes_price));
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_COUNT);
+  append_uint(scratch_, count);
+  scratch_ += ',';
+  append_string_field(scratch_,
+                      kalshi::md::FIELD_TAKER_SIDE,
+                      yes_taker ? kalshi::md::VALUE_SIDE_YES : kalshi::md::VALUE_SIDE_NO);
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_TIMESTAMP);
+  append_int(scratch_, EPOCH_BASE_SECONDS + ts / 1'000'000'000);
+  scratch_ += "}}";
+  out.append(scratch_, ts);
+
+  scratch_.clear();
+  append_header(scratch_, kalshi::md::ORDERBOOK_DELTA, options_.orderbook_sid, ++orderbook_seq_);
+  append_string_field(scratch_, kalshi::md::FIELD_MARKET_TICKER, tickers_[market]);
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_PRICE);
+  append_uint(scratch_, resting_price);
+  scratch_ += ',';
+  append_key(scratch_, kalshi::md::FIELD_DELTA);
+  append_int(scratch_, -static_cast<std::int64_t>(count));
+  scratch_ += ',';
+  append_string_field(scratch_,
+                      kalshi::md::FIELD_SIDE,
+                      yes_taker ? kalshi::md::VALUE_SIDE_NO : kalshi::md::VALUE_SIDE_YES);
+  scratch_ += "}}";
+  out.append(scratch_, ts);
+}
+
+std::size_t MarketDataGenerator::pick_market()
+{
+  double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+  auto it = std::lower_bound(popularity_cdf_.begin(), popularity_cdf_.end(), u);
+  if (it == popularity_cdf_.end())
+  {
+    return popularity_cdf_.size() - 1;
+  }
+  return static_cast<std::size_t>(it - popularity_cdf_.begin());
+}
+
+std::int64_t MarketDataGenerator::next_timestamp()
+{
+  double rate = options_.base_rate * options_.load_multiplier;
+  if (burst_remaining_ > 0.0)
+  {
+    burst_remaining_ -= 1.0;
+    rate *= options_.burst_rate_multiplier;
+  }
+  else if (std::bernoulli_distribution(options_.burst_probability)(rng_))
+  {
+    burst_remaining_ = std::exponential_distribution<double>(1.0 / options_.burst_length)(rng_);
+  }
+
+  if (rate > 0.0)
+  {
+    clock_ns_ += std::exponential_distribution<double>(rate)(rng_) * 1e9;
+  }
+  return static_cast<std::int64_t>(clock_ns_);
+}
+
+} // namespace kalshi::bench
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "kalshi/md/model/types.hpp"
+
+namespace kalshi::bench
+{
+
+/** Errors returned while writing generated data. */
+enum class GeneratorError
+{
+  OutputOpenFailed,
+  WriteFailed
+};
+
+/** Knobs for the synthetic market data stream. */
+struct GeneratorOptions
+{
+  /** Number of distinct markets in the stream. */
+  std::size_t markets = 100;
+  /** Baseline aggregate rate in messages/sec (drives timestamps only). */
+  double base_rate = 2000.0;
+  /** Multiplier on base_rate, e.g. 10 or 100 for stress runs. */
+  double load_multiplier = 1.0;
+  /** Probability per message of entering a burst. */
+  double burst_probability = 0.001;
+  /** Mean burst length in messages. */
+  double burst_length = 200.0;
+  /** Rate multiplier while inside a burst. */
+  double burst_rate_multiplier = 20.0;
+  /** Zipf exponent for market popularity (0 = uniform). */
+  double market_skew = 1.1;
+  /** Fraction of non-snapshot messages that are trades. */
+  double trade_ratio = 0.03;
+  /** Geometric decay of delta activity away from the touch (0..1). */
+  double level_decay = 0.35;
+  /** Populated levels per side in the initial snapshots. */
+  std::size_t snapshot_depth = 20;
+  /** Emit one snapshot per market before the first delta. */
+  bool initial_snapshots = true;
+  /** Subscription id used for orderbook messages. */
+  std::uint32_t orderbook_sid = 1;
+  /** Subscription id used for trade messages. */
+  std::uint32_t trade_sid = 2;
+  /** RNG seed; equal seeds give byte-identical streams. */
+  std::uint64_t seed = 42;
+};
+
+/**
+ * Contiguous in-memory message buffer. Messages are stored back to back in
+ * one allocation so replaying them touches memory the way a socket buffer
+ * would.
+ */
+class MessageBuffer
+{
+public:
+  /**
+   * Reserve space up front.
+   * @param messages Expected message count.
+   * @param bytes Expected total payload bytes.
+   * @return void.
+   */
+  void reserve(std::size_t messages, std::size_t bytes);
+
+  /**
+   * Append a message.
+   * @param json Message payload.
+   * @param ts_ns Generation timestamp in nanoseconds from stream start.
+   * @return void.
+   */
+  void append(std::string_view json, std::int64_t ts_ns);
+
+  /** Number of messages. */
+  [[nodiscard]] std::size_t size() const
+  {
+    return ends_.size();
+  }
+
+  /** Total payload bytes. */
+  [[nodiscard]] std::size_t bytes() const
+  {
+    return data_.size();
+  }
+
+  /**
+   * View message i.
+   * @param i Message index.
+   * @return Payload view valid for the lifetime of the buffer.
+   */
+  [[nodiscard]] std::string_view operator[](std::size_t i) const
+  {
+    std::size_t begin = i == 0 ? 0 : ends_[i - 1];
+    return std::string_view(data_).substr(begin, ends_[i] - begin);
+  }
+
+  /**
+   * Generation timestamp of message i.
+   * @param i Message index.
+   * @return Nanoseconds from stream start.
+   */
+  [[nodiscard]] std::int64_t timestamp_ns(std::size_t i) const
+  {
+    return ts_ns_[i];
+  }
+
+  /**
+   * Copy messages out as individual strings (e.g. for the mock exchange).
+   * @return One string per message.
+   */
+  [[nodiscard]] std::vector<std::string> to_strings() const;
+
+  /**
+   * Write a newline-delimited capture, the format FeedHandler records.
+   * @param path Output path.
+   * @return void or GeneratorError.
+   */
+  [[nodiscard]] std::expected<void, GeneratorError> write_capture(std::string_view path) const;
+
+private:
+  std::string data_;
+  std::vector<std::size_t> ends_;
+  std::vector<std::int64_t> ts_ns_;
+};
+
+/**
+ * Deterministic generator of Kalshi orderbook_snapshot, orderbook_delta and
+ * trade messages.
+ *
+ * Each market keeps a dense book so deltas never drive a level negative and
+ * trades print at the touch. Market activity follows a Zipf distribution,
+ * delta prices decay geometrically away from the touch, and arrival times
+ * follow a Poisson process modulated by bursts. Sequence numbers are
+ * maintained per subscription id.
+ */
+class MarketDataGenerator
+{
+public:
+  /**
+   * Construct a generator.
+   * @param options Generator options.
+   */
+  explicit MarketDataGenerator(GeneratorOptions options);
+
+  /**
+   * Generate count messages into a new buffer. Initial snapshots, when
+   * enabled and not yet emitted, count toward the total.
+   * @param count Number of messages.
+   * @return Message buffer.
+   */
+  [[nodiscard]] MessageBuffer generate(std::size_t count);
+
+  /**
+   * Append count messages to an existing buffer.
+   * @param out Destination buffer.
+   * @param count Number of messages.
+   * @return void.
+   */
+  void generate_into(MessageBuffer& out, std::size_t count);
+
+  /**
+   * Market tickers in index order.
+   * @return Ticker list.
+   */
+  [[nodiscard]] const std::vector<std::string>& tickers() const
+  {
+    return tickers_;
+  }
+
+private:
+  struct MarketState
+  {
+    std::array<kalshi::md::Size, kalshi::md::PRICE_MAX + 1> yes{};
+    std::array<kalshi::md::Size, kalshi::md::PRICE_MAX + 1> no{};
+    kalshi::md::Price yes_touch = 0;
+    kalshi::md::Price no_touch = 0;
+  };
+
+  void init_market(MarketState& market);
+  void emit_snapshot(MessageBuffer& out, std::size_t market);
+  void emit_delta(MessageBuffer& out, std::size_t market);
+  void emit_trade(MessageBuffer& out, std::size_t market);
+  std::size_t pick_market();
+  std::int64_t next_timestamp();
+
+  GeneratorOptions options_;
+  std::mt19937_64 rng_;
+  std::vector<std::string> tickers_;
+  std::vector<MarketState> markets_;
+  std::vector<double> popularity_cdf_;
+  std::string scratch_;
+  std::uint64_t orderbook_seq_ = 0;
+  std::uint64_t trade_seq_ = 0;
+  std::size_t snapshots_emitted_ = 0;
+  double clock_ns_ = 0.0;
+  double burst_remaining_ = 0.0;
+};
+
+} // namespace kalshi::bench
@@ -0,0 +1,225 @@
+// Replay throughput of the matching simulator.
+//
+// Usage: matching_sim_bench [--messages N] [--markets N] [--iterations N] [--capture PATH]
+//
+// Generated messages, or a newline-delimited capture, are decoded once into
+// events and replayed from memory:
+// - book_only: events into MatchingEngine alone; no orders, so this is the
+//   cost of keeping the books
+// - market_maker: events into MatchingEngine and a StrategyPipeline whose
+//   MarketMaker quotes through RiskGate and GatewaySink back into the engine,
+//   so deltas and trades move the queue positions of live quotes
+// - from_json: the market_maker chain fed raw messages through Dispatcher,
+//   decoding included
+// Each row prints delta and event throughput over the best iteration, plus
+// the simulated fills of the last one.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+#include "mock_exchange_server.hpp"
+
+#include "kalshi/md/dispatcher.hpp"
+#include "kalshi/md/model/market_sink.hpp"
+#include "kalshi/sim/matching_engine.hpp"
+#include "kalshi/strategy/market_maker.hpp"
+#include "kalshi/strategy/pipeline.hpp"
+#include "kalshi/trade/risk_engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace
+{
+
+using Event = std::variant<kalshi::md::OrderbookSnapshot,
+                           kalshi::md::OrderbookDelta,
+                           kalshi::md::TradeEvent,
+                           kalshi::md::MarketStatusUpdate>;
+
+/** Keeps every decoded event for replay. */
+struct RecordingSink
+{
+  std::vector<Event> events;
+  std::uint64_t deltas = 0;
+
+  void on_snapshot(const kalshi::md::OrderbookSnapshot& s) { events.emplace_back(s); }
+  void on_delta(const kalshi::md::OrderbookDelta& d)
+  {
+    events.emplace_back(d);
+    ++deltas;
+  }
+  void on_trade(const kalshi::md::TradeEvent& t) { events.emplace_back(t); }
+  void on_status(const kalshi::md::MarketStatusUpdate& u) { events.emplace_back(u); }
+};
+
+template <kalshi::md::MarketSink Sink>
+void replay(const std::vector<Event>& events, Sink& sink)
+{
+  for (const auto& event : events)
+  {
+    std::visit(
+        [&](const auto& e)
+        {
+          using E = std::decay_t<decltype(e)>;
+          if constexpr (std::is_same_v<E, kalshi::md::OrderbookSnapshot>)
+          {
+            sink.on_snapshot(e);
+          }
+          else if constexpr (std::is_same_v<E, kalshi::md::OrderbookDelta>)
+          {
+            sink.on_delta(e);
+          }
+          else if constexpr (std::is_same_v<E, kalshi::md::TradeEvent>)
+          {
+            sink.on_trade(e);
+          }
+          else
+          {
+            sink.on_status(e);
+          }
+        },
+        event);
+  }
+}
+
+using Gateway = kalshi::strategy::GatewaySink<kalshi::sim::MatchingEngine>;
+using Gate = kalshi::strategy::RiskGate<Gateway>;
+using Pipeline = kalshi::strategy::StrategyPipeline<kalshi::strategy::MarketMaker, Gate>;
+using Chain = kalshi::sim::BacktestSink<Pipeline>;
+
+/** Simulator with the sample market maker quoting into it. */
+struct Backtest
+{
+  explicit Backtest(std::uint32_t markets)
+      : engine(kalshi::sim::MatchingOptions{
+            .market_capacity = markets, .order_capacity = 8 * markets, .client_id_prefix = "bt-"}),
+        risk(markets, limits(markets)),
+        gateway(engine),
+        gate(risk, gateway),
+        maker(markets, kalshi::strategy::MarketMakerParams{}),
+        pipeline(markets, maker, gate),
+        chain(engine, pipeline)
+  {
+    engine.set_risk_engine(&risk);
+  }
+
+  static kalshi::trade::RiskLimits limits(std::uint32_t markets)
+  {
+    kalshi::trade::RiskLimits limits;
+    limits.max_position = 1'000'000;
+    limits.max_total_open_orders = 4 * markets;
+    limits.max_total_notional = 1'000'000'000;
+    return limits;
+  }
+
+  kalshi::sim::MatchingEngine engine;
+  kalshi::trade::RiskEngine risk;
+  Gateway gateway;
+  Gate gate;
+  kalshi::strategy::MarketMaker maker;
+  Pipeline pipeline;
+  Chain chain;
+};
+
+void print_row(const char* label, std::uint64_t deltas, std::uint64_t events, std::int64_t ns,
+               const kalshi::sim::MatchingStats& stats)
+{
+  std::printf("%-13s %7.2f M deltas/s %7.2f M events/s  placed=%llu canceled=%llu maker_fills=%llu "
+              "taker_fills=%llu contracts=%llu\n",
+              label,
+              static_cast<double>(deltas) * 1e3 / static_cast<double>(ns),
+              static_cast<double>(events) * 1e3 / static_cast<double>(ns),
+              static_cast<unsigned long long>(stats.placed),
+              static_cast<unsigned long long>(stats.canceled),
+              static_cast<unsigned long long>(stats.maker_fills),
+              static_cast<unsigned long long>(stats.taker_fills),
+              static_cast<unsigned long long>(stats.filled_contracts));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto count = kalshi::bench::arg_uint(argc, argv, "--messages", 2000000);
+  auto markets = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--markets", 200));
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 3);
+  auto capture = kalshi::bench::arg_value(argc, argv, "--capture", {});
+
+  std::vector<std::string> messages;
+  if (capture.empty())
+  {
+    kalshi::bench::GeneratorOptions generator_options;
+    generator_options.markets = markets;
+    kalshi::bench::MarketDataGenerator generator(generator_options);
+    messages = generator.generate(count).to_strings();
+  }
+  else
+  {
+    auto loaded = kalshi::bench::load_capture(capture);
+    if (!loaded)
+    {
+      std::fprintf(stderr, "failed to load capture %s\n", capture.c_str());
+      return 1;
+    }
+    messages = std::move(*loaded);
+  }
+
+  RecordingSink recording;
+  {
+    kalshi::md::Dispatcher<RecordingSink> dispatcher(recording);
+    for (const auto& message : messages)
+    {
+      (void)dispatcher.on_message(message);
+    }
+  }
+  std::printf("messages=%zu events=%zu deltas=%llu markets=%u\n",
+              messages.size(),
+              recording.events.size(),
+              static_cast<unsigned long long>(recording.deltas),
+              markets);
+
+  std::int64_t best = INT64_MAX;
+  kalshi::sim::MatchingStats stats{};
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    kalshi::sim::MatchingEngine engine(kalshi::sim::MatchingOptions{
+        .market_capacity = markets, .order_capacity = markets, .client_id_prefix = "bt-"});
+    auto start = std::chrono::steady_clock::now();
+    replay(recording.events, engine);
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+    stats = engine.stats();
+  }
+  print_row("book_only", recording.deltas, recording.events.size(), best, stats);
+
+  best = INT64_MAX;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    Backtest backtest(markets);
+    auto start = std::chrono::steady_clock::now();
+    replay(recording.events, backtest.chain);
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+    stats = backtest.engine.stats();
+  }
+  print_row("market_maker", recording.deltas, recording.events.size(), best, stats);
+
+  best = INT64_MAX;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    Backtest backtest(markets);
+    kalshi::md::Dispatcher<Chain> dispatcher(backtest.chain);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& message : messages)
+    {
+      (void)dispatcher.on_message(message);
+    }
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+    stats = backtest.engine.stats();
+  }
+  print_row("from_json", recording.deltas, recording.events.size(), best, stats);
+  return 0;
+}
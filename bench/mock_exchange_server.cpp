@@ -0,0 +1,430 @@
+#include "mock_exchange_server.hpp"
+
+#include "tls_test_cert.hpp"
+
+#include <fstream>
+#include <utility>
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+
+namespace kalshi::bench
+{
+
+namespace
+{
+
+constexpr std::string_view SUBSCRIBE_MARKER = "\"cmd\":\"subscribe\"";
+constexpr std::string_view ID_MARKER = "\"id\":";
+constexpr std::string_view CHANNELS_MARKER = "\"channels\":[\"";
+constexpr std::string_view DEFAULT_CHANNEL = "orderbook_delta";
+
+std::string_view extract_id(std::string_view cmd)
+{
+  auto pos = cmd.find(ID_MARKER);
+  if (pos == std::string_view::npos)
+  {
+    return "0";
+  }
+  pos += ID_MARKER.size();
+  auto end = cmd.find_first_not_of("0123456789", pos);
+  auto id = cmd.substr(pos, end == std::string_view::npos ? cmd.size() - pos : end - pos);
+  return id.empty() ? "0" : id;
+}
+
+std::vector<std::string_view> extract_channels(std::string_view cmd)
+{
+  std::vector<std::string_view> channels;
+  auto pos = cmd.find(CHANNELS_MARKER);
+  if (pos == std::string_view::npos)
+  {
+    channels.push_back(DEFAULT_CHANNEL);
+    return channels;
+  }
+  pos += CHANNELS_MARKER.size() - 1;
+  auto end = cmd.find(']', pos);
+  auto list = cmd.substr(pos, end == std::string_view::npos ? cmd.size() - pos : end - pos);
+  while (true)
+  {
+    auto open = list.find('"');
+    if (open == std::string_view::npos)
+    {
+      break;
+    }
+    auto close = list.find('"', open + 1);
+    if (close == std::string_view::npos)
+    {
+      break;
+    }
+    channels.push_back(list.substr(open + 1, close - open - 1));
+    list.remove_prefix(close + 1);
+  }
+  if (channels.empty())
+  {
+    channels.push_back(DEFAULT_CHANNEL);
+  }
+  return channels;
+}
+
+// One `subscribed` reply per channel with sids 1..N, as the exchange does
+// for a fresh connection.
+std::vector<std::string> build_subscribed_replies(std::string_view cmd)
+{
+  std::vector<std::string> replies;
+  auto channels = extract_channels(cmd);
+  for (std::size_t i = 0; i < channels.size(); ++i)
+  {
+    std::string reply = "{\"id\":";
+    reply.append(extract_id(cmd));
+    reply.append(",\"type\":\"subscribed\",\"msg\":{\"channel\":\"");
+    reply.append(channels[i]);
+    reply.append("\",\"sid\":");
+    reply.append(std::to_string(i + 1));
+    reply.append("}}");
+    replies.push_back(std::move(reply));
+  }
+  return replies;
+}
+
+} // namespace
+
+class MockExchangeServer::Session : public std::enable_shared_from_this<Session>
+{
+public:
+  Session(boost::asio::ip::tcp::socket socket, MockExchangeServer& server, std::size_t id)
+    : ws_(std::move(socket), server.ssl_ctx_),
+      timer_(ws_.get_executor()),
+      server_(server),
+      id_(id)
+  {
+    // Without this, Nagle batches the small paced writes and the bench
+    // measures the server's coalescing delay instead of the feed.
+    boost::system::error_code ec;
+    boost::beast::get_lowest_layer(ws_).socket().set_option(boost::asio::ip::tcp::no_delay(true),
+                                                            ec);
+  }
+
+  void run()
+  {
+    ws_.next_layer().async_handshake(
+        boost::asio::ssl::stream_base::server,
+        boost::beast::bind_front_handler(&Session::on_ssl_handshake, shared_from_this()));
+  }
+
+private:
+  void on_ssl_handshake(boost::system::error_code ec)
+  {
+    if (ec)
+    {
+      return;
+    }
+    ws_.set_option(boost::beast::websocket::stream_base::timeout::suggested(
+        boost::beast::role_type::server));
+    ws_.async_accept(boost::beast::bind_front_handler(&Session::on_accept, shared_from_this()));
+  }
+
+  void on_accept(boost::system::error_code ec)
+  {
+    if (ec)
+    {
+      return;
+    }
+    ws_.async_read(buffer_,
+                   boost::beast::bind_front_handler(&Session::on_command, shared_from_this()));
+  }
+
+  void on_command(boost::system::error_code ec, std::size_t)
+  {
+    if (ec)
+    {
+      return;
+    }
+    auto cmd = boost::beast::buffers_to_string(buffer_.data());
+    buffer_.consume(buffer_.size());
+    if (cmd.find(SUBSCRIBE_MARKER) == std::string::npos)
+    {
+      on_accept({});
+      return;
+    }
+
+    replies_ = build_subscribed_replies(cmd);
+    ws_.text(true);
+    write_reply();
+  }
+
+  void write_reply()
+  {
+    ws_.async_write(boost::asio::buffer(replies_[reply_index_]),
+                    boost::beast::bind_front_handler(&Session::on_reply, shared_from_this()));
+  }
+
+  void on_reply(boost::system::error_code ec, std::size_t)
+  {
+    if (ec)
+    {
+      return;
+    }
+    if (++reply_index_ < replies_.size())
+    {
+      write_reply();
+      return;
+    }
+    const auto& messages = server_.messages_;
+    total_ = server_.options_.total_messages == 0 ? messages.size()
+                                                  : server_.options_.total_messages;
+    if (server_.send_times_.size() < total_)
+    {
+      server_.send_times_.resize(total_);
+    }
+    start_ = std::chrono::steady_clock::now();
+    do_drain();
+    send_next();
+  }
+
+  void do_drain()
+  {
+    ws_.async_read(buffer_,
+                   boost::beast::bind_front_handler(&Session::on_drain, shared_from_this()));
+  }
+
+  void on_drain(boost::system::error_code ec, std::size_t)
+  {
+    if (ec)
+    {
+      closed_ = true;
+      timer_.cancel();
+      return;
+    }
+    buffer_.consume(buffer_.size());
+    do_drain();
+  }
+
+  void send_next()
+  {
+    if (closed_)
+    {
+      return;
+    }
+    if (index_ >= total_)
+    {
+      if (server_.options_.close_after_stream)
+      {
+        ws_.async_close(boost::beast::websocket::close_code::normal,
+                        [self = shared_from_this()](boost::system::error_code) {});
+      }
+      return;
+    }
+
+    if (should_stall())
+    {
+      timer_.expires_after(server_.options_.stall);
+      timer_.async_wait(
+          [self = shared_from_this()](const boost::system::error_code& timer_ec)
+          {
+            if (!timer_ec)
+            {
+              self->write_current();
+            }
+          });
+      return;
+    }
+
+    auto rate = server_.options_.rate;
+    if (rate > 0)
+    {
+      auto deadline =
+          start_ + std::chrono::nanoseconds(static_cast<std::int64_t>(index_ * 1'000'000'000ULL /
+                                                                      rate));
+      if (std::chrono::steady_clock::now() < deadline)
+      {
+        timer_.expires_at(deadline);
+        timer_.async_wait(
+            [self = shared_from_this()](const boost::system::error_code& timer_ec)
+            {
+              if (!timer_ec)
+              {
+                self->write_current();
+              }
+            });
+        return;
+      }
+    }
+    write_current();
+  }
+
+  [[nodiscard]] bool should_stall() const
+  {
+    auto every = server_.options_.stall_every;
+    if (every == 0 || server_.options_.stall.count() <= 0 || index_ == 0)
+    {
+      return false;
+    }
+    // Offset by half a period per session so legs stall at different points.
+    return (index_ + id_ * (every / 2)) % every == 0;
+  }
+
+  void write_current()
+  {
+    const auto& messages = server_.messages_;
+    const auto& payload = messages[index_ % messages.size()];
+    auto& sent = server_.send_times_[index_];
+    if (sent == std::chrono::steady_clock::time_point{})
+    {
+      sent = std::chrono::steady_clock::now();
+    }
+    ws_.async_write(boost::asio::buffer(payload),
+                    boost::beast::bind_front_handler(&Session::on_stream_write, shared_from_this()));
+  }
+
+  void on_stream_write(boost::system::error_code ec, std::size_t)
+  {
+    if (ec)
+    {
+      return;
+    }
+    ++index_;
+    send_next();
+  }
+
+  boost::beast::websocket::stream<boost::beast::ssl_stream<boost::beast::tcp_stream>> ws_;
+  boost::asio::steady_timer timer_;
+  boost::beast::flat_buffer buffer_;
+  MockExchangeServer& server_;
+  std::vector<std::string> replies_;
+  std::size_t reply_index_ = 0;
+  std::chrono::steady_clock::time_point start_;
+  std::size_t id_ = 0;
+  std::size_t index_ = 0;
+  std::size_t total_ = 0;
+  bool closed_ = false;
+};
+
+MockExchangeServer::MockExchangeServer(boost::asio::io_context& ioc,
+                                       MockExchangeOptions options,
+                                       std::vector<std::string> messages)
+  : ssl_ctx_(boost::asio::ssl::context::tls_server),
+    acceptor_(ioc),
+    options_(std::move(options)),
+    messages_(std::move(messages))
+{
+}
+
+MockExchangeServer::~MockExchangeServer() = default;
+
+std::expected<std::unique_ptr<MockExchangeServer>, MockServerError> MockExchangeServer::create(
+    boost::asio::io_context& ioc, MockExchangeOptions options, std::vector<std::string> messages)
+{
+  if (messages.empty())
+  {
+    return std::unexpected(MockServerError::CaptureEmpty);
+  }
+
+  std::unique_ptr<MockExchangeServer> server(
+      new MockExchangeServer(ioc, std::move(options), std::move(messages)));
+
+  if (!use_self_signed_cert(server->ssl_ctx_, "localhost"))
+  {
+    return std::unexpected(MockServerError::CertificateFailed);
+  }
+
+  boost::system::error_code ec;
+  auto address = boost::asio::ip::make_address(server->options_.address, ec);
+  if (ec)
+  {
+    return std::unexpected(MockServerError::ListenFailed);
+  }
+  boost::asio::ip::tcp::endpoint endpoint(address, server->options_.port);
+  server->acceptor_.open(endpoint.protocol(), ec);
+  if (!ec)
+  {
+    server->acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec);
+  }
+  if (!ec)
+  {
+    server->acceptor_.bind(endpoint, ec);
+  }
+  if (!ec)
+  {
+    server->acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+  }
+  if (ec)
+  {
+    return std::unexpected(MockServerError::ListenFailed);
+  }
+  return server;
+}
+
+void MockExchangeServer::start()
+{
+  do_accept();
+}
+
+void MockExchangeServer::stop()
+{
+  boost::system::error_code ec;
+  acceptor_.close(ec);
+}
+
+std::uint16_t MockExchangeServer::port() const
+{
+  boost::system::error_code ec;
+  return acceptor_.local_endpoint(ec).port();
+}
+
+std::string MockExchangeServer::ws_url() const
+{
+  return "wss://" + options_.address + ":" + std::to_string(port()) + options_.target;
+}
+
+const std::vector<std::chrono::steady_clock::time_point>& MockExchangeServer::send_times() const
+{
+  return send_times_;
+}
+
+std::size_t MockExchangeServer::sessions() const
+{
+  return sessions_;
+}
+
+void MockExchangeServer::do_accept()
+{
+  acceptor_.async_accept(
+      [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket)
+      {
+        if (ec)
+        {
+          return;
+        }
+        std::make_shared<Session>(std::move(socket), *this, sessions_++)->run();
+        do_accept();
+      });
+}
+
+std::expected<std::vector<std::string>, MockServerError> load_capture(std::string_view path)
+{
+  std::ifstream in{std::string(path)};
+  if (!in.is_open())
+  {
+    return std::unexpected(MockServerError::CaptureOpenFailed);
+  }
+
+  std::vector<std::string> messages;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (!line.empty())
+    {
+      messages.push_back(std::move(line));
+    }
+  }
+  if (messages.empty())
+  {
+    return std::unexpected(MockServerError::CaptureEmpty);
+  }
+  return messages;
+}
+
+} // namespace kalshi::bench
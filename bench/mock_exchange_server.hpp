@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+namespace kalshi::bench
+{
+
+/** Errors returned while starting the mock exchange. */
+enum class MockServerError
+{
+  CertificateFailed,
+  ListenFailed,
+  CaptureOpenFailed,
+  CaptureEmpty
+};
+
+/** Options for the loopback mock exchange. */
+struct MockExchangeOptions
+{
+  std::string address = "127.0.0.1";
+  std::uint16_t port = 0; // 0 = ephemeral
+  std::string target = "/trade-api/ws/v2";
+  std::uint64_t rate = 0;          // messages/sec, 0 = as fast as writes complete
+  std::size_t total_messages = 0;  // 0 = one pass over the message list
+  bool close_after_stream = false; // close each session once it has streamed everything
+  std::size_t stall_every = 0;     // pause each session once per this many messages, 0 = never
+  std::chrono::microseconds stall{0};
+};
+
+/**
+ * Loopback TLS websocket server that mimics the Kalshi market data endpoint.
+ *
+ * Each session waits for a subscribe command, acknowledges it with one
+ * `subscribed` message per channel (sids 1..N) and then streams the configured messages (cycled
+ * if total_messages exceeds the list) at the configured rate. Send times
+ * are recorded per streamed message so a benchmark can pair them with
+ * receive times after the run; with several sessions the earliest send of
+ * each message is kept. Stalls are staggered across sessions so concurrent
+ * sessions never pause at the same point in the stream.
+ */
+class MockExchangeServer
+{
+public:
+  /**
+   * Create a server bound to options.address:options.port.
+   * @param ioc IO context that drives the server.
+   * @param options Server options.
+   * @param messages Payloads to stream after subscribe.
+   * @return MockExchangeServer or MockServerError.
+   */
+  [[nodiscard]] static std::expected<std::unique_ptr<MockExchangeServer>, MockServerError> create(
+      boost::asio::io_context& ioc, MockExchangeOptions options, std::vector<std::string> messages);
+
+  ~MockExchangeServer();
+
+  MockExchangeServer(const MockExchangeServer&) = delete;
+  MockExchangeServer& operator=(const MockExchangeServer&) = delete;
+
+  /**
+   * Start accepting sessions.
+   * @return void.
+   */
+  void start();
+
+  /**
+   * Stop accepting new sessions.
+   * @return void.
+   */
+  void stop();
+
+  /**
+   * Bound TCP port.
+   * @return Port number.
+   */
+  [[nodiscard]] std::uint16_t port() const;
+
+  /**
+   * Websocket URL clients should connect to.
+   * @return wss:// URL string.
+   */
+  [[nodiscard]] std::string ws_url() const;
+
+  /**
+   * Send timestamps of streamed messages for the most recent session.
+   * Only safe to read once the server IO context has stopped.
+   * @return Send time per streamed message.
+   */
+  [[nodiscard]] const std::vector<std::chrono::steady_clock::time_point>& send_times() const;
+
+  /**
+   * Number of sessions accepted so far.
+   * @return Session count.
+   */
+  [[nodiscard]] std::size_t sessions() const;
+
+private:
+  class Session;
+
+  MockExchangeServer(boost::asio::io_context& ioc,
+                     MockExchangeOptions options,
+                     std::vector<std::string> messages);
+
+  void do_accept();
+
+  boost::asio::ssl::context ssl_ctx_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  MockExchangeOptions options_;
+  std::vector<std::string> messages_;
+  std::vector<std::chrono::steady_clock::time_point> send_times_;
+  std::size_t sessions_ = 0;
+};
+
+/**
+ * Load a newline-delimited capture (the format FeedHandler writes to
+ * output.raw_messages_path) into memory.
+ * @param path Capture file path.
+ * @return One payload per non-empty line or MockServerError.
+ */
+[[nodiscard]] std::expected<std::vector<std::string>, MockServerError> load_capture(
+    std::string_view path);
+
+} // namespace kalshi::bench
@@ -0,0 +1,265 @@
+#include "mock_order_server.hpp"
+
+#include "tls_test_cert.hpp"
+
+#include <string_view>
+#include <utility>
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+
+namespace kalshi::bench
+{
+
+namespace
+{
+
+namespace http = boost::beast::http;
+
+constexpr std::string_view ORDERS_SUFFIX = "/portfolio/orders";
+constexpr std::string_view STATUS_SUFFIX = "/exchange/status";
+constexpr std::string_view CLIENT_ORDER_ID_MARKER = "\"client_order_id\":\"";
+
+std::string_view extract_client_order_id(std::string_view body)
+{
+  auto pos = body.find(CLIENT_ORDER_ID_MARKER);
+  if (pos == std::string_view::npos)
+  {
+    return {};
+  }
+  pos += CLIENT_ORDER_ID_MARKER.size();
+  auto end = body.find('"', pos);
+  return end == std::string_view::npos ? std::string_view{} : body.substr(pos, end - pos);
+}
+
+} // namespace
+
+class MockOrderServer::Session : public std::enable_shared_from_this<Session>
+{
+public:
+  Session(boost::asio::ip::tcp::socket socket, MockOrderServer& server)
+    : stream_(std::move(socket), server.ssl_ctx_),
+      server_(server)
+  {
+    boost::system::error_code ec;
+    boost::beast::get_lowest_layer(stream_).socket().set_option(
+        boost::asio::ip::tcp::no_delay(true), ec);
+  }
+
+  void run()
+  {
+    stream_.async_handshake(
+        boost::asio::ssl::stream_base::server,
+        boost::beast::bind_front_handler(&Session::on_handshake, shared_from_this()));
+  }
+
+private:
+  void on_handshake(boost::system::error_code ec)
+  {
+    if (ec)
+    {
+      return;
+    }
+    do_read();
+  }
+
+  void do_read()
+  {
+    request_ = {};
+    http::async_read(stream_,
+                     buffer_,
+                     request_,
+                     boost::beast::bind_front_handler(&Session::on_read, shared_from_this()));
+  }
+
+  void on_read(boost::system::error_code ec, std::size_t)
+  {
+    if (ec)
+    {
+      return;
+    }
+    ++handled_;
+    ++server_.requests_;
+    build_response();
+    auto limit = server_.options_.max_requests_per_session;
+    response_.keep_alive(request_.keep_alive() && (limit == 0 || handled_ < limit));
+    response_.prepare_payload();
+    http::async_write(stream_,
+                      response_,
+                      boost::beast::bind_front_handler(&Session::on_write, shared_from_this()));
+  }
+
+  void on_write(boost::system::error_code ec, std::size_t)
+  {
+    if (ec)
+    {
+      return;
+    }
+    if (!response_.keep_alive())
+    {
+      stream_.async_shutdown([self = shared_from_this()](boost::system::error_code) {});
+      return;
+    }
+    do_read();
+  }
+
+  void build_response()
+  {
+    const auto& base = server_.options_.base_path;
+    auto target = std::string_view(request_.target().data(), request_.target().size());
+    auto signed_request = request_.find("KALSHI-ACCESS-SIGNATURE") != request_.end() &&
+                          request_.find("KALSHI-ACCESS-TIMESTAMP") != request_.end() &&
+                          request_.find("KALSHI-ACCESS-KEY") != request_.end();
+    response_ = {};
+    response_.version(11);
+    response_.set(http::field::content_type, "application/json");
+
+    if (!target.starts_with(base))
+    {
+      response_.result(http::status::not_found);
+      response_.body() = "{\"error\":{\"code\":\"not_found\"}}";
+      return;
+    }
+    target.remove_prefix(base.size());
+    auto method = request_.method();
+    if (method == http::verb::get && target == STATUS_SUFFIX)
+    {
+      response_.result(http::status::ok);
+      response_.body() = "{\"exchange_active\":true,\"trading_active\":true}";
+      return;
+    }
+    if (!target.starts_with(ORDERS_SUFFIX) ||
+        (method != http::verb::post && method != http::verb::delete_))
+    {
+      response_.result(http::status::not_found);
+      response_.body() = "{\"error\":{\"code\":\"not_found\"}}";
+      return;
+    }
+    if (!signed_request)
+    {
+      response_.result(http::status::unauthorized);
+      response_.body() = "{\"error\":{\"code\":\"authentication_error\"}}";
+      return;
+    }
+
+    auto& body = response_.body();
+    if (method == http::verb::post)
+    {
+      response_.result(http::status::created);
+      body = "{\"order\":{\"order_id\":\"mock-";
+      body.append(std::to_string(server_.requests_));
+      body.append("\",\"client_order_id\":\"");
+      body.append(extract_client_order_id(request_.body()));
+      body.append("\",\"status\":\"resting\"}}");
+      return;
+    }
+    target.remove_prefix(ORDERS_SUFFIX.size());
+    response_.result(http::status::ok);
+    body = "{\"order\":{\"order_id\":\"";
+    body.append(target.starts_with('/') ? target.substr(1) : target);
+    body.append("\",\"status\":\"canceled\"}}");
+  }
+
+  boost::beast::ssl_stream<boost::beast::tcp_stream> stream_;
+  boost::beast::flat_buffer buffer_;
+  http::request<http::string_body> request_;
+  http::response<http::string_body> response_;
+  MockOrderServer& server_;
+  std::size_t handled_ = 0;
+};
+
+MockOrderServer::MockOrderServer(boost::asio::io_context& ioc, MockOrderOptions options)
+  : ssl_ctx_(boost::asio::ssl::context::tls_server),
+    acceptor_(ioc),
+    options_(std::move(options))
+{
+}
+
+MockOrderServer::~MockOrderServer() = default;
+
+std::expected<std::unique_ptr<MockOrderServer>, MockServerError> MockOrderServer::create(
+    boost::asio::io_context& ioc, MockOrderOptions options)
+{
+  std::unique_ptr<MockOrderServer> server(new MockOrderServer(ioc, std::move(options)));
+
+  if (!use_self_signed_cert(server->ssl_ctx_, "localhost"))
+  {
+    return std::unexpected(MockServerError::CertificateFailed);
+  }
+
+  boost::system::error_code ec;
+  auto address = boost::asio::ip::make_address(server->options_.address, ec);
+  if (ec)
+  {
+    return std::unexpected(MockServerError::ListenFailed);
+  }
+  boost::asio::ip::tcp::endpoint endpoint(address, server->options_.port);
+  server->acceptor_.open(endpoint.protocol(), ec);
+  if (!ec)
+  {
+    server->acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec);
+  }
+  if (!ec)
+  {
+    server->acceptor_.bind(endpoint, ec);
+  }
+  if (!ec)
+  {
+    server->acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+  }
+  if (ec)
+  {
+    return std::unexpected(MockServerError::ListenFailed);
+  }
+  return server;
+}
+
+void MockOrderServer::start()
+{
+  do_accept();
+}
+
+void MockOrderServer::stop()
+{
+  boost::system::error_code ec;
+  acceptor_.close(ec);
+}
+
+std::uint16_t MockOrderServer::port() const
+{
+  boost::system::error_code ec;
+  return acceptor_.local_endpoint(ec).port();
+}
+
+std::string MockOrderServer::base_url() const
+{
+  return "https://" + options_.address + ":" + std::to_string(port()) + options_.base_path;
+}
+
+std::size_t MockOrderServer::sessions() const
+{
+  return sessions_;
+}
+
+std::size_t MockOrderServer::requests() const
+{
+  return requests_;
+}
+
+void MockOrderServer::do_accept()
+{
+  acceptor_.async_accept(
+      [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket)
+      {
+        if (ec)
+        {
+          return;
+        }
+        ++sessions_;
+        std::make_shared<Session>(std::move(socket), *this)->run();
+        do_accept();
+      });
+}
+
+} // namespace kalshi::bench
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+#include "mock_exchange_server.hpp"
+
+namespace kalshi::bench
+{
+
+/** Options for the loopback mock order endpoint. */
+struct MockOrderOptions
+{
+  std::string address = "127.0.0.1";
+  std::uint16_t port = 0;              // 0 = ephemeral
+  std::string base_path = "/trade-api/v2";
+  std::size_t max_requests_per_session = 0; // close the connection after this many, 0 = never
+};
+
+/**
+ * Loopback HTTPS server that stands in for the Kalshi order endpoints.
+ *
+ * Sessions are HTTP/1.1 keep-alive. Each request is answered as the
+ * exchange would:
+ * - POST {base}/portfolio/orders: 201 with a resting order
+ * - DELETE {base}/portfolio/orders/{id}: 200 with a canceled order
+ * - GET {base}/exchange/status: 200
+ * Order requests without KALSHI-ACCESS-* headers get 401. Anything else
+ * gets 404.
+ */
+class MockOrderServer
+{
+public:
+  /**
+   * Create a server bound to options.address:options.port.
+   * @param ioc IO context that drives the server.
+   * @param options Server options.
+   * @return MockOrderServer or MockServerError.
+   */
+  [[nodiscard]] static std::expected<std::unique_ptr<MockOrderServer>, MockServerError> create(
+      boost::asio::io_context& ioc, MockOrderOptions options);
+
+  ~MockOrderServer();
+
+  MockOrderServer(const MockOrderServer&) = delete;
+  MockOrderServer& operator=(const MockOrderServer&) = delete;
+
+  /**
+   * Start accepting sessions.
+   * @return void.
+   */
+  void start();
+
+  /**
+   * Stop accepting new sessions.
+   * @return void.
+   */
+  void stop();
+
+  /**
+   * Bound TCP port.
+   * @return Port number.
+   */
+  [[nodiscard]] std::uint16_t port() const;
+
+  /**
+   * REST base URL clients should use.
+   * @return https:// URL string.
+   */
+  [[nodiscard]] std::string base_url() const;
+
+  /**
+   * Number of sessions accepted so far.
+   * @return Session count.
+   */
+  [[nodiscard]] std::size_t sessions() const;
+
+  /**
+   * Number of requests answered so far, across sessions.
+   * @return Request count.
+   */
+  [[nodiscard]] std::size_t requests() const;
+
+private:
+  class Session;
+
+  MockOrderServer(boost::asio::io_context& ioc, MockOrderOptions options);
+
+  void do_accept();
+
+  boost::asio::ssl::context ssl_ctx_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  MockOrderOptions options_;
+  std::size_t sessions_ = 0;
+  std::size_t requests_ = 0;
+};
+
+} // namespace kalshi::bench
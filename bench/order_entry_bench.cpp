@@ -0,0 +1,248 @@
+// Tick-to-order-response latency through the REST order client.
+//
+// Usage: order_entry_bench [--orders N] [--cold-orders N] [--pool N]
+//
+// A loopback MockOrderServer stands in for the exchange on its own thread.
+// The client runs on the main thread and places one limit order at a time,
+// timing from the "tick" (just before create_order) to the 201 response.
+// Rows:
+// - warm_presigned: keep-alive pool, headers from an AuthPresigner
+// - warm_inline: keep-alive pool, RSA-PSS signature computed per order
+// - cold_connect: a new client per order, so every order pays DNS, TCP and
+//   a full TLS handshake before its request
+// "issue" is how long create_order takes to return: serialize, sign, build
+// the request and start the write.
+
+#include "bench_support.hpp"
+#include "mock_order_server.hpp"
+
+#include "kalshi/core/auth.hpp"
+#include "kalshi/trade/rest_client.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Samples
+{
+  std::vector<std::int64_t> tick_to_response;
+  std::vector<std::int64_t> issue;
+  std::size_t errors = 0;
+};
+
+std::string generate_key_pem()
+{
+  std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> pkey(EVP_RSA_gen(2048), &EVP_PKEY_free);
+  std::unique_ptr<BIO, decltype(&BIO_free)> bio(BIO_new(BIO_s_mem()), &BIO_free);
+  if (!pkey || !bio ||
+      PEM_write_bio_PrivateKey(bio.get(), pkey.get(), nullptr, nullptr, 0, nullptr, nullptr) != 1)
+  {
+    return {};
+  }
+  char* data = nullptr;
+  auto len = BIO_get_mem_data(bio.get(), &data);
+  return std::string(data, static_cast<std::size_t>(len));
+}
+
+/** Each row gets its own signer, so no row sees another row's presigned headers. */
+std::shared_ptr<kalshi::AuthSigner> make_signer(const std::string& pem)
+{
+  auto signer = kalshi::AuthSigner::create(
+      kalshi::AuthConfig{.key_id = "bench-key", .private_key_pem = pem});
+  if (!signer)
+  {
+    return nullptr;
+  }
+  return std::make_shared<kalshi::AuthSigner>(std::move(*signer));
+}
+
+template <typename Pred>
+void run_until(boost::asio::io_context& ioc, Pred pred)
+{
+  while (!pred() && ioc.run_one() > 0)
+  {
+  }
+}
+
+/** Place one order and run the IO context until its response arrives. */
+void place_one(boost::asio::io_context& ioc,
+               kalshi::trade::RestClient& client,
+               std::size_t n,
+               Samples& samples)
+{
+  auto client_order_id = "bench-" + std::to_string(n);
+  kalshi::trade::OrderRequest order{.ticker = "KXBENCH-26DEC31",
+                                    .client_order_id = client_order_id,
+                                    .side = kalshi::md::BookSide::Yes,
+                                    .action = kalshi::trade::OrderAction::Buy,
+                                    .count = 1,
+                                    .price = 55};
+  bool done = false;
+  auto tick = Clock::now();
+  auto issued = client.create_order(
+      order,
+      [&](std::expected<kalshi::trade::RestResponse, kalshi::trade::RestError> response)
+      {
+        done = true;
+        if (!response || response->status != 201)
+        {
+          ++samples.errors;
+          return;
+        }
+        samples.tick_to_response.push_back(kalshi::bench::elapsed_ns(tick, Clock::now()));
+      });
+  samples.issue.push_back(kalshi::bench::elapsed_ns(tick, Clock::now()));
+  if (!issued)
+  {
+    ++samples.errors;
+    return;
+  }
+  run_until(ioc, [&] { return done; });
+}
+
+void report(const char* label, Samples& samples, std::uint64_t inline_signatures)
+{
+  std::printf("%s: errors=%zu inline_signatures=%llu\n",
+              label,
+              samples.errors,
+              static_cast<unsigned long long>(inline_signatures));
+  kalshi::bench::print_latency("  tick->response", kalshi::bench::summarize(samples.tick_to_response));
+  kalshi::bench::print_latency("  issue", kalshi::bench::summarize(samples.issue));
+}
+
+void run_warm(const char* label,
+              bool presign,
+              std::size_t orders,
+              std::size_t pool,
+              const std::string& base_url,
+              boost::asio::ssl::context& ssl_ctx,
+              const std::string& pem)
+{
+  auto signer = make_signer(pem);
+  boost::asio::io_context ioc;
+  kalshi::trade::RestClient client(
+      ioc, ssl_ctx, signer, kalshi::trade::RestClientOptions{.base_url = base_url, .pool_size = pool});
+  if (!client.start())
+  {
+    std::printf("%s: client failed to start\n", label);
+    return;
+  }
+  run_until(ioc, [&] { return client.idle_connections() == pool; });
+
+  std::unique_ptr<kalshi::AuthPresigner> presigner;
+  if (presign)
+  {
+    presigner = std::make_unique<kalshi::AuthPresigner>(
+        signer,
+        std::vector<kalshi::AuthPresigner::Request>{{"POST", client.orders_path()}},
+        std::chrono::milliseconds(1000));
+    while (!signer->presigned("POST", client.orders_path(), kalshi::unix_time_ms(), 4000))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  Samples samples;
+  for (std::size_t n = 0; n < orders; ++n)
+  {
+    place_one(ioc, client, n, samples);
+  }
+  client.stop();
+  ioc.run();
+  report(label, samples, client.inline_signatures());
+}
+
+void run_cold(std::size_t orders,
+              const std::string& base_url,
+              boost::asio::ssl::context& ssl_ctx,
+              const std::string& pem)
+{
+  auto signer = make_signer(pem);
+  Samples samples;
+  std::uint64_t inline_signatures = 0;
+  for (std::size_t n = 0; n < orders; ++n)
+  {
+    boost::asio::io_context ioc;
+    kalshi::trade::RestClient client(
+        ioc, ssl_ctx, signer, kalshi::trade::RestClientOptions{.base_url = base_url, .pool_size = 1});
+    auto tick = Clock::now();
+    if (!client.start())
+    {
+      ++samples.errors;
+      continue;
+    }
+    run_until(ioc, [&] { return client.idle_connections() == 1; });
+    auto connected_ns = kalshi::bench::elapsed_ns(tick, Clock::now());
+
+    Samples one;
+    place_one(ioc, client, n, one);
+    samples.errors += one.errors;
+    if (!one.tick_to_response.empty())
+    {
+      samples.tick_to_response.push_back(connected_ns + one.tick_to_response.front());
+      samples.issue.push_back(connected_ns + one.issue.front());
+    }
+    inline_signatures += client.inline_signatures();
+    client.stop();
+    ioc.run();
+  }
+  report("cold_connect", samples, inline_signatures);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto orders = kalshi::bench::arg_uint(argc, argv, "--orders", 2000);
+  auto cold_orders = kalshi::bench::arg_uint(argc, argv, "--cold-orders", 200);
+  auto pool = kalshi::bench::arg_uint(argc, argv, "--pool", 2);
+
+  auto pem = generate_key_pem();
+  if (!make_signer(pem))
+  {
+    std::fprintf(stderr, "signer: key generation failed\n");
+    return 1;
+  }
+
+  boost::asio::io_context server_ioc;
+  auto server = kalshi::bench::MockOrderServer::create(server_ioc, {});
+  if (!server)
+  {
+    std::fprintf(stderr, "mock order server failed to start\n");
+    return 1;
+  }
+  (*server)->start();
+  std::thread server_thread([&server_ioc] { server_ioc.run(); });
+
+  boost::asio::ssl::context ssl_ctx(boost::asio::ssl::context::tls_client);
+  ssl_ctx.set_verify_mode(boost::asio::ssl::verify_none);
+
+  auto base_url = (*server)->base_url();
+  std::printf("orders=%llu cold_orders=%llu pool=%llu\n",
+              static_cast<unsigned long long>(orders),
+              static_cast<unsigned long long>(cold_orders),
+              static_cast<unsigned long long>(pool));
+  run_warm("warm_presigned", true, orders, pool, base_url, ssl_ctx, pem);
+  run_warm("warm_inline", false, orders, pool, base_url, ssl_ctx, pem);
+  run_cold(cold_orders, base_url, ssl_ctx, pem);
+
+  (*server)->stop();
+  server_ioc.stop();
+  server_thread.join();
+  std::printf("server sessions=%zu requests=%zu\n", (*server)->sessions(), (*server)->requests());
+  return 0;
+}
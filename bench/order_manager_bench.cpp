@@ -0,0 +1,230 @@
+// Order lifecycle cost in OrderManager with thousands of live orders.
+//
+// Usage: order_manager_bench [--cycles N] [--seed N]
+//
+// For each pool size the pool is filled with acked orders, then each cycle
+// picks a random live order and retires it the way exchange updates would:
+// - find it by client order id
+// - apply a partial fill
+// - cancel the rest, or fill it completely every other cycle
+// - release the slot
+// Each cycle then creates and acks a replacement, so the live count stays at
+// the pool size. The same cycle runs against a std::unordered_map keyed by
+// std::string as a baseline. Heap allocations made during each timed loop
+// are counted through the global operator new.
+
+#include "bench_support.hpp"
+
+#include "kalshi/trade/order_manager.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+std::size_t g_allocations = 0;
+
+constexpr std::uint32_t ORDER_COUNT = 10;
+
+kalshi::trade::OrderSpec spec(std::uint64_t n)
+{
+  return kalshi::trade::OrderSpec{.market = static_cast<kalshi::md::MarketId>(n % 500),
+                                  .side = n % 2 == 0 ? kalshi::md::BookSide::Yes
+                                                     : kalshi::md::BookSide::No,
+                                  .action = kalshi::trade::OrderAction::Buy,
+                                  .price = static_cast<kalshi::md::Price>(1 + n % 99),
+                                  .count = ORDER_COUNT};
+}
+
+struct Row
+{
+  double cycle_ns = 0.0;
+  double find_ns = 0.0;
+  std::size_t allocations = 0;
+  std::size_t errors = 0;
+};
+
+Row run_manager(std::uint32_t live, std::uint64_t cycles, std::uint64_t seed)
+{
+  kalshi::trade::OrderManager manager(live, "bench-");
+  std::vector<kalshi::trade::OrderHandle> handles;
+  handles.reserve(live);
+  std::string exchange_id = "00000000-0000-0000-0000-000000000000";
+  for (std::uint32_t i = 0; i < live; ++i)
+  {
+    auto handle = manager.create(spec(i));
+    (void)manager.on_ack(*handle, exchange_id);
+    handles.push_back(*handle);
+  }
+
+  Row row;
+  std::mt19937_64 rng(seed);
+  std::vector<std::uint32_t> picks(cycles);
+  for (auto& pick : picks)
+  {
+    pick = static_cast<std::uint32_t>(rng() % live);
+  }
+
+  auto allocations = g_allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t c = 0; c < cycles; ++c)
+  {
+    auto& slot = handles[picks[c]];
+    auto found = manager.find(manager.get(slot)->client_order_id.view());
+    if (!found || !manager.on_fill(*found, ORDER_COUNT / 2))
+    {
+      ++row.errors;
+    }
+    auto done = c % 2 == 0 ? manager.on_cancel(*found) : manager.on_fill(*found, ORDER_COUNT / 2);
+    if (!done || !manager.release(*found))
+    {
+      ++row.errors;
+    }
+    auto next = manager.create(spec(c));
+    if (!next || !manager.on_ack(*next, exchange_id))
+    {
+      ++row.errors;
+      continue;
+    }
+    slot = *next;
+  }
+  auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  row.cycle_ns = static_cast<double>(ns) / static_cast<double>(cycles);
+
+  start = std::chrono::steady_clock::now();
+  std::size_t hits = 0;
+  for (std::uint64_t c = 0; c < cycles; ++c)
+  {
+    hits += manager.find(manager.get(handles[picks[c]])->client_order_id.view()) ? 1 : 0;
+  }
+  ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  row.find_ns = static_cast<double>(ns) / static_cast<double>(cycles);
+  row.allocations = g_allocations - allocations;
+  row.errors += cycles - hits;
+  return row;
+}
+
+/** Same cycle on a node-based map with heap-allocated keys. */
+Row run_map(std::uint32_t live, std::uint64_t cycles, std::uint64_t seed)
+{
+  struct MapOrder
+  {
+    std::string order_id;
+    kalshi::trade::OrderSpec spec;
+    kalshi::trade::OrderState state;
+    std::uint32_t filled;
+  };
+  std::unordered_map<std::string, MapOrder> orders;
+  std::vector<std::string> ids;
+  ids.reserve(live);
+  std::uint64_t sequence = 1;
+  std::string exchange_id = "00000000-0000-0000-0000-000000000000";
+  auto create = [&](std::uint64_t n)
+  {
+    auto id = "bench-" + std::to_string(sequence++);
+    orders.emplace(id,
+                   MapOrder{.order_id = exchange_id,
+                            .spec = spec(n),
+                            .state = kalshi::trade::OrderState::Acked,
+                            .filled = 0});
+    return id;
+  };
+  for (std::uint32_t i = 0; i < live; ++i)
+  {
+    ids.push_back(create(i));
+  }
+
+  Row row;
+  std::mt19937_64 rng(seed);
+  std::vector<std::uint32_t> picks(cycles);
+  for (auto& pick : picks)
+  {
+    pick = static_cast<std::uint32_t>(rng() % live);
+  }
+
+  auto allocations = g_allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t c = 0; c < cycles; ++c)
+  {
+    auto& id = ids[picks[c]];
+    auto it = orders.find(id);
+    if (it == orders.end())
+    {
+      ++row.errors;
+      continue;
+    }
+    it->second.filled += ORDER_COUNT / 2;
+    it->second.state = kalshi::trade::OrderState::PartiallyFilled;
+    it->second.state =
+        c % 2 == 0 ? kalshi::trade::OrderState::Canceled : kalshi::trade::OrderState::Filled;
+    orders.erase(it);
+    id = create(c);
+  }
+  auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  row.cycle_ns = static_cast<double>(ns) / static_cast<double>(cycles);
+
+  start = std::chrono::steady_clock::now();
+  std::size_t hits = 0;
+  for (std::uint64_t c = 0; c < cycles; ++c)
+  {
+    hits += orders.find(ids[picks[c]]) != orders.end() ? 1 : 0;
+  }
+  ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  row.find_ns = static_cast<double>(ns) / static_cast<double>(cycles);
+  row.allocations = g_allocations - allocations;
+  row.errors += cycles - hits;
+  return row;
+}
+
+void print(const char* label, std::uint32_t live, std::uint64_t cycles, const Row& row)
+{
+  std::printf("%-14s live=%-6u cycle=%7.1f ns find=%6.1f ns allocs/cycle=%5.2f errors=%zu\n",
+              label,
+              live,
+              row.cycle_ns,
+              row.find_ns,
+              static_cast<double>(row.allocations) / static_cast<double>(cycles),
+              row.errors);
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  ++g_allocations;
+  if (auto* p = std::malloc(size == 0 ? 1 : size))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+int main(int argc, char** argv)
+{
+  auto cycles = kalshi::bench::arg_uint(argc, argv, "--cycles", 1000000);
+  auto seed = kalshi::bench::arg_uint(argc, argv, "--seed", 7);
+
+  for (std::uint32_t live : {1000u, 4000u, 16000u, 64000u})
+  {
+    print("order_manager", live, cycles, run_manager(live, cycles, seed));
+    print("unordered_map", live, cycles, run_map(live, cycles, seed));
+  }
+  return 0;
+}
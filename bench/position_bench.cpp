@@ -0,0 +1,210 @@
+// Position and P&L tracking: correctness checks, then fill and mark cost.
+//
+// Usage: position_bench [--markets N] [--fills N] [--iterations N] [--seed N]
+//
+// Before timing, known fill sequences are run through PositionTracker and
+// every position, entry cost, realized and unrealized P&L and fee is
+// compared with values worked out by hand:
+// - open long, partial close, flip to short, close to flat
+// - a position opened at uneven prices and closed in pieces, which must
+//   end flat with zero cost and realize exactly proceeds minus cost
+// - taker fee rounding at 1c, 50c and 99c, and a zero maker fee
+// Any mismatch exits non-zero. Rows:
+// - on_fill: random fills across --markets markets, ns per fill
+// - mark_all: marks every market at its book mid, ns per market
+
+#include "bench_support.hpp"
+
+#include "kalshi/md/model/book_views.hpp"
+#include "kalshi/trade/position_tracker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+int failures = 0;
+
+void expect(const char* what, std::int64_t got, std::int64_t want)
+{
+  if (got != want)
+  {
+    ++failures;
+    std::fprintf(stderr,
+                 "mismatch: %s = %lld, expected %lld\n",
+                 what,
+                 static_cast<long long>(got),
+                 static_cast<long long>(want));
+  }
+}
+
+kalshi::md::FillEvent fill(std::string market,
+                           kalshi::md::BookSide side,
+                           kalshi::md::OrderAction action,
+                           kalshi::md::Price yes_price,
+                           kalshi::md::Count count,
+                           bool is_taker)
+{
+  return kalshi::md::FillEvent{.market_ticker = std::move(market),
+                               .trade_id = {},
+                               .order_id = {},
+                               .client_order_id = std::nullopt,
+                               .side = side,
+                               .action = action,
+                               .yes_price = yes_price,
+                               .count = count,
+                               .is_taker = is_taker,
+                               .ts = kalshi::md::Timestamp{0}};
+}
+
+/** Two-sided book with one level per side. */
+kalshi::md::OrderbookSnapshot book(std::string market, kalshi::md::Price yes_bid, kalshi::md::Price no_bid)
+{
+  kalshi::md::OrderbookSnapshot s{.market_ticker = std::move(market),
+                                  .sequence = 1,
+                                  .yes = {},
+                                  .no = {},
+                                  .ts = kalshi::md::Timestamp{0}};
+  s.yes.push_back({.price = yes_bid, .size = 100});
+  s.no.push_back({.price = no_bid, .size = 100});
+  return s;
+}
+
+void expect_record(kalshi::trade::PositionTracker& tracker,
+                   const char* market,
+                   std::int64_t position,
+                   std::int64_t cost,
+                   std::int64_t realized,
+                   std::int64_t unrealized)
+{
+  auto id = *tracker.find(market);
+  const auto& p = tracker.position(id);
+  auto m = tracker.mark(id);
+  std::string prefix = std::string(market) + ".";
+  expect((prefix + "position").c_str(), p.position, position);
+  expect((prefix + "cost").c_str(), p.cost, cost);
+  expect((prefix + "realized").c_str(), p.realized, realized);
+  expect((prefix + "unrealized").c_str(), m.unrealized, unrealized);
+  expect((prefix + "marked").c_str(), m.marked ? 1 : 0, 1);
+}
+
+void check_positions()
+{
+  using kalshi::md::BookSide;
+  using kalshi::md::OrderAction;
+
+  kalshi::md::BookViews views(16);
+  kalshi::trade::PositionTracker tracker(views, kalshi::trade::FeeSchedule{});
+
+  // Market A: YES bid 40, YES ask 100 - 55 = 45, mid 42.5.
+  (void)tracker.on_fill(fill("A", BookSide::Yes, OrderAction::Buy, 40, 10, false));
+  expect("A.unmarked", tracker.mark(*tracker.find("A")).marked ? 1 : 0, 0);
+  views.on_snapshot(book("A", 40, 55));
+  // Long 10 at 40: (42.5 - 40) * 10.
+  expect_record(tracker, "A", 10, 400, 0, 25);
+  // Sell 4 at 45 against an average entry of 40.
+  (void)tracker.on_fill(fill("A", BookSide::Yes, OrderAction::Sell, 45, 4, false));
+  expect_record(tracker, "A", 6, 240, 20, 15);
+  // Buying 10 NO at YES 50 closes the 6 long (+60) and opens 4 short at 50.
+  (void)tracker.on_fill(fill("A", BookSide::No, OrderAction::Buy, 50, 10, false));
+  expect_record(tracker, "A", -4, -200, 80, 30);
+  // Buy 4 YES at 43 to flat: +28, taker fee ceil(0.07 * 4 * 0.43 * 0.57 * 100) = 7.
+  (void)tracker.on_fill(fill("A", BookSide::Yes, OrderAction::Buy, 43, 4, true));
+  expect_record(tracker, "A", 0, 0, 108, 0);
+  expect("A.fees", tracker.position(*tracker.find("A")).fees, 7);
+
+  // Market B: mid 50. 122 paid for 3; closing 2 of them releases 81 of 81.33.
+  views.on_snapshot(book("B", 45, 45));
+  (void)tracker.on_fill(fill("B", BookSide::Yes, OrderAction::Buy, 40, 1, false));
+  (void)tracker.on_fill(fill("B", BookSide::Yes, OrderAction::Buy, 41, 2, false));
+  expect_record(tracker, "B", 3, 122, 0, 28);
+  (void)tracker.on_fill(fill("B", BookSide::Yes, OrderAction::Sell, 50, 2, false));
+  expect_record(tracker, "B", 1, 41, 19, 9);
+  (void)tracker.on_fill(fill("B", BookSide::Yes, OrderAction::Sell, 50, 1, false));
+  expect_record(tracker, "B", 0, 0, 150 - 122, 0);
+
+  auto total = tracker.mark_all();
+  expect("total.realized", total.realized, 108 + 28);
+  expect("total.unrealized", total.unrealized, 0);
+  expect("total.fees", total.fees, 7);
+  expect("total.position", total.position, 0);
+
+  // 700 bps of C * P * (1 - P) dollars, rounded up to the cent.
+  kalshi::trade::FeeSchedule fees{};
+  expect("fee(1c x1)", kalshi::trade::PositionTracker::fee(fees, 1, 1, true), 1);
+  expect("fee(99c x1)", kalshi::trade::PositionTracker::fee(fees, 99, 1, true), 1);
+  expect("fee(1c x100)", kalshi::trade::PositionTracker::fee(fees, 1, 100, true), 7);
+  expect("fee(99c x100)", kalshi::trade::PositionTracker::fee(fees, 99, 100, true), 7);
+  expect("fee(50c x1)", kalshi::trade::PositionTracker::fee(fees, 50, 1, true), 2);
+  expect("fee(50c x100)", kalshi::trade::PositionTracker::fee(fees, 50, 100, true), 175);
+  expect("maker fee", kalshi::trade::PositionTracker::fee(fees, 50, 100, false), 0);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto markets = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--markets", 1000));
+  auto fill_count = kalshi::bench::arg_uint(argc, argv, "--fills", 1000000);
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 5);
+  std::mt19937_64 rng(kalshi::bench::arg_uint(argc, argv, "--seed", 7));
+
+  check_positions();
+  if (failures != 0)
+  {
+    std::fprintf(stderr, "%d position checks failed\n", failures);
+    return 1;
+  }
+  std::printf("position checks passed\n");
+
+  kalshi::md::BookViews views(markets);
+  std::vector<std::string> tickers;
+  for (std::uint32_t m = 0; m < markets; ++m)
+  {
+    tickers.push_back("MKT-" + std::to_string(m));
+    auto yes = static_cast<kalshi::md::Price>(10 + rng() % 70);
+    views.on_snapshot(book(tickers.back(), yes, static_cast<kalshi::md::Price>(99 - yes - 2)));
+  }
+  std::vector<kalshi::md::FillEvent> fills;
+  fills.reserve(fill_count);
+  for (std::uint64_t i = 0; i < fill_count; ++i)
+  {
+    fills.push_back(fill(tickers[rng() % markets],
+                         rng() % 2 == 0 ? kalshi::md::BookSide::Yes : kalshi::md::BookSide::No,
+                         rng() % 2 == 0 ? kalshi::md::OrderAction::Buy : kalshi::md::OrderAction::Sell,
+                         static_cast<kalshi::md::Price>(1 + rng() % 99),
+                         static_cast<kalshi::md::Count>(1 + rng() % 50),
+                         rng() % 2 == 0));
+  }
+
+  std::int64_t fill_ns = INT64_MAX;
+  std::int64_t mark_ns = INT64_MAX;
+  std::int64_t sink = 0;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    kalshi::trade::PositionTracker tracker(views, kalshi::trade::FeeSchedule{});
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& f : fills)
+    {
+      sink += tracker.on_fill(f).position;
+    }
+    fill_ns = std::min(fill_ns, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+
+    start = std::chrono::steady_clock::now();
+    auto total = tracker.mark_all();
+    mark_ns = std::min(mark_ns, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+    sink += total.unrealized;
+  }
+  std::printf("on_fill  markets=%-6u %6.1f ns/fill\n",
+              markets,
+              static_cast<double>(fill_ns) / static_cast<double>(fills.size()));
+  std::printf("mark_all markets=%-6u %6.1f ns/market\n",
+              markets,
+              static_cast<double>(mark_ns) / static_cast<double>(markets));
+  return sink == INT64_MIN ? 1 : 0;
+}
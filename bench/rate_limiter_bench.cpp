@@ -0,0 +1,135 @@
+// Token bucket accuracy under a simulated clock and acquire cost.
+//
+// Usage: rate_limiter_bench [--rate N] [--burst N] [--seconds N] [--ops N] [--threads N]
+//
+// Rows:
+// - simulated_reject: a simulated clock advances 1 ms per step while callers
+//   offer three times the limit through try_acquire(); the granted rate
+//   should match the limit plus the initial burst
+// - simulated_queue: the same offered load through reserve() with no wait
+//   cap, as the websocket outbound queue uses it; every token is granted
+//   and the mean wait shows how far the backlog grows
+// - acquire: ns per try_acquire() on one thread, including the clock read
+// - contended: ns per try_acquire() with several threads on one bucket
+// Each row also prints the bucket's counters.
+
+#include "bench_support.hpp"
+
+#include "kalshi/core/rate_limiter.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void print_stats(const char* label, const kalshi::TokenBucket& bucket)
+{
+  auto stats = bucket.stats();
+  auto delayed = stats.delayed == 0 ? 1 : stats.delayed;
+  std::printf("%-16s granted=%-9llu delayed=%-9llu throttled=%-9llu mean_wait=%.2f ms\n",
+              label,
+              static_cast<unsigned long long>(stats.granted),
+              static_cast<unsigned long long>(stats.delayed),
+              static_cast<unsigned long long>(stats.throttled),
+              static_cast<double>(stats.waited.count()) / static_cast<double>(delayed) / 1e6);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto rate = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--rate", 10));
+  auto burst = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--burst", 10));
+  auto seconds = kalshi::bench::arg_uint(argc, argv, "--seconds", 60);
+  auto ops = kalshi::bench::arg_uint(argc, argv, "--ops", 10000000);
+  auto threads = kalshi::bench::arg_uint(argc, argv, "--threads", 4);
+
+  // Simulated clock: 1 ms steps, offering three times the limit.
+  constexpr auto STEP = std::chrono::milliseconds(1);
+  auto steps = seconds * 1000;
+  auto offered_per_step = 3.0 * rate / 1000.0;
+  {
+    kalshi::TokenBucket bucket(kalshi::RateLimit{rate, burst});
+    kalshi::TokenBucket::Clock::time_point now{};
+    double owed = 0.0;
+    for (std::uint64_t s = 0; s < steps; ++s, now += STEP)
+    {
+      for (owed += offered_per_step; owed >= 1.0; owed -= 1.0)
+      {
+        (void)bucket.try_acquire(now);
+      }
+    }
+    auto granted = bucket.stats().granted;
+    std::printf("simulated_reject rate=%u burst=%u seconds=%llu granted_rate=%.2f/s expected=%.2f/s\n",
+                rate,
+                burst,
+                static_cast<unsigned long long>(seconds),
+                static_cast<double>(granted) / static_cast<double>(seconds),
+                static_cast<double>(rate) + static_cast<double>(burst) / static_cast<double>(seconds));
+    print_stats("simulated_reject", bucket);
+  }
+  {
+    kalshi::TokenBucket bucket(kalshi::RateLimit{rate, burst});
+    kalshi::TokenBucket::Clock::time_point now{};
+    double owed = 0.0;
+    for (std::uint64_t s = 0; s < steps; ++s, now += STEP)
+    {
+      for (owed += offered_per_step; owed >= 1.0; owed -= 1.0)
+      {
+        (void)bucket.reserve(now, 1, std::chrono::nanoseconds::max());
+      }
+    }
+    print_stats("simulated_queue", bucket);
+  }
+
+  // Real clock, a limit high enough that nearly every call succeeds.
+  {
+    kalshi::TokenBucket bucket(kalshi::RateLimit{1'000'000'000, 1'000'000});
+    std::uint64_t granted = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < ops; ++i)
+    {
+      granted += bucket.try_acquire() ? 1 : 0;
+    }
+    auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+    std::printf("acquire          threads=1 %6.1f ns/op granted=%llu\n",
+                static_cast<double>(ns) / static_cast<double>(ops),
+                static_cast<unsigned long long>(granted));
+  }
+  {
+    kalshi::TokenBucket bucket(kalshi::RateLimit{1'000'000'000, 1'000'000});
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    auto per_thread = ops / threads;
+    for (std::uint64_t t = 0; t < threads; ++t)
+    {
+      workers.emplace_back(
+          [&]
+          {
+            while (!go.load(std::memory_order_acquire))
+            {
+            }
+            for (std::uint64_t i = 0; i < per_thread; ++i)
+            {
+              (void)bucket.try_acquire();
+            }
+          });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+    auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+    std::printf("contended        threads=%llu %6.1f ns/op\n",
+                static_cast<unsigned long long>(threads),
+                static_cast<double>(ns) / static_cast<double>(per_thread * threads));
+    print_stats("contended", bucket);
+  }
+  return 0;
+}
@@ -0,0 +1,161 @@
+// Reconnect-to-first-message time with and without connection reuse.
+//
+// Usage: reconnect_bench [--reconnects N] [--messages-per-session N]
+//
+// The mock exchange closes every session after streaming a few messages, so
+// FeedHandler goes through its reconnect path repeatedly. The handler's
+// reconnect_first_message metric is collected from the log stream, once with
+// TLS session resumption and DNS caching enabled and once with both disabled.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+#include "mock_exchange_server.hpp"
+
+#include "kalshi/md/feed_handler.hpp"
+#include "kalshi/md/protocol/subscribe.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+#include <cstdio>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace
+{
+
+/** Logger that keeps reconnect metrics and drops everything else. */
+class MetricLogger : public kalshi::logging::Logger
+{
+public:
+  using Logger::log;
+
+  void log(kalshi::logging::LogEvent event) override
+  {
+    if (event.message != "reconnect_first_message")
+    {
+      return;
+    }
+    for (const auto& field : event.fields.entries())
+    {
+      if (field.key == "reconnect_to_first_message_us")
+      {
+        samples_us.push_back(std::get<std::int64_t>(field.value));
+      }
+      else if (field.key == "tls_resumed" && std::get<bool>(field.value))
+      {
+        ++resumed;
+      }
+    }
+  }
+
+  [[nodiscard]] kalshi::logging::LogLevel level() const override
+  {
+    return kalshi::logging::LogLevel::Info;
+  }
+
+  std::vector<std::int64_t> samples_us;
+  std::size_t resumed = 0;
+};
+
+struct NullSink
+{
+  void on_snapshot(const kalshi::md::OrderbookSnapshot&) {}
+  void on_delta(const kalshi::md::OrderbookDelta&) {}
+  void on_trade(const kalshi::md::TradeEvent&) {}
+  void on_status(const kalshi::md::MarketStatusUpdate&) {}
+};
+
+void run_mode(const char* label,
+              bool reuse,
+              std::size_t reconnects,
+              std::size_t per_session,
+              const std::vector<std::string>& messages,
+              const std::vector<std::string>& tickers)
+{
+  boost::asio::io_context server_ioc;
+  auto server = kalshi::bench::MockExchangeServer::create(
+      server_ioc,
+      kalshi::bench::MockExchangeOptions{.total_messages = per_session, .close_after_stream = true},
+      messages);
+  if (!server)
+  {
+    std::fprintf(stderr, "mock exchange failed to start\n");
+    return;
+  }
+  (*server)->start();
+  std::thread server_thread([&server_ioc] { server_ioc.run(); });
+
+  MetricLogger logger;
+  NullSink sink;
+  kalshi::md::FeedHandler<NullSink> handler(sink, logger);
+
+  boost::asio::io_context ioc;
+  boost::asio::ssl::context ssl_ctx(boost::asio::ssl::context::tls_client);
+  ssl_ctx.set_verify_mode(boost::asio::ssl::verify_none);
+
+  kalshi::md::SubscribeRequest subscription{
+      .id = 1, .channels = {"orderbook_delta"}, .market_tickers = tickers};
+
+  kalshi::md::FeedHandler<NullSink>::RunOptions options{
+      .ws_url = (*server)->ws_url(),
+      .headers = {},
+      .refresh_headers = {},
+      .subscription = subscription,
+      .output_path = "/dev/null",
+      .include_raw_on_parse_error = false,
+      .log_raw_messages = false,
+      .auto_reconnect = true,
+      .reconnect_initial_delay = std::chrono::milliseconds(1),
+      .reconnect_max_delay = std::chrono::milliseconds(1),
+      .handshake_timeout = std::chrono::milliseconds(30000),
+      .idle_timeout = std::chrono::milliseconds(60000),
+      .keep_alive_pings = false,
+      // Each session delivers the `subscribed` ack plus per_session messages.
+      .max_messages = (reconnects + 1) * (per_session + 1),
+      .tls_session_resumption = reuse,
+      .dns_cache_ttl = std::chrono::milliseconds(reuse ? 60000 : 0),
+      .hot_standby = false,
+      .fast_delta_scan = true};
+
+  (void)handler.run(ioc, ssl_ctx, std::move(options));
+
+  (*server)->stop();
+  server_ioc.stop();
+  server_thread.join();
+
+  std::vector<std::int64_t> samples_ns;
+  samples_ns.reserve(logger.samples_us.size());
+  for (auto us : logger.samples_us)
+  {
+    samples_ns.push_back(us * 1000);
+  }
+  std::printf("%s: reconnects=%zu tls_resumed=%zu\n", label, samples_ns.size(), logger.resumed);
+  kalshi::bench::print_latency("reconnect->first_message", kalshi::bench::summarize(samples_ns));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto reconnects = kalshi::bench::arg_uint(argc, argv, "--reconnects", 200);
+  auto per_session = kalshi::bench::arg_uint(argc, argv, "--messages-per-session", 5);
+
+  kalshi::bench::MarketDataGenerator generator(kalshi::bench::GeneratorOptions{});
+  auto messages = generator.generate(per_session).to_strings();
+
+  run_mode("cold (no resumption, no dns cache)",
+           false,
+           reconnects,
+           per_session,
+           messages,
+           generator.tickers());
+  run_mode("warm (tls resumption + dns cache)",
+           true,
+           reconnects,
+           per_session,
+           messages,
+           generator.tickers());
+  return 0;
+}
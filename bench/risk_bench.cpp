@@ -0,0 +1,135 @@
+// Pre-trade risk check cost across many markets.
+//
+// Usage: risk_bench [--markets N] [--orders N] [--iterations N] [--seed N]
+//
+// Every market gets a reference price and some existing position and open
+// orders. A pre-generated stream of orders is then run through
+// RiskEngine::check. Orders pick a random market, a price near or outside
+// its band and a random size, so passing and rejected checks mix the way
+// they would live. Rows:
+// - check: check() alone, the cost added in front of every order
+// - check_and_reserve: check(), then on_sent() and on_closed() for orders
+//   that pass, i.e. the full bookkeeping of a short-lived order
+// Each row prints ns per order and how many orders passed.
+
+#include "bench_support.hpp"
+
+#include "kalshi/trade/risk_engine.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+std::vector<kalshi::trade::OrderSpec> generate_orders(const kalshi::trade::RiskEngine& risk,
+                                                      std::size_t count,
+                                                      std::mt19937_64& rng)
+{
+  std::vector<kalshi::trade::OrderSpec> orders;
+  orders.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto market = static_cast<kalshi::md::MarketId>(rng() % risk.market_capacity());
+    auto side = rng() % 2 == 0 ? kalshi::md::BookSide::Yes : kalshi::md::BookSide::No;
+    // Mostly inside a 10c band, sometimes just outside it.
+    auto offset = static_cast<int>(rng() % 25) - 12;
+    auto yes = static_cast<int>(risk.market(market).reference) + offset;
+    auto price = side == kalshi::md::BookSide::Yes ? yes : 100 - yes;
+    orders.push_back(kalshi::trade::OrderSpec{
+        .market = market,
+        .side = side,
+        .action = rng() % 2 == 0 ? kalshi::trade::OrderAction::Buy : kalshi::trade::OrderAction::Sell,
+        .price = static_cast<kalshi::md::Price>(price),
+        .count = static_cast<std::uint32_t>(1 + rng() % 200)});
+  }
+  return orders;
+}
+
+void print(const char* label, std::uint32_t markets, std::uint64_t checks, std::int64_t ns, std::uint64_t passed)
+{
+  std::printf("%-18s markets=%-6u %6.1f ns/order passed=%5.1f%%\n",
+              label,
+              markets,
+              static_cast<double>(ns) / static_cast<double>(checks),
+              100.0 * static_cast<double>(passed) / static_cast<double>(checks));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto markets = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--markets", 10000));
+  auto order_count = kalshi::bench::arg_uint(argc, argv, "--orders", 1000000);
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 5);
+  std::mt19937_64 rng(kalshi::bench::arg_uint(argc, argv, "--seed", 7));
+
+  kalshi::trade::RiskLimits limits;
+  limits.max_position = 2000;
+  limits.max_market_open_orders = 8;
+  limits.max_total_open_orders = 8 * markets;
+  limits.max_total_notional = 1'000'000'000;
+  kalshi::trade::RiskEngine risk(markets, limits);
+
+  // Existing state: a reference, a position and a few resting orders per market.
+  for (kalshi::md::MarketId m = 0; m < markets; ++m)
+  {
+    risk.set_reference(m, static_cast<kalshi::md::Price>(15 + rng() % 70));
+    risk.set_position(m, static_cast<std::int32_t>(rng() % 3000) - 1500);
+    for (int i = 0; i < static_cast<int>(rng() % 6); ++i)
+    {
+      auto resting = kalshi::trade::OrderSpec{.market = m,
+                                              .side = kalshi::md::BookSide::Yes,
+                                              .action = i % 2 == 0 ? kalshi::trade::OrderAction::Buy
+                                                                   : kalshi::trade::OrderAction::Sell,
+                                              .price = risk.market(m).reference,
+                                              .count = 50};
+      if (risk.check(resting))
+      {
+        risk.on_sent(resting);
+      }
+    }
+  }
+  auto orders = generate_orders(risk, order_count, rng);
+  std::printf("markets=%u orders=%zu open_orders=%u open_notional=%lld\n",
+              markets,
+              orders.size(),
+              risk.total_open_orders(),
+              static_cast<long long>(risk.total_notional()));
+
+  std::uint64_t passed = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    for (const auto& order : orders)
+    {
+      passed += risk.check(order) ? 1 : 0;
+    }
+  }
+  print("check", markets, iterations * orders.size(),
+        kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()), passed);
+
+  passed = 0;
+  start = std::chrono::steady_clock::now();
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    for (const auto& order : orders)
+    {
+      if (risk.check(order))
+      {
+        ++passed;
+        risk.on_sent(order);
+        risk.on_closed(order, order.count);
+      }
+    }
+  }
+  print("check_and_reserve", markets, iterations * orders.size(),
+        kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()), passed);
+
+  std::printf("after: open_orders=%u open_notional=%lld\n",
+              risk.total_open_orders(),
+              static_cast<long long>(risk.total_notional()));
+  return 0;
+}
@@ -0,0 +1,210 @@
+// Per-event cost of broadcasting to filtering sinks vs routing by market.
+//
+// Usage: routing_bench [--messages N] [--markets N] [--per-strategy N] [--iterations N]
+//
+// Each strategy cares about --per-strategy markets out of --markets. The
+// broadcast rows hand every delta to every strategy through FanoutSink and
+// let it filter with its own ticker set; the routing rows register the same
+// markets with RoutingSink, so only interested strategies are called. Both
+// run per event and, for routing, through the batch interface.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+
+#include "kalshi/md/model/routing_sink.hpp"
+#include "kalshi/md/parse/event_parser.hpp"
+#include "kalshi/md/parse/message_parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+/** Events per on_deltas call, matching what the dispatcher hands over. */
+constexpr std::size_t BATCH = 64;
+
+template <std::size_t, typename T>
+using Repeat = T;
+
+/** Strategy that filters everything it is given against its own markets. */
+struct FilteringStrategy
+{
+  void on_snapshot(const kalshi::md::OrderbookSnapshot&) {}
+  void on_delta(const kalshi::md::OrderbookDelta& d)
+  {
+    if (markets.contains(d.market_ticker))
+    {
+      ++events;
+    }
+  }
+  void on_trade(const kalshi::md::TradeEvent&) {}
+  void on_status(const kalshi::md::MarketStatusUpdate&) {}
+
+  std::unordered_set<std::string> markets;
+  std::size_t events = 0;
+};
+
+/** Strategy that trusts the router. */
+struct RoutedStrategy
+{
+  void on_snapshot(const kalshi::md::OrderbookSnapshot&) {}
+  void on_delta(const kalshi::md::OrderbookDelta&) { ++events; }
+  void on_trade(const kalshi::md::TradeEvent&) {}
+  void on_status(const kalshi::md::MarketStatusUpdate&) {}
+
+  std::size_t events = 0;
+};
+
+struct Row
+{
+  double broadcast_ns = 0.0;
+  double routed_ns = 0.0;
+  double routed_batch_ns = 0.0;
+  std::size_t broadcast_events = 0;
+  std::size_t routed_events = 0;
+};
+
+template <typename Fn>
+double ns_per_event(std::size_t events, std::uint64_t iterations, Fn fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < iterations; ++i)
+  {
+    fn();
+  }
+  auto ns = kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now());
+  return static_cast<double>(ns) / static_cast<double>(iterations * events);
+}
+
+template <std::size_t N, std::size_t... I>
+Row run(const std::vector<kalshi::md::OrderbookDelta>& deltas,
+        const std::vector<std::string>& tickers,
+        std::size_t per_strategy,
+        std::uint64_t iterations,
+        std::index_sequence<I...>)
+{
+  // Strategy s takes a contiguous block of tickers, spread over the universe.
+  auto market_of = [&](std::size_t strategy, std::size_t k)
+  { return tickers[(strategy * per_strategy * 7 + k) % tickers.size()]; };
+
+  std::array<FilteringStrategy, N> filtering;
+  std::array<RoutedStrategy, N> routed;
+  for (std::size_t s = 0; s < N; ++s)
+  {
+    for (std::size_t k = 0; k < per_strategy; ++k)
+    {
+      filtering[s].markets.insert(market_of(s, k));
+    }
+  }
+
+  kalshi::md::FanoutSink<Repeat<I, FilteringStrategy>...> fanout(filtering[I]...);
+  kalshi::md::RoutingSink<Repeat<I, RoutedStrategy>...> router(routed[I]...);
+  for (std::size_t k = 0; k < per_strategy; ++k)
+  {
+    (router.template route_market<I>(market_of(I, k)), ...);
+  }
+
+  Row row;
+  row.broadcast_ns = ns_per_event(deltas.size(),
+                                  iterations,
+                                  [&]
+                                  {
+                                    for (const auto& d : deltas)
+                                    {
+                                      fanout.on_delta(d);
+                                    }
+                                  });
+  row.routed_ns = ns_per_event(deltas.size(),
+                               iterations,
+                               [&]
+                               {
+                                 for (const auto& d : deltas)
+                                 {
+                                   router.on_delta(d);
+                                 }
+                               });
+  row.routed_batch_ns = ns_per_event(
+      deltas.size(),
+      iterations,
+      [&]
+      {
+        std::span<const kalshi::md::OrderbookDelta> all(deltas);
+        for (std::size_t begin = 0; begin < all.size(); begin += BATCH)
+        {
+          router.on_deltas(all.subspan(begin, std::min(BATCH, all.size() - begin)));
+        }
+      });
+  for (std::size_t s = 0; s < N; ++s)
+  {
+    row.broadcast_events += filtering[s].events;
+    row.routed_events += routed[s].events;
+  }
+  return row;
+}
+
+template <std::size_t N>
+void report(const std::vector<kalshi::md::OrderbookDelta>& deltas,
+            const std::vector<std::string>& tickers,
+            std::size_t per_strategy,
+            std::uint64_t iterations)
+{
+  auto row = run<N>(deltas, tickers, per_strategy, iterations, std::make_index_sequence<N>{});
+  // Routed runs twice (per event and batched), so expect 2x the broadcast hits.
+  bool consistent = row.routed_events == 2 * row.broadcast_events;
+  std::printf("strategies=%-3zu broadcast=%7.1f ns/event routed=%6.1f ns/event "
+              "routed_batch=%6.1f ns/event hits=%zu%s\n",
+              N,
+              row.broadcast_ns,
+              row.routed_ns,
+              row.routed_batch_ns,
+              row.broadcast_events,
+              consistent ? "" : " MISMATCH");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto total = kalshi::bench::arg_uint(argc, argv, "--messages", 200000);
+  auto per_strategy = kalshi::bench::arg_uint(argc, argv, "--per-strategy", 5);
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 3);
+
+  kalshi::bench::GeneratorOptions generator_options;
+  generator_options.markets = kalshi::bench::arg_uint(argc, argv, "--markets", 2000);
+  generator_options.initial_snapshots = false;
+  kalshi::bench::MarketDataGenerator generator(generator_options);
+  auto buffer = generator.generate(total);
+
+  std::vector<kalshi::md::OrderbookDelta> deltas;
+  deltas.reserve(buffer.size());
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+  {
+    auto type = kalshi::md::parse_message_type(buffer[i]);
+    if (!type || *type != kalshi::md::MessageType::OrderbookDelta)
+    {
+      continue;
+    }
+    if (auto delta = kalshi::md::parse_orderbook_delta(buffer[i]))
+    {
+      deltas.push_back(std::move(*delta));
+    }
+  }
+  std::printf("deltas=%zu markets=%zu per_strategy=%llu\n",
+              deltas.size(),
+              generator.tickers().size(),
+              static_cast<unsigned long long>(per_strategy));
+
+  report<1>(deltas, generator.tickers(), per_strategy, iterations);
+  report<8>(deltas, generator.tickers(), per_strategy, iterations);
+  report<32>(deltas, generator.tickers(), per_strategy, iterations);
+  report<64>(deltas, generator.tickers(), per_strategy, iterations);
+  return 0;
+}
@@ -0,0 +1,293 @@
+// Fan-out of one feed to several processes through a shared-memory segment.
+//
+// Usage: shm_bench [--messages N] [--markets N] [--readers N] [--ring N] [--name NAME]
+//
+// The parent replays pre-parsed events into a ShmPublisher, once with no
+// readers and once with --readers forked processes. Each reader maps the
+// segment with ShmReader and rebuilds every book from the ring. Once the
+// publisher closes, it checks its books against the seqlocked top of book
+// and reports:
+// - events seen
+// - events lost to lapping
+// - how long after the last publish it finished draining
+// Publish cost is reported per event for both runs, so the second row shows
+// what polling readers cost the writer.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+
+#include "kalshi/md/model/order_book.hpp"
+#include "kalshi/md/parse/event_parser.hpp"
+#include "kalshi/md/parse/message_parser.hpp"
+#include "kalshi/md/shm/shm_publisher.hpp"
+#include "kalshi/md/shm/shm_reader.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace
+{
+
+using Event = std::variant<kalshi::md::OrderbookSnapshot, kalshi::md::OrderbookDelta, kalshi::md::TradeEvent>;
+
+/** What a reader process sends back through its pipe. */
+struct ReaderReport
+{
+  std::uint64_t events = 0;
+  std::uint64_t lost = 0;
+  std::uint64_t mismatched_markets = 0;
+  std::int64_t drained_at_ns = 0; // steady clock, comparable across processes
+  int error = 0;
+};
+
+std::int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::vector<Event> parse_events(const kalshi::bench::MessageBuffer& buffer)
+{
+  std::vector<Event> events;
+  events.reserve(buffer.size());
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+  {
+    auto type = kalshi::md::parse_message_type(buffer[i]);
+    if (!type)
+    {
+      continue;
+    }
+    switch (*type)
+    {
+    case kalshi::md::MessageType::OrderbookSnapshot:
+      if (auto snapshot = kalshi::md::parse_orderbook_snapshot(buffer[i]))
+      {
+        events.emplace_back(std::move(*snapshot));
+      }
+      break;
+    case kalshi::md::MessageType::OrderbookDelta:
+      if (auto delta = kalshi::md::parse_orderbook_delta(buffer[i]))
+      {
+        events.emplace_back(std::move(*delta));
+      }
+      break;
+    case kalshi::md::MessageType::Trade:
+      if (auto trade = kalshi::md::parse_trade_event(buffer[i]))
+      {
+        events.emplace_back(std::move(*trade));
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  return events;
+}
+
+/**
+ * Reader process body: rebuild books from the ring until the publisher
+ * closes, then compare with the published top of book.
+ */
+ReaderReport run_reader(const std::string& name, int ready_fd)
+{
+  ReaderReport report;
+  auto reader = kalshi::md::ShmReader::open(name);
+  char ready = reader ? 1 : 0;
+  if (::write(ready_fd, &ready, 1) != 1 || !reader)
+  {
+    report.error = 1;
+    return report;
+  }
+
+  std::vector<kalshi::md::OrderBook> books;
+  auto apply = [&](const kalshi::md::ShmEvent& event)
+  {
+    ++report.events;
+    if (event.market >= books.size())
+    {
+      books.resize(event.market + 1);
+    }
+    auto& book = books[event.market];
+    switch (event.kind)
+    {
+    case kalshi::md::ShmEventKind::Snapshot:
+      book.clear();
+      break;
+    case kalshi::md::ShmEventKind::SnapshotLevel:
+      book.set(event.side, event.price, static_cast<kalshi::md::Size>(event.quantity));
+      break;
+    case kalshi::md::ShmEventKind::BookDelta:
+      book.add(event.side, event.price, event.quantity);
+      break;
+    case kalshi::md::ShmEventKind::Trade:
+    case kalshi::md::ShmEventKind::Status:
+      break;
+    }
+  };
+
+  while (true)
+  {
+    auto closed = reader->closed();
+    if (reader->poll(apply) == 0 && closed)
+    {
+      break;
+    }
+  }
+  report.drained_at_ns = now_ns();
+  report.lost = reader->lost();
+
+  static const kalshi::md::OrderBook empty;
+  for (kalshi::md::MarketId id = 0; id < reader->market_count(); ++id)
+  {
+    auto top = reader->top_of_book(id);
+    const auto& book = id < books.size() ? books[id] : empty;
+    auto yes = book.best(kalshi::md::BookSide::Yes);
+    auto no = book.best(kalshi::md::BookSide::No);
+    auto yes_size = yes ? book.size(kalshi::md::BookSide::Yes, *yes) : 0;
+    auto no_size = no ? book.size(kalshi::md::BookSide::No, *no) : 0;
+    if (top.yes_size != yes_size || (yes_size != 0 && top.yes_price != *yes) ||
+        top.no_size != no_size || (no_size != 0 && top.no_price != *no))
+    {
+      ++report.mismatched_markets;
+    }
+  }
+  return report;
+}
+
+void run(const std::string& name,
+         const std::vector<Event>& events,
+         std::uint64_t readers,
+         kalshi::md::ShmPublisher::Options options)
+{
+  auto publisher = kalshi::md::ShmPublisher::create(name, options);
+  if (!publisher)
+  {
+    std::printf("create failed: %s\n", kalshi::md::to_string(publisher.error()));
+    return;
+  }
+
+  std::vector<pid_t> children;
+  std::vector<int> report_fds;
+  int ready_pipe[2];
+  if (::pipe(ready_pipe) != 0)
+  {
+    std::printf("pipe failed\n");
+    return;
+  }
+  for (std::uint64_t r = 0; r < readers; ++r)
+  {
+    int report_pipe[2];
+    if (::pipe(report_pipe) != 0)
+    {
+      std::printf("pipe failed\n");
+      return;
+    }
+    auto pid = ::fork();
+    if (pid == 0)
+    {
+      auto report = run_reader(name, ready_pipe[1]);
+      auto written = ::write(report_pipe[1], &report, sizeof(report));
+      ::_exit(written == sizeof(report) ? 0 : 1);
+    }
+    ::close(report_pipe[1]);
+    children.push_back(pid);
+    report_fds.push_back(report_pipe[0]);
+  }
+  for (std::uint64_t r = 0; r < readers; ++r)
+  {
+    char ready = 0;
+    if (::read(ready_pipe[0], &ready, 1) != 1 || ready != 1)
+    {
+      std::printf("reader failed to open the segment\n");
+    }
+  }
+  ::close(ready_pipe[0]);
+  ::close(ready_pipe[1]);
+
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& event : events)
+  {
+    std::visit(
+        [&](const auto& e)
+        {
+          using T = std::decay_t<decltype(e)>;
+          if constexpr (std::is_same_v<T, kalshi::md::OrderbookSnapshot>)
+          {
+            publisher->on_snapshot(e);
+          }
+          else if constexpr (std::is_same_v<T, kalshi::md::OrderbookDelta>)
+          {
+            publisher->on_delta(e);
+          }
+          else
+          {
+            publisher->on_trade(e);
+          }
+        },
+        event);
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto published_at = now_ns();
+  publisher->close();
+
+  auto ns = kalshi::bench::elapsed_ns(start, end);
+  std::printf("readers=%-2llu publish=%6.1f ns/event records=%llu dropped=%llu\n",
+              static_cast<unsigned long long>(readers),
+              static_cast<double>(ns) / static_cast<double>(events.size()),
+              static_cast<unsigned long long>(publisher->published()),
+              static_cast<unsigned long long>(publisher->dropped()));
+
+  for (std::size_t r = 0; r < children.size(); ++r)
+  {
+    ReaderReport report;
+    auto got = ::read(report_fds[r], &report, sizeof(report));
+    ::close(report_fds[r]);
+    ::waitpid(children[r], nullptr, 0);
+    if (got != sizeof(report) || report.error != 0)
+    {
+      std::printf("  reader %zu failed\n", r);
+      continue;
+    }
+    std::printf("  reader %zu events=%llu lost=%llu drain_lag=%lldns mismatched_markets=%llu%s\n",
+                r,
+                static_cast<unsigned long long>(report.events),
+                static_cast<unsigned long long>(report.lost),
+                static_cast<long long>(report.drained_at_ns - published_at),
+                static_cast<unsigned long long>(report.mismatched_markets),
+                report.lost == 0 && report.events != publisher->published() ? " INCOMPLETE" : "");
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto total = kalshi::bench::arg_uint(argc, argv, "--messages", 500000);
+  auto readers = kalshi::bench::arg_uint(argc, argv, "--readers", 4);
+  auto name = kalshi::bench::arg_value(argc, argv, "--name", "/kalshi_shm_bench");
+
+  kalshi::md::ShmPublisher::Options options;
+  options.ring_capacity = kalshi::bench::arg_uint(argc, argv, "--ring", options.ring_capacity);
+
+  kalshi::bench::GeneratorOptions generator_options;
+  generator_options.markets = kalshi::bench::arg_uint(argc, argv, "--markets", 500);
+  kalshi::bench::MarketDataGenerator generator(generator_options);
+  auto events = parse_events(generator.generate(total));
+  std::printf("events=%zu markets=%zu ring=%llu\n",
+              events.size(),
+              generator.tickers().size(),
+              static_cast<unsigned long long>(options.ring_capacity));
+
+  run(name, events, 0, options);
+  run(name, events, readers, options);
+  return 0;
+}
@@ -0,0 +1,253 @@
+// Cost of incremental microstructure signals at full feed rate.
+//
+// Usage: signals_bench [--messages N] [--markets N] [--iterations N] [--depth N] [--capture PATH]
+//
+// Generated messages, or a newline-delimited capture, are decoded once into
+// events. Rows:
+// - book_views: events replayed into BookViews, the existing per-market
+//   book sink, for scale
+// - signals: events replayed into MarketSignals alone
+// - dispatch_only: raw messages through Dispatcher into a sink that only
+//   counts, the decode cost the feed pays anyway
+// - dispatch_signals: raw messages through Dispatcher into MarketSignals,
+//   the full feed path
+// Each row prints event throughput and ns per event over the best
+// iteration. A scan row then times one pass over every market's signal
+// columns, picking the markets with the strongest book and flow imbalance.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+#include "mock_exchange_server.hpp"
+
+#include "kalshi/md/dispatcher.hpp"
+#include "kalshi/md/model/book_views.hpp"
+#include "kalshi/md/model/market_signals.hpp"
+#include "kalshi/md/model/market_sink.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace
+{
+
+using Event = std::variant<kalshi::md::OrderbookSnapshot,
+                           kalshi::md::OrderbookDelta,
+                           kalshi::md::TradeEvent,
+                           kalshi::md::MarketStatusUpdate>;
+
+/** Keeps every decoded event for replay. */
+struct RecordingSink
+{
+  std::vector<Event> events;
+
+  void on_snapshot(const kalshi::md::OrderbookSnapshot& s) { events.emplace_back(s); }
+  void on_delta(const kalshi::md::OrderbookDelta& d) { events.emplace_back(d); }
+  void on_trade(const kalshi::md::TradeEvent& t) { events.emplace_back(t); }
+  void on_status(const kalshi::md::MarketStatusUpdate& u) { events.emplace_back(u); }
+};
+
+/** Counts events and nothing else. */
+struct CountingSink
+{
+  std::uint64_t events = 0;
+
+  void on_snapshot(const kalshi::md::OrderbookSnapshot&) { ++events; }
+  void on_delta(const kalshi::md::OrderbookDelta&) { ++events; }
+  void on_trade(const kalshi::md::TradeEvent&) { ++events; }
+  void on_status(const kalshi::md::MarketStatusUpdate&) { ++events; }
+};
+
+template <kalshi::md::MarketSink Sink>
+void replay(const std::vector<Event>& events, Sink& sink)
+{
+  for (const auto& event : events)
+  {
+    std::visit(
+        [&](const auto& e)
+        {
+          using E = std::decay_t<decltype(e)>;
+          if constexpr (std::is_same_v<E, kalshi::md::OrderbookSnapshot>)
+          {
+            sink.on_snapshot(e);
+          }
+          else if constexpr (std::is_same_v<E, kalshi::md::OrderbookDelta>)
+          {
+            sink.on_delta(e);
+          }
+          else if constexpr (std::is_same_v<E, kalshi::md::TradeEvent>)
+          {
+            sink.on_trade(e);
+          }
+          else
+          {
+            sink.on_status(e);
+          }
+        },
+        event);
+  }
+}
+
+void print_row(const char* label, std::uint64_t events, std::int64_t ns)
+{
+  std::printf("%-17s %7.2f M events/s %7.1f ns/event\n",
+              label,
+              static_cast<double>(events) * 1e3 / static_cast<double>(ns),
+              static_cast<double>(ns) / static_cast<double>(events));
+}
+
+/** Index of the largest |value|, skipping NaN; 0 if none. */
+std::size_t strongest(std::span<const double> values)
+{
+  std::size_t best = 0;
+  double best_abs = -1.0;
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    auto magnitude = std::abs(values[i]);
+    if (magnitude > best_abs)
+    {
+      best_abs = magnitude;
+      best = i;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto count = kalshi::bench::arg_uint(argc, argv, "--messages", 2000000);
+  auto markets = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--markets", 200));
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 3);
+  auto depth = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--depth", 5));
+  auto capture = kalshi::bench::arg_value(argc, argv, "--capture", {});
+
+  std::vector<std::string> messages;
+  if (capture.empty())
+  {
+    kalshi::bench::GeneratorOptions generator_options;
+    generator_options.markets = markets;
+    kalshi::bench::MarketDataGenerator generator(generator_options);
+    messages = generator.generate(count).to_strings();
+  }
+  else
+  {
+    auto loaded = kalshi::bench::load_capture(capture);
+    if (!loaded)
+    {
+      std::fprintf(stderr, "failed to load capture %s\n", capture.c_str());
+      return 1;
+    }
+    messages = std::move(*loaded);
+  }
+
+  RecordingSink recording;
+  {
+    kalshi::md::Dispatcher<RecordingSink> dispatcher(recording);
+    for (const auto& message : messages)
+    {
+      (void)dispatcher.on_message(message);
+    }
+  }
+  auto events = static_cast<std::uint64_t>(recording.events.size());
+  std::printf("messages=%zu events=%llu markets=%u depth=%u\n",
+              messages.size(),
+              static_cast<unsigned long long>(events),
+              markets,
+              depth);
+
+  // Room for every market in a capture, whatever --markets says.
+  kalshi::md::SignalOptions options;
+  options.market_capacity = std::max<std::uint32_t>(markets, 1u << 14);
+  options.depth_levels = depth;
+
+  std::int64_t best = INT64_MAX;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    kalshi::md::BookViews views(options.market_capacity);
+    auto start = std::chrono::steady_clock::now();
+    replay(recording.events, views);
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+  }
+  print_row("book_views", events, best);
+
+  best = INT64_MAX;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    kalshi::md::MarketSignals signals(options);
+    auto start = std::chrono::steady_clock::now();
+    replay(recording.events, signals);
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+  }
+  print_row("signals", events, best);
+
+  best = INT64_MAX;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    CountingSink counting;
+    kalshi::md::Dispatcher<CountingSink> dispatcher(counting);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& message : messages)
+    {
+      (void)dispatcher.on_message(message);
+    }
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+  }
+  print_row("dispatch_only", events, best);
+
+  best = INT64_MAX;
+  kalshi::md::MarketSignals signals(options);
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    signals = kalshi::md::MarketSignals(options);
+    kalshi::md::Dispatcher<kalshi::md::MarketSignals> dispatcher(signals);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& message : messages)
+    {
+      (void)dispatcher.on_message(message);
+    }
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+  }
+  print_row("dispatch_signals", events, best);
+
+  if (signals.market_count() == 0)
+  {
+    return 0;
+  }
+  best = INT64_MAX;
+  std::size_t book_pick = 0;
+  std::size_t flow_pick = 0;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    auto start = std::chrono::steady_clock::now();
+    book_pick = strongest(signals.book_imbalance());
+    flow_pick = strongest(signals.flow_imbalance());
+    best = std::min(best, kalshi::bench::elapsed_ns(start, std::chrono::steady_clock::now()));
+  }
+  std::printf("scan %u markets: %.1f ns/market\n",
+              signals.market_count(),
+              static_cast<double>(best) / static_cast<double>(signals.market_count()));
+
+  for (auto pick : {book_pick, flow_pick})
+  {
+    auto id = static_cast<kalshi::md::MarketId>(pick);
+    auto s = signals.signal(id);
+    std::printf("%-28s mid=%5.1f ewma=%5.1f micro=%6.2f book_imb=%+.3f flow_imb=%+.3f vol=%.2f/%.2f\n",
+                signals.ticker(id).c_str(),
+                s.mid,
+                s.ewma_mid,
+                s.microprice,
+                s.book_imbalance,
+                s.flow_imbalance,
+                s.short_volatility,
+                s.long_volatility);
+  }
+  return 0;
+}
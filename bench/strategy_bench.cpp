@@ -0,0 +1,150 @@
+// Tick-to-intent latency of a compile-time strategy pipeline.
+//
+// Usage: strategy_bench [--messages N] [--markets N] [--iterations N]
+//
+// Generated snapshot, delta and trade messages are replayed from memory
+// through Dispatcher -> StrategyPipeline -> MarketMaker -> RiskGate -> a
+// stub gateway, every hop a direct call. For each message that produces an
+// intent, the time from handing the raw JSON to the dispatcher until the
+// gateway receives the first intent is recorded. The gateway reserves
+// quotes with the risk engine and releases them on cancel, as a real
+// gateway does, so limits do not fill up. The
+// summary row gives the mean cost per message including messages that
+// produce nothing.
+
+#include "bench_support.hpp"
+#include "market_data_generator.hpp"
+
+#include "kalshi/md/dispatcher.hpp"
+#include "kalshi/strategy/market_maker.hpp"
+#include "kalshi/strategy/pipeline.hpp"
+#include "kalshi/trade/risk_engine.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+/** Gateway stand-in: stamps the first intent and tracks resting quotes. */
+class StubGateway
+{
+public:
+  StubGateway(kalshi::trade::RiskEngine& risk, std::uint32_t markets) : risk_(risk), resting_(markets) {}
+
+  void on_intent(const kalshi::strategy::OrderIntent& intent)
+  {
+    if (!stamped_)
+    {
+      first_intent_ = std::chrono::steady_clock::now();
+      stamped_ = true;
+    }
+    auto& resting = resting_[intent.order.market];
+    if (intent.kind == kalshi::strategy::IntentKind::Place)
+    {
+      ++places_;
+      risk_.on_sent(intent.order);
+      if (resting.count < resting.orders.size())
+      {
+        resting.orders[resting.count++] = intent.order;
+      }
+      return;
+    }
+    ++cancels_;
+    for (std::uint32_t i = 0; i < resting.count; ++i)
+    {
+      risk_.on_closed(resting.orders[i], resting.orders[i].count);
+    }
+    resting.count = 0;
+  }
+
+  void arm() { stamped_ = false; }
+  [[nodiscard]] bool stamped() const { return stamped_; }
+  [[nodiscard]] std::chrono::steady_clock::time_point first_intent() const { return first_intent_; }
+  [[nodiscard]] std::uint64_t places() const { return places_; }
+  [[nodiscard]] std::uint64_t cancels() const { return cancels_; }
+
+private:
+  struct Resting
+  {
+    std::array<kalshi::trade::OrderSpec, 2> orders{};
+    std::uint32_t count = 0;
+  };
+
+  kalshi::trade::RiskEngine& risk_;
+  std::vector<Resting> resting_;
+  std::chrono::steady_clock::time_point first_intent_;
+  bool stamped_ = false;
+  std::uint64_t places_ = 0;
+  std::uint64_t cancels_ = 0;
+};
+
+using Gate = kalshi::strategy::RiskGate<StubGateway>;
+using Pipeline = kalshi::strategy::StrategyPipeline<kalshi::strategy::MarketMaker, Gate>;
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto count = kalshi::bench::arg_uint(argc, argv, "--messages", 1000000);
+  auto markets = static_cast<std::uint32_t>(kalshi::bench::arg_uint(argc, argv, "--markets", 200));
+  auto iterations = kalshi::bench::arg_uint(argc, argv, "--iterations", 3);
+
+  kalshi::bench::GeneratorOptions generator_options;
+  generator_options.markets = markets;
+  kalshi::bench::MarketDataGenerator generator(generator_options);
+  auto messages = generator.generate(count);
+
+  std::vector<std::int64_t> samples;
+  samples.reserve(messages.size() * iterations);
+  std::int64_t total_ns = 0;
+  std::uint64_t places = 0;
+  std::uint64_t cancels = 0;
+  std::uint64_t rejected = 0;
+  for (std::uint64_t it = 0; it < iterations; ++it)
+  {
+    kalshi::trade::RiskLimits limits;
+    limits.max_position = 1'000'000;
+    limits.max_total_open_orders = 4 * markets;
+    limits.max_total_notional = 1'000'000'000;
+    kalshi::trade::RiskEngine risk(markets, limits);
+    StubGateway gateway(risk, markets);
+    Gate gate(risk, gateway);
+    kalshi::strategy::MarketMaker maker(markets, kalshi::strategy::MarketMakerParams{});
+    Pipeline pipeline(markets, maker, gate);
+    kalshi::md::Dispatcher<Pipeline> dispatcher(pipeline);
+
+    auto run_start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+      gateway.arm();
+      auto start = std::chrono::steady_clock::now();
+      (void)dispatcher.on_message(messages[i]);
+      if (gateway.stamped())
+      {
+        samples.push_back(kalshi::bench::elapsed_ns(start, gateway.first_intent()));
+      }
+    }
+    total_ns += kalshi::bench::elapsed_ns(run_start, std::chrono::steady_clock::now());
+    places += gateway.places();
+    cancels += gateway.cancels();
+    rejected += gate.rejected();
+  }
+
+  auto processed = messages.size() * iterations;
+  std::printf("messages=%zu markets=%u places=%llu cancels=%llu risk_rejects=%llu\n",
+              processed,
+              markets,
+              static_cast<unsigned long long>(places),
+              static_cast<unsigned long long>(cancels),
+              static_cast<unsigned long long>(rejected));
+  std::printf("per_message mean=%.1f ns (%.2f M msg/s), %.1f%% of messages produced intents\n",
+              static_cast<double>(total_ns) / static_cast<double>(processed),
+              static_cast<double>(processed) * 1e3 / static_cast<double>(total_ns),
+              100.0 * static_cast<double>(samples.size()) / static_cast<double>(processed));
+  auto summary = kalshi::bench::summarize(samples);
+  kalshi::bench::print_latency("tick_to_intent", summary);
+  return 0;
+}
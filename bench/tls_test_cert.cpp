@@ -0,0 +1,101 @@
+#include "tls_test_cert.hpp"
+
+#include <memory>
+#include <string>
+
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+namespace kalshi::bench
+{
+
+namespace
+{
+
+using PkeyPtr = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+using X509Ptr = std::unique_ptr<X509, decltype(&X509_free)>;
+
+constexpr unsigned int TEST_KEY_BITS = 2048;
+constexpr long TEST_CERT_VALIDITY_SECONDS = 24L * 60L * 60L;
+
+bool add_san(X509* cert, std::string_view common_name)
+{
+  std::string san = "DNS:";
+  san.append(common_name);
+  san.append(",IP:127.0.0.1");
+
+  X509V3_CTX v3;
+  X509V3_set_ctx_nodb(&v3);
+  X509V3_set_ctx(&v3, cert, cert, nullptr, nullptr, 0);
+  X509_EXTENSION* ext = X509V3_EXT_conf_nid(nullptr, &v3, NID_subject_alt_name, san.c_str());
+  if (!ext)
+  {
+    return false;
+  }
+  bool added = X509_add_ext(cert, ext, -1) == 1;
+  X509_EXTENSION_free(ext);
+  return added;
+}
+
+X509Ptr build_certificate(EVP_PKEY* pkey, std::string_view common_name)
+{
+  X509Ptr cert(X509_new(), &X509_free);
+  if (!cert)
+  {
+    return cert;
+  }
+
+  std::string cn(common_name);
+  X509_NAME* name = X509_get_subject_name(cert.get());
+  bool ok = X509_set_version(cert.get(), 2) == 1 &&
+            ASN1_INTEGER_set(X509_get_serialNumber(cert.get()), 1) == 1 &&
+            X509_gmtime_adj(X509_getm_notBefore(cert.get()), 0) != nullptr &&
+            X509_gmtime_adj(X509_getm_notAfter(cert.get()), TEST_CERT_VALIDITY_SECONDS) !=
+                nullptr &&
+            X509_set_pubkey(cert.get(), pkey) == 1 &&
+            X509_NAME_add_entry_by_txt(name,
+                                       "CN",
+                                       MBSTRING_ASC,
+                                       reinterpret_cast<const unsigned char*>(cn.c_str()),
+                                       -1,
+                                       -1,
+                                       0) == 1 &&
+            X509_set_issuer_name(cert.get(), name) == 1 && add_san(cert.get(), common_name) &&
+            X509_sign(cert.get(), pkey, EVP_sha256()) > 0;
+  if (!ok)
+  {
+    cert.reset();
+  }
+  return cert;
+}
+
+} // namespace
+
+std::expected<void, CertError> use_self_signed_cert(boost::asio::ssl::context& ctx,
+                                                    std::string_view common_name)
+{
+  PkeyPtr pkey(EVP_RSA_gen(TEST_KEY_BITS), &EVP_PKEY_free);
+  if (!pkey)
+  {
+    return std::unexpected(CertError::KeyGenerationFailed);
+  }
+
+  auto cert = build_certificate(pkey.get(), common_name);
+  if (!cert)
+  {
+    return std::unexpected(CertError::CertificateBuildFailed);
+  }
+
+  SSL_CTX* native = ctx.native_handle();
+  if (SSL_CTX_use_certificate(native, cert.get()) != 1 ||
+      SSL_CTX_use_PrivateKey(native, pkey.get()) != 1 || SSL_CTX_check_private_key(native) != 1)
+  {
+    return std::unexpected(CertError::ContextInstallFailed);
+  }
+  return {};
+}
+
+} // namespace kalshi::bench
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <expected>
+#include <string_view>
+
+#include <boost/asio/ssl/context.hpp>
+
+namespace kalshi::bench
+{
+
+/** Errors returned while installing a generated test certificate. */
+enum class CertError
+{
+  KeyGenerationFailed,
+  CertificateBuildFailed,
+  ContextInstallFailed
+};
+
+/**
+ * Generate a throwaway RSA key and self-signed certificate and install both
+ * into a server SSL context. Intended for loopback benchmarks only.
+ * @param ctx Server SSL context.
+ * @param common_name Subject CN and DNS SAN of the certificate.
+ * @return void or CertError.
+ */
+[[nodiscard]] std::expected<void, CertError> use_self_signed_cert(boost::asio::ssl::context& ctx,
+                                                                  std::string_view common_name);
+
+} // namespace kalshi::bench
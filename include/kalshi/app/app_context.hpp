@@ -3,6 +3,7 @@
 #include "kalshi/app/logging_sink.hpp"
 #include "kalshi/core/auth.hpp"
 #include "kalshi/core/config.hpp"
+#include "kalshi/core/rate_limiter.hpp"
 #include "kalshi/core/ws_endpoints.hpp"
 #include "kalshi/logging/async_json_logger.hpp"
 #include "kalshi/logging/log_level.hpp"
@@ -95,13 +96,13 @@ public:
 private:
   AppContext(kalshi::Config config,
              std::unique_ptr<kalshi::logging::AsyncJsonLogger> logger,
-             kalshi::AuthConfig auth,
+             std::shared_ptr<kalshi::AuthSigner> signer,
              std::vector<kalshi::Header> headers,
              kalshi::md::SubscriptionCommand subscription,
              std::string ws_url)
     : config_(std::move(config)),
       logger_(std::move(logger)),
-      auth_(std::move(auth)),
+      signer_(std::move(signer)),
       headers_(std::move(headers)),
       subscription_(std::move(subscription)),
       ws_url_(std::move(ws_url))
@@ -112,14 +113,15 @@ private:
   build_logger_options(const kalshi::Config& config);
 
   [[nodiscard]] static std::expected<std::vector<kalshi::Header>, AppError> build_headers(
-      const kalshi::AuthConfig& auth, kalshi::logging::Logger& logger);
+      kalshi::AuthSigner& signer, kalshi::logging::Logger& logger);
 
   kalshi::Config config_;
   std::unique_ptr<kalshi::logging::AsyncJsonLogger> logger_;
-  kalshi::AuthConfig auth_;
+  std::shared_ptr<kalshi::AuthSigner> signer_;
   std::vector<kalshi::Header> headers_;
   kalshi::md::SubscriptionCommand subscription_;
   std::string ws_url_;
+  kalshi::RateLimiter rate_limiter_{kalshi::RateLimits{}}; // shared by every client on this key
 };
 
 } // namespace kalshi::app
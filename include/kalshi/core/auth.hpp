@@ -1,9 +1,14 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -64,4 +69,162 @@ namespace kalshi
       std::string_view path,
       std::int64_t timestamp_ms);
 
+  /**
+   * RSA-PSS request signer that parses the private key once. A digest
+   * context is prepared with the key, SHA-256 and PSS padding at creation,
+   * and each signature starts from a copy of it, so signing costs only the
+   * RSA operation itself.
+   *
+   * It can also pre-sign the next header set ahead of need: presign() on a
+   * background thread, presigned() on the connect path. A reconnect then
+   * spends no time on key parsing or signing. All members are serialized
+   * internally, so the signer may be shared between threads.
+   */
+  class AuthSigner
+  {
+  public:
+    /**
+     * Load the key and prepare the signing context.
+     * @param auth Auth configuration.
+     * @return Signer or AuthError (see last_sign_error()).
+     */
+    [[nodiscard]] static std::expected<AuthSigner, AuthError> create(const AuthConfig &auth);
+
+    AuthSigner(AuthSigner &&other) noexcept;
+    AuthSigner &operator=(AuthSigner &&other) noexcept;
+    AuthSigner(const AuthSigner &) = delete;
+    AuthSigner &operator=(const AuthSigner &) = delete;
+    ~AuthSigner();
+
+    /**
+     * Sign a message.
+     * @param message Message to sign.
+     * @return Base64-encoded signature or AuthError.
+     */
+    [[nodiscard]] std::expected<std::string, AuthError> sign(std::string_view message);
+
+    /**
+     * Build Kalshi auth headers for a request.
+     * @param method HTTP method ("GET").
+     * @param path Request path used for signing.
+     * @param timestamp_ms Unix timestamp in milliseconds.
+     * @return Header list or AuthError.
+     */
+    [[nodiscard]] std::expected<std::vector<Header>, AuthError> build_headers(
+        std::string_view method,
+        std::string_view path,
+        std::int64_t timestamp_ms);
+
+    /**
+     * Sign a header set now and keep it for presigned().
+     * @param method HTTP method.
+     * @param path Request path.
+     * @param timestamp_ms Unix timestamp in milliseconds.
+     * @return void or AuthError.
+     */
+    [[nodiscard]] std::expected<void, AuthError> presign(std::string_view method,
+                                                         std::string_view path,
+                                                         std::int64_t timestamp_ms);
+
+    /**
+     * Pre-signed header set, if it matches and is fresh enough. The set
+     * stays cached, so a retried connect can use it again.
+     * @param method HTTP method.
+     * @param path Request path.
+     * @param now_ms Current Unix timestamp in milliseconds.
+     * @param max_age_ms Oldest acceptable signature age.
+     * @return Headers, or std::nullopt if none are usable (sign instead).
+     */
+    [[nodiscard]] std::optional<std::vector<Header>> presigned(std::string_view method,
+                                                               std::string_view path,
+                                                               std::int64_t now_ms,
+                                                               std::int64_t max_age_ms) const;
+
+    /**
+     * Like presigned(), but hands the cached headers to fn without copying
+     * them. fn runs under the presign lock and must not call back into the
+     * signer.
+     * @param method HTTP method.
+     * @param path Request path.
+     * @param now_ms Current Unix timestamp in milliseconds.
+     * @param max_age_ms Oldest acceptable signature age.
+     * @param fn Called as fn(const std::vector<Header> &).
+     * @return false if no usable set was cached.
+     */
+    template <typename Fn>
+    bool with_presigned(std::string_view method,
+                        std::string_view path,
+                        std::int64_t now_ms,
+                        std::int64_t max_age_ms,
+                        Fn &&fn) const
+    {
+      std::lock_guard lock(*presigned_mutex_);
+      const auto *entry = find_presigned(method, path);
+      if (entry == nullptr || now_ms - entry->timestamp_ms > max_age_ms)
+      {
+        return false;
+      }
+      fn(entry->headers);
+      return true;
+    }
+
+  private:
+    struct Keys;
+
+    AuthSigner(std::string key_id, std::unique_ptr<Keys> keys);
+
+    std::string key_id_;
+    std::unique_ptr<Keys> keys_;
+    std::unique_ptr<std::mutex> sign_mutex_;
+    std::unique_ptr<std::mutex> presigned_mutex_;
+    struct Presigned
+    {
+      std::string method;
+      std::string path;
+      std::int64_t timestamp_ms;
+      std::vector<Header> headers;
+    };
+
+    const Presigned *find_presigned(std::string_view method, std::string_view path) const;
+
+    std::vector<Presigned> presigned_; // one per method + path
+  };
+
+  /**
+   * Current Unix time in milliseconds, as used for request signing.
+   * @return Milliseconds since the epoch.
+   */
+  [[nodiscard]] std::int64_t unix_time_ms();
+
+  /**
+   * Background thread that keeps a set of requests pre-signed on an
+   * AuthSigner, so the connect and order paths can use presigned() instead
+   * of signing inline. Stops and joins on destruction.
+   */
+  class AuthPresigner
+  {
+  public:
+    /** Request to keep signed. */
+    struct Request
+    {
+      std::string method;
+      std::string path;
+    };
+
+    /**
+     * Start re-signing every interval. The first round is signed
+     * immediately.
+     * @param signer Signer to fill.
+     * @param requests Requests to keep signed.
+     * @param interval Re-sign interval; keep it well under the max age
+     *        readers pass to presigned().
+     */
+    AuthPresigner(std::shared_ptr<AuthSigner> signer,
+                  std::vector<Request> requests,
+                  std::chrono::milliseconds interval);
+
+  private:
+    std::jthread thread_;
+  };
+
 } // namespace kalshi
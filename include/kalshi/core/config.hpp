@@ -31,6 +31,9 @@ namespace kalshi
     bool auto_reconnect;
     std::int64_t reconnect_initial_delay_ms;
     std::int64_t reconnect_max_delay_ms;
+    bool tls_session_resumption;
+    std::int64_t dns_cache_ttl_ms;
+    bool hot_standby;
   };
 
   /** Logging configuration for async logger. */
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace kalshi
+{
+
+  /** Sustained rate and burst of one bucket. */
+  struct RateLimit
+  {
+    std::uint32_t per_second;
+    std::uint32_t burst; // tokens available after an idle period
+  };
+
+  /** Counters of one bucket; each field is read separately, not as a set. */
+  struct RateLimitStats
+  {
+    std::uint64_t granted;    // tokens handed out without waiting
+    std::uint64_t delayed;    // tokens handed out with a wait
+    std::uint64_t throttled;  // requests refused
+    std::chrono::nanoseconds waited; // total wait of the delayed tokens
+  };
+
+  /**
+   * Lock-free token bucket.
+   *
+   * The bucket is stored as a single atomic time rather than a token count:
+   * the time at which it will be full again ("theoretical arrival time").
+   * Taking n tokens pushes that time n intervals forward; the request fits
+   * if the result is no more than burst intervals ahead of now. This is
+   * the same limit as refilling a counter at the sustained rate, but the
+   * refill needs no timer and an acquire is one compare-and-swap, so any
+   * number of threads can share a bucket without a lock.
+   *
+   * Every call takes the current time, so tests can drive a bucket with a
+   * simulated clock; the overloads without one use steady_clock.
+   */
+  class alignas(64) TokenBucket
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Construct a full bucket.
+     * @param limit Rate and burst; per_second must be non-zero.
+     */
+    explicit TokenBucket(RateLimit limit);
+
+    TokenBucket(const TokenBucket &) = delete;
+    TokenBucket &operator=(const TokenBucket &) = delete;
+
+    /**
+     * Take tokens if they are available now.
+     * @param now Current time.
+     * @param tokens Tokens to take.
+     * @return True if taken; false (and counted as throttled) otherwise.
+     */
+    [[nodiscard]] bool try_acquire(Clock::time_point now, std::uint32_t tokens = 1);
+    [[nodiscard]] bool try_acquire(std::uint32_t tokens = 1) { return try_acquire(Clock::now(), tokens); }
+
+    /**
+     * Take tokens that may only become available later. The caller must
+     * wait for the returned delay before using them; the tokens are
+     * committed either way.
+     * @param now Current time.
+     * @param tokens Tokens to take.
+     * @param max_wait Longest acceptable delay.
+     * @return Delay (zero if available now), or std::nullopt (counted as
+     *         throttled, nothing taken) if it would exceed max_wait.
+     */
+    [[nodiscard]] std::optional<std::chrono::nanoseconds> reserve(Clock::time_point now,
+                                                                  std::uint32_t tokens,
+                                                                  std::chrono::nanoseconds max_wait);
+
+    /**
+     * Delay until tokens would be available, without taking them.
+     * @param now Current time.
+     * @param tokens Tokens wanted.
+     * @return Zero if available now.
+     */
+    [[nodiscard]] std::chrono::nanoseconds available_in(Clock::time_point now,
+                                                        std::uint32_t tokens = 1) const;
+
+    /** Counters so far. */
+    [[nodiscard]] RateLimitStats stats() const;
+
+    /** Configured limit. */
+    [[nodiscard]] RateLimit limit() const { return limit_; }
+
+  private:
+    static std::int64_t ticks(Clock::time_point t);
+
+    RateLimit limit_;
+    std::int64_t interval_ns_;  // time to refill one token
+    std::int64_t tolerance_ns_; // burst * interval
+    std::atomic<std::int64_t> full_at_ns_;
+    std::atomic<std::uint64_t> granted_{0};
+    std::atomic<std::uint64_t> delayed_{0};
+    std::atomic<std::uint64_t> throttled_{0};
+    std::atomic<std::int64_t> waited_ns_{0};
+  };
+
+  /** Request classes Kalshi limits separately. */
+  enum class RateLimitEndpoint : std::uint8_t
+  {
+    RestRead,  // REST GETs
+    RestWrite, // order placement and cancels
+    WsCommand, // websocket subscribe/update commands
+    Count_
+  };
+
+  /**
+   * Stable name of an endpoint for logs.
+   * @param endpoint Endpoint.
+   * @return Static string.
+   */
+  [[nodiscard]] const char *to_string(RateLimitEndpoint endpoint);
+
+  /** Limits per endpoint. Defaults match Kalshi's basic API tier. */
+  struct RateLimits
+  {
+    RateLimit rest_read{20, 20};
+    RateLimit rest_write{10, 10};
+    RateLimit ws_command{10, 10};
+  };
+
+  /**
+   * One bucket per endpoint, shared by every client that talks to the
+   * exchange under the same API key. Buckets are fixed at construction and
+   * safe to use from any thread.
+   */
+  class RateLimiter
+  {
+  public:
+    /**
+     * Construct full buckets.
+     * @param limits Limits per endpoint.
+     */
+    explicit RateLimiter(RateLimits limits);
+
+    /**
+     * Bucket of an endpoint.
+     * @param endpoint Endpoint.
+     * @return Bucket, valid for the limiter's lifetime; buckets are
+     *         thread-safe, so a const limiter still hands them out.
+     */
+    [[nodiscard]] TokenBucket &bucket(RateLimitEndpoint endpoint) const
+    {
+      return *buckets_[static_cast<std::size_t>(endpoint)];
+    }
+
+  private:
+    static constexpr std::size_t ENDPOINT_COUNT = static_cast<std::size_t>(RateLimitEndpoint::Count_);
+
+    std::array<std::unique_ptr<TokenBucket>, ENDPOINT_COUNT> buckets_;
+  };
+
+} // namespace kalshi
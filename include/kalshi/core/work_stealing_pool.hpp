@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kalshi
+{
+
+  /**
+   * Fixed pool of worker threads for coarse, independent tasks such as
+   * backtest jobs.
+   *
+   * Each worker has its own deque and takes tasks from its front; when
+   * its deque is empty it steals from the back of the next non-empty one,
+   * so uneven task lengths even out without a shared queue. Tasks
+   * submitted from outside the pool are dealt round-robin onto the backs
+   * of the deques, so each worker runs its share in submission order and
+   * thieves take the last submitted. A task submitted by a worker goes to
+   * the front of that worker's deque, so the worker runs it next while its
+   * data is still warm. Deques
+   * are guarded by their own mutex: tasks are expected to run for
+   * milliseconds or more, so a lock per take costs nothing measurable.
+   *
+   * Tasks must not throw.
+   */
+  class WorkStealingPool
+  {
+  public:
+    using Task = std::function<void()>;
+
+    /**
+     * Start the workers.
+     * @param threads Worker count; 0 uses std::thread::hardware_concurrency().
+     */
+    explicit WorkStealingPool(std::size_t threads);
+
+    /** Wait for every submitted task, then stop the workers. */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /**
+     * Queue a task. Any thread, including a worker.
+     * @param task Task to run.
+     * @return void.
+     */
+    void submit(Task task);
+
+    /**
+     * Block until every task submitted so far has finished. Not from a
+     * worker.
+     * @return void.
+     */
+    void wait();
+
+    /** Worker count. */
+    [[nodiscard]] std::size_t size() const { return threads_.size(); }
+
+    /** Tasks a worker took from another worker's deque. */
+    [[nodiscard]] std::uint64_t steals() const { return steals_.load(std::memory_order_relaxed); }
+
+  private:
+    struct alignas(64) Queue
+    {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    void work(std::size_t self);
+    bool take(std::size_t self, Task &task);
+
+    std::unique_ptr<Queue[]> queues_;
+    std::size_t queue_count_;
+    std::vector<std::thread> threads_;
+
+    std::mutex state_mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::atomic<std::size_t> queued_{0}; // raised under state_mutex_
+    std::size_t unfinished_ = 0;         // guarded by state_mutex_
+    bool stopping_ = false;              // guarded by state_mutex_
+
+    std::atomic<std::size_t> next_queue_{0};
+    std::atomic<std::uint64_t> steals_{0};
+  };
+
+} // namespace kalshi
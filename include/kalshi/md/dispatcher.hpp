@@ -1,9 +1,18 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
+#include <functional>
+#include <span>
 #include <string_view>
+#include <utility>
+#include <vector>
 
+#include "kalshi/md/model/control_events.hpp"
 #include "kalshi/md/model/market_sink.hpp"
+#include "kalshi/md/parse/delta_scanner.hpp"
 #include "kalshi/md/parse/event_parser.hpp"
 #include "kalshi/md/parse/message_parser.hpp"
 #include "kalshi/md/parse/parse_errors.hpp"
@@ -12,15 +21,105 @@
 namespace kalshi::md
 {
 
+  /** Events buffered for a batch sink before it is flushed regardless. */
+  inline constexpr std::size_t DISPATCH_BATCH_MAX = 64;
+
   template <MarketSink Sink>
   /**
    * Dispatches parsed websocket messages to a market sink.
+   *
+   * The message type is classified without allocating and selects a handler
+   * from a table indexed by MessageType, so dispatch is a single indirect
+   * call. Keep one instance per connection: control messages (subscribed,
+   * unsubscribed, ok, error) are decoded into ControlEvents for the control
+   * handler, which owns the connection's sid -> channel mapping
+   * (SubscriptionManager in FeedHandler).
+   *
+   * With the fast delta scan enabled, orderbook_delta messages in the
+   * exchange's compact layout skip the JSON parser entirely; any other
+   * layout falls through to the simdjson path.
+   *
+   * For a BatchMarketSink, consecutive events of the same kind are buffered
+   * and handed over as one span when the kind changes, DISPATCH_BATCH_MAX
+   * is reached or flush() is called (FeedHandler flushes once the frames
+   * already received have been drained). Per-event sinks are called
+   * immediately.
+   *
+   * Fills and order updates from the authenticated channels are not market
+   * data, so they go to optional handlers rather than the sink. Buffered
+   * market events are flushed first, so a handler reading the book sees
+   * every update that arrived before the fill. Without a handler these
+   * messages are reported as UnsupportedType, as before.
    */
   class Dispatcher
   {
   public:
+    using ControlHandler = std::function<void(const ControlEvent &)>;
+    using FillHandler = std::function<void(const FillEvent &)>;
+    using UserOrderHandler = std::function<void(const UserOrderEvent &)>;
+
     explicit Dispatcher(Sink &sink) : sink_(sink) {}
 
+    /**
+     * Set the handler for decoded control messages.
+     * @param handler Callback invoked on the dispatching thread.
+     * @return void.
+     */
+    void set_control_handler(ControlHandler handler) { control_handler_ = std::move(handler); }
+
+    /**
+     * Set the handler for our own fills.
+     * @param handler Callback invoked on the dispatching thread.
+     * @return void.
+     */
+    void set_fill_handler(FillHandler handler) { fill_handler_ = std::move(handler); }
+
+    /**
+     * Set the handler for updates to our own orders.
+     * @param handler Callback invoked on the dispatching thread.
+     * @return void.
+     */
+    void set_user_order_handler(UserOrderHandler handler)
+    {
+      user_order_handler_ = std::move(handler);
+    }
+
+    /**
+     * Enable or disable the orderbook_delta fast path (on by default).
+     * @param enabled Whether to try scan_orderbook_delta first.
+     * @return void.
+     */
+    void set_fast_delta_scan(bool enabled) { fast_delta_scan_ = enabled; }
+
+    /**
+     * Hand buffered events to a batch sink. No-op for per-event sinks.
+     * @return void.
+     */
+    void flush()
+    {
+      if constexpr (BatchMarketSink<Sink>)
+      {
+        switch (pending_)
+        {
+        case PendingKind::None:
+          return;
+        case PendingKind::Snapshots:
+          sink_.on_snapshots(std::span<const OrderbookSnapshot>(snapshots_));
+          snapshots_.clear();
+          break;
+        case PendingKind::Deltas:
+          sink_.on_deltas(std::span<const OrderbookDelta>(deltas_));
+          deltas_.clear();
+          break;
+        case PendingKind::Trades:
+          sink_.on_trades(std::span<const TradeEvent>(trades_));
+          trades_.clear();
+          break;
+        }
+        pending_ = PendingKind::None;
+      }
+    }
+
     /**
      * Parse type and route to the appropriate sink handler.
      * @param json Raw websocket message.
@@ -28,50 +127,195 @@ namespace kalshi::md
      */
     [[nodiscard]] std::expected<void, ParseError> on_message(std::string_view json)
     {
+      static constexpr auto handlers = make_handlers();
+
+      if (fast_delta_scan_)
+      {
+        if (auto delta = scan_orderbook_delta(json))
+        {
+          deliver(std::move(*delta));
+          return {};
+        }
+      }
       auto type = parse_message_type(json);
       if (!type)
       {
         return std::unexpected(type.error());
       }
+      return (this->*handlers[static_cast<std::size_t>(*type)])(json);
+    }
+
+  private:
+    enum class PendingKind : std::uint8_t
+    {
+      None,
+      Snapshots,
+      Deltas,
+      Trades
+    };
+
+    using Handler = std::expected<void, ParseError> (Dispatcher::*)(std::string_view);
+
+    static constexpr std::array<Handler, MESSAGE_TYPE_COUNT> make_handlers()
+    {
+      std::array<Handler, MESSAGE_TYPE_COUNT> table{};
+      table.fill(&Dispatcher::unsupported);
+      table[static_cast<std::size_t>(MessageType::OrderbookSnapshot)] = &Dispatcher::dispatch_snapshot;
+      table[static_cast<std::size_t>(MessageType::OrderbookDelta)] = &Dispatcher::dispatch_delta;
+      table[static_cast<std::size_t>(MessageType::Trade)] = &Dispatcher::dispatch_trade;
+      table[static_cast<std::size_t>(MessageType::Fill)] = &Dispatcher::dispatch_fill;
+      table[static_cast<std::size_t>(MessageType::UserOrder)] = &Dispatcher::dispatch_user_order;
+      table[static_cast<std::size_t>(MessageType::Subscribed)] = &Dispatcher::on_control;
+      table[static_cast<std::size_t>(MessageType::Unsubscribed)] = &Dispatcher::on_control;
+      table[static_cast<std::size_t>(MessageType::UpdateOk)] = &Dispatcher::on_control;
+      table[static_cast<std::size_t>(MessageType::Error)] = &Dispatcher::on_control;
+      return table;
+    }
+
+    std::expected<void, ParseError> unsupported(std::string_view)
+    {
+      return std::unexpected(ParseError::UnsupportedType);
+    }
 
-      if (*type == ORDERBOOK_SNAPSHOT)
+    std::expected<void, ParseError> on_control(std::string_view json)
+    {
+      auto event = parse_control_event(json);
+      if (!event)
       {
-        auto snapshot = parse_orderbook_snapshot(json);
-        if (!snapshot)
-        {
-          return std::unexpected(snapshot.error());
-        }
-        sink_.on_snapshot(*snapshot);
-        return {};
+        return std::unexpected(event.error());
       }
+      if (control_handler_)
+      {
+        control_handler_(*event);
+      }
+      return {};
+    }
 
-      if (*type == ORDERBOOK_DELTA)
+    std::expected<void, ParseError> dispatch_snapshot(std::string_view json)
+    {
+      auto snapshot = parse_orderbook_snapshot(json);
+      if (!snapshot)
       {
-        auto delta = parse_orderbook_delta(json);
-        if (!delta)
-        {
-          return std::unexpected(delta.error());
-        }
-        sink_.on_delta(*delta);
-        return {};
+        return std::unexpected(snapshot.error());
       }
+      deliver(std::move(*snapshot));
+      return {};
+    }
 
-      if (*type == TRADE)
+    std::expected<void, ParseError> dispatch_delta(std::string_view json)
+    {
+      auto delta = parse_orderbook_delta(json);
+      if (!delta)
       {
-        auto trade = parse_trade_event(json);
-        if (!trade)
-        {
-          return std::unexpected(trade.error());
-        }
-        sink_.on_trade(*trade);
-        return {};
+        return std::unexpected(delta.error());
       }
+      deliver(std::move(*delta));
+      return {};
+    }
 
-      return std::unexpected(ParseError::UnsupportedType);
+    std::expected<void, ParseError> dispatch_trade(std::string_view json)
+    {
+      auto trade = parse_trade_event(json);
+      if (!trade)
+      {
+        return std::unexpected(trade.error());
+      }
+      deliver(std::move(*trade));
+      return {};
+    }
+
+    std::expected<void, ParseError> dispatch_fill(std::string_view json)
+    {
+      if (!fill_handler_)
+      {
+        return unsupported(json);
+      }
+      auto fill = parse_fill_event(json);
+      if (!fill)
+      {
+        return std::unexpected(fill.error());
+      }
+      flush();
+      fill_handler_(*fill);
+      return {};
+    }
+
+    std::expected<void, ParseError> dispatch_user_order(std::string_view json)
+    {
+      if (!user_order_handler_)
+      {
+        return unsupported(json);
+      }
+      auto update = parse_user_order_event(json);
+      if (!update)
+      {
+        return std::unexpected(update.error());
+      }
+      flush();
+      user_order_handler_(*update);
+      return {};
+    }
+
+    void deliver(OrderbookSnapshot &&snapshot)
+    {
+      if constexpr (BatchMarketSink<Sink>)
+      {
+        buffer(snapshots_, PendingKind::Snapshots, std::move(snapshot));
+      }
+      else
+      {
+        sink_.on_snapshot(snapshot);
+      }
+    }
+
+    void deliver(OrderbookDelta &&delta)
+    {
+      if constexpr (BatchMarketSink<Sink>)
+      {
+        buffer(deltas_, PendingKind::Deltas, std::move(delta));
+      }
+      else
+      {
+        sink_.on_delta(delta);
+      }
+    }
+
+    void deliver(TradeEvent &&trade)
+    {
+      if constexpr (BatchMarketSink<Sink>)
+      {
+        buffer(trades_, PendingKind::Trades, std::move(trade));
+      }
+      else
+      {
+        sink_.on_trade(trade);
+      }
+    }
+
+    template <typename Event>
+    void buffer(std::vector<Event> &batch, PendingKind kind, Event &&event)
+    {
+      if (pending_ != kind)
+      {
+        flush();
+        pending_ = kind;
+      }
+      batch.push_back(std::move(event));
+      if (batch.size() >= DISPATCH_BATCH_MAX)
+      {
+        flush();
+      }
     }
 
-  private:
     Sink &sink_;
+    ControlHandler control_handler_;
+    FillHandler fill_handler_;
+    UserOrderHandler user_order_handler_;
+    bool fast_delta_scan_ = true;
+    std::vector<OrderbookSnapshot> snapshots_;
+    std::vector<OrderbookDelta> deltas_;
+    std::vector<TradeEvent> trades_;
+    PendingKind pending_ = PendingKind::None;
   };
 
 } // namespace kalshi::md
@@ -2,15 +2,22 @@
 
 #include "kalshi/logging/logger.hpp"
 #include "kalshi/md/dispatcher.hpp"
+#include "kalshi/md/model/market_id.hpp"
 #include "kalshi/md/model/market_sink.hpp"
+#include "kalshi/md/parse/message_parser.hpp"
+#include "kalshi/md/protocol/subscription_manager.hpp"
+#include "kalshi/md/sequence_arbiter.hpp"
+#include "kalshi/md/ws/connection_cache.hpp"
 #include "kalshi/md/ws/ws_client.hpp"
 #include "kalshi/md/ws/ws_constants.hpp"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/steady_timer.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -19,8 +26,10 @@
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -29,7 +38,11 @@ namespace kalshi::md
 
   template <MarketSink Sink>
   /**
-   * Owns websocket connection and dispatches messages to a sink.
+   * Owns websocket connection(s) and dispatches messages to a sink.
+   *
+   * In hot-standby mode two independent connections ("legs") carry the same
+   * subscription and a SequenceArbiter forwards only the first copy of each
+   * message, so a stalled or dropped leg does not leave a gap.
    */
   class FeedHandler
   {
@@ -50,6 +63,14 @@ namespace kalshi::md
       OutputOpenFailed
     };
 
+    /**
+     * Errors returned by the runtime subscription API.
+     */
+    enum class ControlError
+    {
+      NotRunning
+    };
+
     /**
      * Runtime options for websocket run.
      */
@@ -58,7 +79,7 @@ namespace kalshi::md
       std::string ws_url;
       std::vector<kalshi::Header> headers;
       std::function<std::optional<std::vector<kalshi::Header>>()> refresh_headers;
-      std::string subscribe_cmd;
+      SubscribeRequest subscription; // no channels = send nothing on open
       std::string output_path;
       bool include_raw_on_parse_error = true;
       bool log_raw_messages = false;
@@ -69,6 +90,13 @@ namespace kalshi::md
       std::chrono::milliseconds idle_timeout{60000};
       bool keep_alive_pings = true;
       std::size_t max_messages = 0; // 0 = unlimited
+      bool tls_session_resumption = true;
+      std::chrono::milliseconds dns_cache_ttl{60000}; // 0 = resolve on every connect
+      bool hot_standby = false;                        // redundant connection + arbitration
+      bool fast_delta_scan = true;                     // see scan_orderbook_delta
+      std::function<void(const FillEvent &)> on_fill{}; // fill channel; IO thread
+      std::function<void(const UserOrderEvent &)> on_user_order{}; // user_orders channel; IO thread
+      kalshi::TokenBucket *command_rate_limit = nullptr; // paces outbound commands; nullptr = none
     };
 
     /**
@@ -92,11 +120,89 @@ namespace kalshi::md
       auto state = std::move(*state_result);
       state.ioc = &ioc;
       state.ssl_ctx = &ssl_ctx;
-      connect_client(state);
+      state.connection_cache = std::make_shared<ConnectionCache>(
+          ioc, state.options.dns_cache_ttl, state.options.tls_session_resumption);
+      for (auto &leg : state.legs)
+      {
+        leg.dispatcher.emplace(sink_);
+        leg.dispatcher->set_fast_delta_scan(state.options.fast_delta_scan);
+        leg.dispatcher->set_control_handler(
+            [this, &state, index = leg.index](const ControlEvent &event) {
+              on_control_event(state, state.legs[index], event);
+            });
+        if (state.options.on_fill)
+        {
+          leg.dispatcher->set_fill_handler(state.options.on_fill);
+        }
+        if (state.options.on_user_order)
+        {
+          leg.dispatcher->set_user_order_handler(state.options.on_user_order);
+        }
+        connect_client(state, leg);
+      }
+      state_ = &state;
+      ioc_.store(&ioc);
       ioc.run();
+      for (auto &leg : state.legs)
+      {
+        leg.dispatcher->flush();
+      }
+      ioc_.store(nullptr);
+      state_ = nullptr;
+      if (state.arbiter)
+      {
+        log_arbiter_summary(state);
+      }
       return {};
     }
 
+    /**
+     * Add markets to a channel on the live connection(s), subscribing the
+     * channel if it is new. Safe to call from any thread while run() is
+     * active; the change is applied on the IO thread and kept across
+     * reconnects. An update any connection rejects is logged and applied
+     * to none of them.
+     * @param channel Channel name.
+     * @param market_tickers Markets to add (empty on a new channel = all).
+     * @return std::expected<void, ControlError>.
+     */
+    [[nodiscard]] std::expected<void, ControlError> add_markets(
+        std::string channel, std::vector<std::string> market_tickers)
+    {
+      return post_update([channel = std::move(channel), market_tickers = std::move(market_tickers)](
+                             SubscriptionManager &subscriptions) {
+        return subscriptions.add_markets(channel, market_tickers);
+      });
+    }
+
+    /**
+     * Remove markets from a channel; removing the last one unsubscribes it.
+     * Same threading rules as add_markets().
+     * @param channel Channel name.
+     * @param market_tickers Markets to remove.
+     * @return std::expected<void, ControlError>.
+     */
+    [[nodiscard]] std::expected<void, ControlError> remove_markets(
+        std::string channel, std::vector<std::string> market_tickers)
+    {
+      return post_update([channel = std::move(channel), market_tickers = std::move(market_tickers)](
+                             SubscriptionManager &subscriptions) {
+        return subscriptions.remove_markets(channel, market_tickers);
+      });
+    }
+
+    /**
+     * Unsubscribe a channel. Same threading rules as add_markets().
+     * @param channel Channel name.
+     * @return std::expected<void, ControlError>.
+     */
+    [[nodiscard]] std::expected<void, ControlError> remove_channel(std::string channel)
+    {
+      return post_update([channel = std::move(channel)](SubscriptionManager &subscriptions) {
+        return subscriptions.remove_channel(channel);
+      });
+    }
+
   private:
     struct ReconnectState
     {
@@ -124,17 +230,35 @@ namespace kalshi::md
       }
     };
 
+    struct Leg
+    {
+      std::size_t index = 0;
+      bool up = false;
+      std::shared_ptr<WsClient> client;
+      std::shared_ptr<boost::asio::steady_timer> reconnect_timer;
+      ReconnectState reconnect;
+      std::optional<std::chrono::steady_clock::time_point> reconnect_started;
+      std::chrono::steady_clock::time_point reconnect_opened;
+      SubscriptionManager subscriptions;
+      std::optional<Dispatcher<Sink>> dispatcher;
+      // Arbiter stream of each sid subscribed on this connection; sids are
+      // per connection, streams are shared by all legs.
+      std::unordered_map<std::uint64_t, std::uint32_t> streams;
+    };
+
     struct RunState
     {
       RunOptions options;
       std::shared_ptr<std::ofstream> out;
       std::size_t remaining = 0;
       std::size_t seen = 0;
-      std::shared_ptr<WsClient> client;
-      std::shared_ptr<boost::asio::steady_timer> reconnect_timer;
-      ReconnectState reconnect;
+      std::vector<Leg> legs; // sized once; callbacks hold indices into it
+      std::optional<SequenceArbiter> arbiter;
+      MarketIdTable stream_ids;   // channel name -> arbiter stream
+      std::uint64_t unrouted = 0; // arbitrated messages on a sid no leg subscription owns
       boost::asio::io_context *ioc = nullptr;
       boost::asio::ssl::context *ssl_ctx = nullptr;
+      std::shared_ptr<ConnectionCache> connection_cache;
     };
 
     [[nodiscard]] std::expected<RunState, RunError> init_state(RunOptions options)
@@ -160,36 +284,55 @@ namespace kalshi::md
       auto reconnect = ReconnectState(options.auto_reconnect,
                                       options.reconnect_initial_delay,
                                       options.reconnect_max_delay);
+      auto leg_count = options.hot_standby ? HOT_STANDBY_LEGS : std::size_t{1};
+      std::vector<Leg> legs(leg_count);
+      for (std::size_t i = 0; i < leg_count; ++i)
+      {
+        legs[i].index = i;
+        legs[i].reconnect = reconnect;
+        legs[i].subscriptions = SubscriptionManager(options.subscription);
+      }
+      std::optional<SequenceArbiter> arbiter;
+      if (leg_count > 1)
+      {
+        arbiter.emplace(leg_count);
+      }
       RunState state{.options = std::move(options),
                      .out = std::move(out),
                      .remaining = remaining,
                      .seen = 0,
-                     .client = nullptr,
-                     .reconnect_timer = nullptr,
-                     .reconnect = reconnect,
+                     .legs = std::move(legs),
+                     .arbiter = std::move(arbiter),
+                     .stream_ids = {},
+                     .unrouted = 0,
                      .ioc = nullptr,
-                     .ssl_ctx = nullptr};
+                     .ssl_ctx = nullptr,
+                     .connection_cache = nullptr};
       return state;
     }
 
-    void connect_client(RunState &state)
+    void connect_client(RunState &state, Leg &leg)
     {
-      state.client = std::make_shared<WsClient>(*state.ioc, *state.ssl_ctx);
-      configure_callbacks(*state.client, *state.ioc, state);
-      state.client->connect(state.options.ws_url, state.options.headers);
+      leg.client = std::make_shared<WsClient>(*state.ioc, *state.ssl_ctx);
+      leg.client->set_connection_cache(state.connection_cache.get());
+      leg.client->set_rate_limit(state.options.command_rate_limit);
+      configure_callbacks(*leg.client, *state.ioc, state, leg.index);
+      leg.client->connect(state.options.ws_url, state.options.headers);
     }
 
     void configure_callbacks(WsClient &client,
                              boost::asio::io_context &ioc,
-                             RunState &state)
+                             RunState &state,
+                             std::size_t leg)
     {
-      client.set_open_callback([this, &state]() mutable { on_open(state); });
-      client.set_message_callback([this, &ioc, &state](std::string msg) {
-        on_message(ioc, state, std::move(msg));
+      client.set_open_callback([this, &state, leg]() mutable { on_open(state.legs[leg]); });
+      client.set_message_callback([this, &ioc, &state, leg](std::string msg) {
+        on_message(ioc, state, state.legs[leg], std::move(msg));
       });
-      client.set_error_callback([this, &ioc, &state](WsError err, std::string_view msg) {
-        on_error(ioc, state, err, msg);
+      client.set_error_callback([this, &ioc, &state, leg](WsError err, std::string_view msg) {
+        on_error(ioc, state, state.legs[leg], err, msg);
       });
+      client.set_read_idle_callback([&state, leg]() { state.legs[leg].dispatcher->flush(); });
       client.set_control_callback([this](boost::beast::websocket::frame_type kind,
                                          std::string_view payload) {
         on_control(kind, payload);
@@ -200,20 +343,152 @@ namespace kalshi::md
           state.options.keep_alive_pings);
     }
 
-    void on_open(RunState &state)
+    void on_open(Leg &leg)
+    {
+      kalshi::logging::LogFields fields;
+      fields.add_uint("leg", static_cast<std::uint64_t>(leg.index));
+      logger_.log(kalshi::logging::LogLevel::Info, "md.ws_client", "ws_open",
+                  std::move(fields));
+      leg.up = true;
+      leg.reconnect.reset();
+      leg.reconnect_opened = std::chrono::steady_clock::now();
+      send_commands(leg, leg.subscriptions.on_connected());
+    }
+
+    void send_commands(Leg &leg, const std::vector<std::string> &commands)
+    {
+      for (const auto &command : commands)
+      {
+        auto sent = leg.client->send_text(command);
+        if (!sent)
+        {
+          log(kalshi::logging::LogLevel::Error, "md.ws_client", "subscribe_enqueue_failed");
+        }
+      }
+    }
+
+    template <typename Update>
+    std::expected<void, ControlError> post_update(Update update)
     {
-      log(kalshi::logging::LogLevel::Info, "md.ws_client", "ws_open");
-      state.reconnect.reset();
-      if (!state.options.subscribe_cmd.empty())
+      auto *ioc = ioc_.load();
+      if (!ioc)
       {
-        state.client->send_text(state.options.subscribe_cmd);
+        return std::unexpected(ControlError::NotRunning);
+      }
+      boost::asio::post(*ioc, [this, update = std::move(update)]() {
+        if (!state_)
+        {
+          return;
+        }
+        // Apply to copies first: the legs' desired sets can differ (a
+        // rejected subscribe drops a channel on one leg only), and an update
+        // one leg rejects must not be applied to the others.
+        auto &legs = state_->legs;
+        std::vector<SubscriptionManager> staged;
+        std::vector<std::vector<std::string>> commands;
+        staged.reserve(legs.size());
+        commands.reserve(legs.size());
+        for (auto &leg : legs)
+        {
+          staged.push_back(leg.subscriptions);
+          auto leg_commands = update(staged.back());
+          if (!leg_commands)
+          {
+            kalshi::logging::LogFields fields;
+            fields.add_uint("leg", static_cast<std::uint64_t>(leg.index));
+            fields.add_int("error", static_cast<std::int64_t>(leg_commands.error()));
+            logger_.log(kalshi::logging::LogLevel::Error, "md.feed_handler",
+                        "subscription_update_rejected", std::move(fields));
+            return;
+          }
+          commands.push_back(std::move(*leg_commands));
+        }
+        for (std::size_t i = 0; i < legs.size(); ++i)
+        {
+          legs[i].subscriptions = std::move(staged[i]);
+          if (legs[i].up)
+          {
+            send_commands(legs[i], commands[i]);
+          }
+        }
+      });
+      return {};
+    }
+
+    void on_control_event(RunState &state, Leg &leg, const ControlEvent &event)
+    {
+      kalshi::logging::LogFields fields;
+      fields.add_uint("leg", static_cast<std::uint64_t>(leg.index));
+      if (const auto *subscribed = std::get_if<SubscribedEvent>(&event))
+      {
+        fields.add_string("channel", subscribed->channel);
+        fields.add_uint("sid", subscribed->sid);
+        logger_.log(kalshi::logging::LogLevel::Info, "md.feed_handler", "subscribed",
+                    std::move(fields));
+        if (state.arbiter)
+        {
+          leg.streams[subscribed->sid] = state.stream_ids.intern(subscribed->channel);
+        }
+        send_commands(leg, leg.subscriptions.on_subscribed(subscribed->channel, subscribed->sid));
+      }
+      else if (const auto *error = std::get_if<CommandErrorEvent>(&event))
+      {
+        fields.add_int("id", error->id.value_or(-1));
+        fields.add_int("code", error->code);
+        fields.add_string("message", error->message);
+        if (error->id)
+        {
+          fields.add_string_list("rejected_channels",
+                                 leg.subscriptions.on_command_failed(*error->id));
+        }
+        logger_.log(kalshi::logging::LogLevel::Error, "md.feed_handler", "subscription_error",
+                    std::move(fields));
+      }
+      else if (const auto *unsubscribed = std::get_if<UnsubscribedEvent>(&event))
+      {
+        fields.add_uint("sid", unsubscribed->sid);
+        if (auto stream = leg.streams.find(unsubscribed->sid); stream != leg.streams.end())
+        {
+          state.arbiter->reset_stream(leg.index, stream->second);
+          leg.streams.erase(stream);
+        }
+        logger_.log(kalshi::logging::LogLevel::Info, "md.feed_handler", "unsubscribed",
+                    std::move(fields));
+      }
+      else if (const auto *updated = std::get_if<UpdateOkEvent>(&event))
+      {
+        fields.add_uint("sid", updated->sid.value_or(0));
+        fields.add_uint("market_count", static_cast<std::uint64_t>(updated->market_tickers.size()));
+        logger_.log(kalshi::logging::LogLevel::Debug, "md.feed_handler", "subscription_updated",
+                    std::move(fields));
       }
     }
 
     void on_message(boost::asio::io_context &ioc,
                     RunState &state,
+                    Leg &leg,
                     std::string msg)
     {
+      if (leg.reconnect_started)
+      {
+        log_reconnect_metric(leg);
+      }
+      if (state.arbiter)
+      {
+        if (!arbitrate(state, leg, msg))
+        {
+          return;
+        }
+        // Legs batch independently; keep the merged stream in order.
+        for (auto &other : state.legs)
+        {
+          if (other.index != leg.index)
+          {
+            other.dispatcher->flush();
+          }
+        }
+      }
+
       (*state.out) << msg << "\n";
       state.out->flush();
 
@@ -232,7 +507,7 @@ namespace kalshi::md
       }
       ++state.seen;
 
-      auto dispatched = dispatch_message(msg, state.options.include_raw_on_parse_error);
+      auto dispatched = dispatch_message(leg, msg, state.options.include_raw_on_parse_error);
       if (!dispatched && dispatched.error() == ParseError::UnsupportedType)
       {
         log(kalshi::logging::LogLevel::Debug, "md.dispatcher", "unsupported_message_type");
@@ -244,7 +519,14 @@ namespace kalshi::md
         if (state.remaining == 0)
         {
           log(kalshi::logging::LogLevel::Info, "md.feed_handler", "max_messages_reached");
-          state.client->close();
+          for (auto &other : state.legs)
+          {
+            other.dispatcher->flush();
+            if (other.client)
+            {
+              other.client->close();
+            }
+          }
           ioc.stop();
         }
       }
@@ -252,20 +534,69 @@ namespace kalshi::md
 
     void on_error(boost::asio::io_context &ioc,
                   RunState &state,
+                  Leg &leg,
                   WsError err,
                   std::string_view msg)
     {
       kalshi::logging::LogFields fields;
       fields.add_int("code", static_cast<std::int64_t>(err));
       fields.add_string("message", std::string(msg));
+      fields.add_uint("leg", static_cast<std::uint64_t>(leg.index));
       logger_.log(kalshi::logging::LogLevel::Error, "md.ws_client", "ws_error",
                   std::move(fields));
-      if (!state.reconnect.enabled)
+      leg.up = false;
+      leg.subscriptions.on_disconnected();
+      leg.dispatcher->flush();
+      if (state.arbiter)
+      {
+        state.arbiter->on_leg_down(leg.index);
+        leg.streams.clear();
+      }
+      if (!leg.reconnect.enabled)
       {
-        ioc.stop();
+        auto any_up = std::any_of(state.legs.begin(), state.legs.end(),
+                                  [](const Leg &other) { return other.up; });
+        if (!any_up)
+        {
+          ioc.stop();
+        }
         return;
       }
-      schedule_reconnect(ioc, state);
+      schedule_reconnect(ioc, state, leg);
+    }
+
+    /**
+     * Run a message through the arbiter, keyed by the channel its sid
+     * belongs to on this leg. Control replies (subscribed, unsubscribed,
+     * ok, error) are per leg, not sequenced, and always pass, as do
+     * messages without a sid. Data on a sid the leg has no subscription
+     * for (still in flight after an unsubscribe) is dropped.
+     */
+    bool arbitrate(RunState &state, const Leg &leg, std::string_view msg)
+    {
+      auto header = parse_sequence_header(msg);
+      if (!header)
+      {
+        return true;
+      }
+      switch (header->type)
+      {
+      case MessageType::Subscribed:
+      case MessageType::Unsubscribed:
+      case MessageType::UpdateOk:
+      case MessageType::Error:
+        return true;
+      default:
+        break;
+      }
+      auto stream = leg.streams.find(header->sid);
+      if (stream == leg.streams.end())
+      {
+        ++state.unrouted;
+        return false;
+      }
+      return state.arbiter->accept(leg.index, stream->second, header->seq,
+                                   message_fingerprint(msg));
     }
 
     void on_control(boost::beast::websocket::frame_type kind,
@@ -282,47 +613,103 @@ namespace kalshi::md
                   std::move(fields));
     }
 
-    void schedule_reconnect(boost::asio::io_context &ioc, RunState &state)
+    void schedule_reconnect(boost::asio::io_context &ioc, RunState &state, Leg &leg)
     {
-      if (!state.reconnect_timer)
+      if (!leg.reconnect_timer)
       {
-        state.reconnect_timer = std::make_shared<boost::asio::steady_timer>(ioc);
+        leg.reconnect_timer = std::make_shared<boost::asio::steady_timer>(ioc);
       }
-      auto delay = state.reconnect.next_delay();
+      auto delay = leg.reconnect.next_delay();
 
       kalshi::logging::LogFields fields;
       fields.add_int("delay_ms", static_cast<std::int64_t>(delay.count()));
+      fields.add_uint("leg", static_cast<std::uint64_t>(leg.index));
       logger_.log(kalshi::logging::LogLevel::Warn, "md.ws_client",
                   "reconnect_scheduled", std::move(fields));
 
-      state.reconnect_timer->expires_after(delay);
-      state.reconnect_timer->async_wait([this, &state](const boost::system::error_code &ec) {
-        if (ec)
-        {
-          return;
-        }
-        if (state.options.refresh_headers)
-        {
-          auto refreshed = state.options.refresh_headers();
-          if (refreshed)
-          {
-            state.options.headers = std::move(*refreshed);
-          }
-          else
-          {
-            log(kalshi::logging::LogLevel::Error, "md.ws_client",
-                "refresh_headers_failed");
-          }
-        }
-        connect_client(state);
-      });
+      // Sign the next header set shortly before the reconnect fires so the
+      // connect itself does no key work and the timestamp is still fresh.
+      auto presign_at = delay > PRESIGN_LEAD ? delay - PRESIGN_LEAD : std::chrono::milliseconds{0};
+      leg.reconnect_timer->expires_after(presign_at);
+      leg.reconnect_timer->async_wait(
+          [this, &state, &leg, remaining = delay - presign_at](const boost::system::error_code &ec) {
+            if (ec)
+            {
+              return;
+            }
+            refresh_headers(state);
+            leg.reconnect_timer->expires_after(remaining);
+            leg.reconnect_timer->async_wait([this, &state, &leg](const boost::system::error_code &wait_ec) {
+              if (wait_ec)
+              {
+                return;
+              }
+              leg.reconnect_started = std::chrono::steady_clock::now();
+              connect_client(state, leg);
+            });
+          });
+    }
+
+    void refresh_headers(RunState &state)
+    {
+      if (!state.options.refresh_headers)
+      {
+        return;
+      }
+      auto refreshed = state.options.refresh_headers();
+      if (refreshed)
+      {
+        state.options.headers = std::move(*refreshed);
+      }
+      else
+      {
+        log(kalshi::logging::LogLevel::Error, "md.ws_client",
+            "refresh_headers_failed");
+      }
+    }
+
+    void log_reconnect_metric(Leg &leg)
+    {
+      auto now = std::chrono::steady_clock::now();
+      auto started = *leg.reconnect_started;
+      leg.reconnect_started.reset();
+
+      kalshi::logging::LogFields fields;
+      fields.add_int("reconnect_to_first_message_us",
+                     std::chrono::duration_cast<std::chrono::microseconds>(now - started).count());
+      fields.add_int("reconnect_to_open_us",
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         leg.reconnect_opened - started)
+                         .count());
+      fields.add_bool("tls_resumed", leg.client->session_resumed());
+      fields.add_bool("dns_cached", leg.client->used_cached_endpoints());
+      fields.add_uint("leg", static_cast<std::uint64_t>(leg.index));
+      logger_.log(kalshi::logging::LogLevel::Info, "md.feed_handler",
+                  "reconnect_first_message", std::move(fields));
+    }
+
+    void log_arbiter_summary(const RunState &state)
+    {
+      const auto &arbiter = *state.arbiter;
+      kalshi::logging::LogFields fields;
+      fields.add_uint("delivered", arbiter.delivered());
+      fields.add_uint("duplicates", arbiter.duplicates());
+      fields.add_uint("unaligned_drops", arbiter.unaligned_drops());
+      fields.add_uint("epoch_restarts", arbiter.epoch_restarts());
+      fields.add_uint("unrouted", state.unrouted);
+      for (const auto &leg : state.legs)
+      {
+        fields.add_uint("wins_leg" + std::to_string(leg.index), arbiter.wins(leg.index));
+      }
+      logger_.log(kalshi::logging::LogLevel::Info, "md.feed_handler",
+                  "hot_standby_summary", std::move(fields));
     }
 
-    std::expected<void, ParseError> dispatch_message(std::string_view msg,
+    std::expected<void, ParseError> dispatch_message(Leg &leg,
+                                                     std::string_view msg,
                                                      bool include_raw_on_parse_error)
     {
-      Dispatcher<Sink> dispatcher(sink_);
-      auto dispatched = dispatcher.on_message(msg);
+      auto dispatched = leg.dispatcher->on_message(msg);
       if (!dispatched && dispatched.error() != ParseError::UnsupportedType)
       {
         log_parse_error(dispatched.error(), msg, include_raw_on_parse_error);
@@ -355,6 +742,8 @@ namespace kalshi::md
 
     Sink &sink_;
     kalshi::logging::Logger &logger_;
+    std::atomic<boost::asio::io_context *> ioc_{nullptr};
+    RunState *state_ = nullptr; // IO thread only
   };
 
 } // namespace kalshi::md
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/order_book.hpp"
+#include "kalshi/md/model/seqlock.hpp"
+
+namespace kalshi::md
+{
+
+  /** Levels per side in a DepthView. */
+  inline constexpr std::size_t BOOK_VIEW_DEPTH = 10;
+
+  /** Best level per side. Empty sides have size 0. */
+  struct TopOfBook
+  {
+    Sequence sequence;
+    std::int64_t ts_ns;
+    Price yes_price;
+    Size yes_size;
+    Price no_price;
+    Size no_size;
+  };
+
+  /** Best BOOK_VIEW_DEPTH levels per side, best first. */
+  struct DepthView
+  {
+    Sequence sequence;
+    std::uint32_t yes_count;
+    std::uint32_t no_count;
+    std::array<PriceLevel, BOOK_VIEW_DEPTH> yes;
+    std::array<PriceLevel, BOOK_VIEW_DEPTH> no;
+  };
+
+  /**
+   * Market sink that keeps a seqlocked top of book and depth view per
+   * market, so other threads (risk, UI, strategy workers) can read
+   * consistent book state while the IO thread updates it.
+   *
+   * The feed thread owns the books and is the only writer. It never blocks:
+   * a write bumps the view's version, stores the value, and bumps it again.
+   * A reader copies the value and retries if the version moved (see
+   * Seqlock). The top of book is rewritten on every book event. The depth
+   * view is updated in place and rewritten only when a visible level
+   * changes. Market slots are preallocated, so their addresses stay fixed
+   * while readers hold ids. Events for markets beyond the capacity are
+   * dropped and counted.
+   *
+   * Thread model: on_* on the feed thread. market_count(), ticker(), top()
+   * and depth() on any thread. Resolve tickers on a reader thread with a
+   * BookViewIndex.
+   */
+  class BookViews
+  {
+  public:
+    /**
+     * Construct with a fixed number of market slots.
+     * @param market_capacity Market slots.
+     */
+    explicit BookViews(std::uint32_t market_capacity);
+
+    /**
+     * Replace a market's book.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const OrderbookSnapshot &s);
+
+    /**
+     * Apply a delta to a market's book.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const OrderbookDelta &d);
+
+    /** Trades do not change the book. */
+    void on_trade(const TradeEvent &) {}
+
+    /** Status does not change the book. */
+    void on_status(const MarketStatusUpdate &) {}
+
+    /** Markets with a slot; ids below this are valid. Any thread. */
+    [[nodiscard]] std::uint32_t market_count() const
+    {
+      return market_count_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Ticker of a market. Any thread.
+     * @param id Market id below market_count().
+     * @return Ticker.
+     */
+    [[nodiscard]] const std::string &ticker(MarketId id) const { return slots_[id].ticker; }
+
+    /**
+     * Consistent top of book, retrying torn reads. Any thread.
+     * @param id Market id below market_count().
+     * @return Top of book.
+     */
+    [[nodiscard]] TopOfBook top(MarketId id) const { return slots_[id].top.read(); }
+
+    /**
+     * Consistent depth view, retrying torn reads. Any thread.
+     * @param id Market id below market_count().
+     * @return Depth view.
+     */
+    [[nodiscard]] DepthView depth(MarketId id) const { return slots_[id].depth.read(); }
+
+    /**
+     * Top of book seqlock, for readers that bound their retries with
+     * try_read(). Any thread.
+     * @param id Market id below market_count().
+     * @return Seqlock reference.
+     */
+    [[nodiscard]] const Seqlock<TopOfBook> &top_lock(MarketId id) const { return slots_[id].top; }
+
+    /**
+     * Depth view seqlock. Any thread.
+     * @param id Market id below market_count().
+     * @return Seqlock reference.
+     */
+    [[nodiscard]] const Seqlock<DepthView> &depth_lock(MarketId id) const
+    {
+      return slots_[id].depth;
+    }
+
+    /** Events dropped because their market could not get a slot. Feed thread. */
+    [[nodiscard]] std::uint64_t dropped() const { return dropped_; }
+
+  private:
+    struct alignas(64) Slot
+    {
+      std::string ticker;
+      // Feed thread only: the book and the last published values.
+      OrderBook book;
+      TopOfBook current_top{};
+      DepthView current_depth{};
+      alignas(64) Seqlock<TopOfBook> top;
+      alignas(64) Seqlock<DepthView> depth;
+    };
+
+    std::optional<MarketId> market(std::string_view market_ticker);
+    static bool update(const OrderBook &book, BookSide side, Price price, Size size, DepthView &view);
+    static void collect(const OrderBook &book, BookSide side, DepthView &view);
+    static void publish(Slot &slot, Sequence sequence, std::int64_t ts_ns, bool depth_changed);
+
+    std::uint32_t market_capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::uint32_t> market_count_{0};
+    MarketIdTable ids_; // feed thread only
+    std::uint64_t dropped_ = 0;
+  };
+
+  /**
+   * Ticker lookup for one reader thread. It keeps a private copy of the
+   * BookViews ids and catches up on new markets when a lookup misses.
+   */
+  class BookViewIndex
+  {
+  public:
+    /**
+     * Construct for a BookViews instance.
+     * @param views Views to resolve against.
+     */
+    explicit BookViewIndex(const BookViews &views) : views_(views) {}
+
+    /**
+     * Id of a market by ticker.
+     * @param market_ticker Market ticker.
+     * @return Id or std::nullopt if the feed has not seen the market.
+     */
+    [[nodiscard]] std::optional<MarketId> find(std::string_view market_ticker);
+
+  private:
+    const BookViews &views_;
+    MarketIdTable ids_;
+  };
+
+} // namespace kalshi::md
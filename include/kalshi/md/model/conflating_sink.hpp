@@ -0,0 +1,331 @@
+#pragma once
+
+#include <bitset>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/order_book.hpp"
+
+namespace kalshi::md
+{
+
+  /** Events between clock reads when a ConflatingSink checks its cadence. */
+  inline constexpr std::uint32_t CONFLATE_CLOCK_STRIDE = 64;
+
+  /** Everything that changed on one market since the previous publish. */
+  struct ConflatedUpdate
+  {
+    MarketId market;
+    std::string_view market_ticker;
+    /** The book was replaced: yes/no list every non-empty level. */
+    bool snapshot;
+    /** Changed levels with their current size (0 = level removed). */
+    std::span<const PriceLevel> yes;
+    std::span<const PriceLevel> no;
+    /** Merged book after all folded events. */
+    const OrderBook &book;
+    /** Deltas folded into this update. */
+    std::uint32_t deltas;
+    /** Trades since the previous publish; last_trade is the latest. */
+    std::uint32_t trades;
+    const TradeEvent *last_trade;
+    std::optional<MarketStatus> status;
+  };
+
+  /** Concept for consumers of conflated book state. */
+  template <typename Consumer>
+  concept ConflatedConsumer = requires(Consumer c, const ConflatedUpdate &update) {
+    { c.on_conflated(update) } -> std::same_as<void>;
+  };
+
+  /**
+   * Sink for slow consumers (UI, risk snapshots, logging) that do not need
+   * every delta.
+   *
+   * Events are applied to a dense book per market and only mark the touched
+   * price level in a dirty bit set; nothing is forwarded on the hot path.
+   * publish() hands the consumer one ConflatedUpdate per dirty market, so
+   * its work per publish is bounded by markets x levels regardless of the
+   * message rate. With a non-zero interval, publish happens automatically
+   * once the interval has passed; the clock is read every
+   * CONFLATE_CLOCK_STRIDE events and once per batch, so on a quiet feed
+   * call publish_if_due() from a timer. The consumer runs on the calling
+   * (feed) thread. Not thread-safe.
+   * @tparam Consumer Consumer type.
+   */
+  template <ConflatedConsumer Consumer>
+  class ConflatingSink
+  {
+  public:
+    /**
+     * Construct a conflating sink.
+     * @param consumer Consumer to publish to.
+     * @param interval Automatic publish cadence (zero = on demand only).
+     */
+    ConflatingSink(Consumer &consumer, std::chrono::nanoseconds interval)
+        : consumer_(consumer), interval_(interval), last_publish_(std::chrono::steady_clock::now())
+    {
+      yes_scratch_.reserve(PriceLevels::CAPACITY);
+      no_scratch_.reserve(PriceLevels::CAPACITY);
+    }
+
+    /**
+     * Replace a market's book.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const OrderbookSnapshot &s)
+    {
+      fold(s);
+      tick();
+    }
+
+    /**
+     * Fold a delta into its market's book.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const OrderbookDelta &d)
+    {
+      fold(d);
+      tick();
+    }
+
+    /**
+     * Count a trade and keep it as the market's latest.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const TradeEvent &t)
+    {
+      fold(t);
+      tick();
+    }
+
+    /**
+     * Keep the market's latest status.
+     * @param u Market status update.
+     * @return void.
+     */
+    void on_status(const MarketStatusUpdate &u)
+    {
+      auto &market = state(u.market_ticker);
+      market.status = u.status;
+      mark(market);
+      tick();
+    }
+
+    /**
+     * Replace books from a snapshot batch.
+     * @param s Snapshots in arrival order.
+     * @return void.
+     */
+    void on_snapshots(std::span<const OrderbookSnapshot> s)
+    {
+      for (const auto &snapshot : s)
+      {
+        fold(snapshot);
+      }
+      publish_if_due();
+    }
+
+    /**
+     * Fold a delta batch.
+     * @param d Deltas in arrival order.
+     * @return void.
+     */
+    void on_deltas(std::span<const OrderbookDelta> d)
+    {
+      for (const auto &delta : d)
+      {
+        fold(delta);
+      }
+      publish_if_due();
+    }
+
+    /**
+     * Fold a trade batch.
+     * @param t Trades in arrival order.
+     * @return void.
+     */
+    void on_trades(std::span<const TradeEvent> t)
+    {
+      for (const auto &trade : t)
+      {
+        fold(trade);
+      }
+      publish_if_due();
+    }
+
+    /**
+     * Publish every dirty market now and clear the dirty state.
+     * @return Number of markets published.
+     */
+    std::size_t publish()
+    {
+      auto published = dirty_.size();
+      for (auto id : dirty_)
+      {
+        emit(id, markets_[id]);
+      }
+      dirty_.clear();
+      last_publish_ = std::chrono::steady_clock::now();
+      return published;
+    }
+
+    /**
+     * Publish if the interval has passed since the last publish.
+     * @return Number of markets published.
+     */
+    std::size_t publish_if_due()
+    {
+      since_clock_check_ = 0;
+      if (interval_.count() == 0 || dirty_.empty() ||
+          std::chrono::steady_clock::now() - last_publish_ < interval_)
+      {
+        return 0;
+      }
+      return publish();
+    }
+
+    /** Markets with unpublished changes. */
+    [[nodiscard]] std::size_t pending_markets() const { return dirty_.size(); }
+
+    /**
+     * Merged book for a market (includes unpublished changes).
+     * @param market_ticker Market ticker.
+     * @return Book or nullptr if the market has not been seen.
+     */
+    [[nodiscard]] const OrderBook *book(std::string_view market_ticker) const
+    {
+      auto id = ids_.find(market_ticker);
+      return id ? &markets_[*id].book : nullptr;
+    }
+
+  private:
+    struct MarketState
+    {
+      MarketId id = 0;
+      OrderBook book;
+      std::bitset<PRICE_MAX + 1> yes_dirty;
+      std::bitset<PRICE_MAX + 1> no_dirty;
+      bool dirty = false;
+      bool snapshot = false;
+      std::uint32_t deltas = 0;
+      std::uint32_t trades = 0;
+      std::optional<TradeEvent> last_trade;
+      std::optional<MarketStatus> status;
+    };
+
+    MarketState &state(std::string_view market_ticker)
+    {
+      auto id = ids_.intern(market_ticker);
+      if (id >= markets_.size())
+      {
+        markets_.resize(id + 1);
+        markets_[id].id = id;
+      }
+      return markets_[id];
+    }
+
+    void mark(MarketState &market)
+    {
+      if (!market.dirty)
+      {
+        market.dirty = true;
+        dirty_.push_back(market.id);
+      }
+    }
+
+    void fold(const OrderbookSnapshot &s)
+    {
+      auto &market = state(s.market_ticker);
+      market.book.apply(s);
+      market.snapshot = true;
+      mark(market);
+    }
+
+    void fold(const OrderbookDelta &d)
+    {
+      auto &market = state(d.market_ticker);
+      market.book.apply(d);
+      (d.side == BookSide::Yes ? market.yes_dirty : market.no_dirty).set(d.price);
+      ++market.deltas;
+      mark(market);
+    }
+
+    void fold(const TradeEvent &t)
+    {
+      auto &market = state(t.market_ticker);
+      market.last_trade = t;
+      ++market.trades;
+      mark(market);
+    }
+
+    void tick()
+    {
+      if (++since_clock_check_ >= CONFLATE_CLOCK_STRIDE)
+      {
+        publish_if_due();
+      }
+    }
+
+    void collect(std::vector<PriceLevel> &out,
+                 const OrderBook::Levels &levels,
+                 const std::bitset<PRICE_MAX + 1> &dirty,
+                 bool snapshot)
+    {
+      out.clear();
+      for (std::size_t price = 0; price < levels.size(); ++price)
+      {
+        if (snapshot ? levels[price] != 0 : dirty.test(price))
+        {
+          out.push_back(PriceLevel{static_cast<Price>(price), levels[price]});
+        }
+      }
+    }
+
+    void emit(MarketId id, MarketState &market)
+    {
+      collect(yes_scratch_, market.book.levels(BookSide::Yes), market.yes_dirty, market.snapshot);
+      collect(no_scratch_, market.book.levels(BookSide::No), market.no_dirty, market.snapshot);
+      consumer_.on_conflated(ConflatedUpdate{
+          .market = id,
+          .market_ticker = ids_.ticker(id),
+          .snapshot = market.snapshot,
+          .yes = yes_scratch_,
+          .no = no_scratch_,
+          .book = market.book,
+          .deltas = market.deltas,
+          .trades = market.trades,
+          .last_trade = market.trades > 0 ? &*market.last_trade : nullptr,
+          .status = market.status});
+      market.yes_dirty.reset();
+      market.no_dirty.reset();
+      market.dirty = false;
+      market.snapshot = false;
+      market.deltas = 0;
+      market.trades = 0;
+      market.status.reset();
+    }
+
+    Consumer &consumer_;
+    std::chrono::nanoseconds interval_;
+    std::chrono::steady_clock::time_point last_publish_;
+    std::uint32_t since_clock_check_ = 0;
+    MarketIdTable ids_;
+    std::vector<MarketState> markets_; // by MarketId
+    std::vector<MarketId> dirty_;      // publish order = first change order
+    std::vector<PriceLevel> yes_scratch_;
+    std::vector<PriceLevel> no_scratch_;
+  };
+
+} // namespace kalshi::md
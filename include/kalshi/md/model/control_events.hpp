@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace kalshi::md
+{
+
+  /** Reply to a subscribe command: one per channel. */
+  struct SubscribedEvent
+  {
+    std::optional<std::int64_t> id;
+    std::string channel;
+    std::uint64_t sid;
+  };
+
+  /** Reply to an unsubscribe command. */
+  struct UnsubscribedEvent
+  {
+    std::optional<std::int64_t> id;
+    std::uint64_t sid;
+  };
+
+  /** Reply to an update_subscription command. */
+  struct UpdateOkEvent
+  {
+    std::optional<std::int64_t> id;
+    std::optional<std::uint64_t> sid;
+    std::vector<std::string> market_tickers;
+  };
+
+  /** Command rejected by the exchange. */
+  struct CommandErrorEvent
+  {
+    std::optional<std::int64_t> id;
+    std::int64_t code;
+    std::string message;
+  };
+
+  /** Any control message decoded by the dispatcher. */
+  using ControlEvent =
+      std::variant<SubscribedEvent, UnsubscribedEvent, UpdateOkEvent, CommandErrorEvent>;
+
+} // namespace kalshi::md
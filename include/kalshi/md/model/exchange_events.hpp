@@ -1,8 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <optional>
 #include <string>
-#include <vector>
 
 #include "kalshi/md/model/types.hpp"
 
@@ -16,13 +17,75 @@ namespace kalshi::md
     Size size;
   };
 
+  /**
+   * Price levels for one side of a snapshot, stored inline. A side holds at
+   * most one level per price, so PRICE_MAX + 1 slots always suffice and
+   * filling a snapshot never allocates. Levels keep the order they were
+   * received in.
+   */
+  class PriceLevels
+  {
+  public:
+    static constexpr std::size_t CAPACITY = PRICE_MAX + 1;
+
+    /**
+     * Append a level.
+     * @param level Level to append.
+     * @return false if the side is already full.
+     */
+    bool push_back(PriceLevel level)
+    {
+      if (size_ == CAPACITY)
+      {
+        return false;
+      }
+      levels_[size_++] = level;
+      return true;
+    }
+
+    /** Remove all levels. */
+    void clear()
+    {
+      size_ = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+      return size_;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    [[nodiscard]] const PriceLevel &operator[](std::size_t i) const
+    {
+      return levels_[i];
+    }
+
+    [[nodiscard]] const PriceLevel *begin() const
+    {
+      return levels_.data();
+    }
+
+    [[nodiscard]] const PriceLevel *end() const
+    {
+      return levels_.data() + size_;
+    }
+
+  private:
+    std::array<PriceLevel, CAPACITY> levels_{};
+    std::size_t size_ = 0;
+  };
+
   /** Full orderbook snapshot. */
   struct OrderbookSnapshot
   {
     MarketTicker market_ticker;
     Sequence sequence;
-    std::vector<PriceLevel> yes;
-    std::vector<PriceLevel> no;
+    PriceLevels yes;
+    PriceLevels no;
     Timestamp ts;
   };
 
@@ -57,4 +120,42 @@ namespace kalshi::md
     Timestamp ts;
   };
 
+  /** One of our own orders executing, from the authenticated fill channel. */
+  struct FillEvent
+  {
+    MarketTicker market_ticker;
+    std::string trade_id;
+    std::string order_id;
+    std::optional<std::string> client_order_id;
+    BookSide side;
+    OrderAction action;
+    Price yes_price; // execution price in YES cents, whatever the side
+    Count count;
+    bool is_taker;
+    Timestamp ts;
+  };
+
+  /** Exchange-side status of one of our orders. */
+  enum class UserOrderStatus
+  {
+    Resting,
+    Canceled,
+    Executed,
+    Pending
+  };
+
+  /** Change to one of our orders, from the user_orders channel. */
+  struct UserOrderEvent
+  {
+    MarketTicker market_ticker;
+    std::string order_id;
+    std::optional<std::string> client_order_id;
+    UserOrderStatus status;
+    BookSide side;
+    Price yes_price;
+    Count fill_count;
+    Count remaining_count;
+    Timestamp ts;
+  };
+
 } // namespace kalshi::md
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace kalshi::md
+{
+
+  /** Dense id for an interned ticker, usable as a flat-table index. */
+  using MarketId = std::uint32_t;
+
+  /**
+   * Event ticker a market belongs to: everything before the last '-'
+   * (FED-23DEC-T3.00 -> FED-23DEC). Tickers without a '-' are their own
+   * event.
+   * @param market_ticker Market ticker.
+   * @return Event ticker view into market_ticker.
+   */
+  [[nodiscard]] std::string_view event_ticker(std::string_view market_ticker);
+
+  /**
+   * Interns tickers into dense ids assigned in first-seen order. Ids are
+   * never reused, so per-id state can live in plain vectors. Not
+   * thread-safe.
+   */
+  class MarketIdTable
+  {
+  public:
+    /**
+     * Id for a ticker, assigning the next id if it is new.
+     * @param ticker Ticker.
+     * @return MarketId.
+     */
+    MarketId intern(std::string_view ticker);
+
+    /**
+     * Id for a ticker without interning it.
+     * @param ticker Ticker.
+     * @return MarketId or std::nullopt if never interned.
+     */
+    [[nodiscard]] std::optional<MarketId> find(std::string_view ticker) const;
+
+    /**
+     * Ticker for an id.
+     * @param id Id returned by intern().
+     * @return Ticker.
+     */
+    [[nodiscard]] const std::string &ticker(MarketId id) const { return tickers_[id]; }
+
+    /** Number of interned tickers (one past the largest id). */
+    [[nodiscard]] std::size_t size() const { return tickers_.size(); }
+
+  private:
+    struct TickerHash
+    {
+      using is_transparent = void;
+      std::size_t operator()(std::string_view ticker) const
+      {
+        return std::hash<std::string_view>{}(ticker);
+      }
+    };
+
+    std::unordered_map<std::string, MarketId, TickerHash, std::equal_to<>> ids_;
+    std::vector<std::string> tickers_;
+  };
+
+} // namespace kalshi::md
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/market_sink.hpp"
+#include "kalshi/md/model/order_book.hpp"
+
+namespace kalshi::md
+{
+
+  /** Most levels per side MarketSignals can sum for book imbalance. */
+  inline constexpr std::uint32_t SIGNAL_MAX_DEPTH = 10;
+  /** Longest volatility window, in mid changes. */
+  inline constexpr std::uint32_t SIGNAL_VOL_CAPACITY = 256;
+  /** Longest trade-flow window, in trades. */
+  inline constexpr std::uint32_t SIGNAL_FLOW_CAPACITY = 256;
+
+  /** Sizing and windows of MarketSignals. Out-of-range values are clamped. */
+  struct SignalOptions
+  {
+    std::uint32_t market_capacity = 4096;
+    std::uint32_t depth_levels = 5;  // levels per side in the book imbalance, 1..SIGNAL_MAX_DEPTH
+    double mid_alpha = 0.05;         // EWMA weight of the mid after each book event, (0, 1]
+    std::uint32_t short_window = 32; // mid changes in the short volatility window, 1..long_window
+    std::uint32_t long_window = 256; // mid changes in the long one, 1..SIGNAL_VOL_CAPACITY
+    std::uint32_t flow_window = 64;  // trades in the flow window, 1..SIGNAL_FLOW_CAPACITY
+  };
+
+  /**
+   * Signals of one market. Prices are YES cents. mid, ewma_mid and
+   * microprice are NaN until both sides of the book have been non-empty.
+   */
+  struct MarketSignal
+  {
+    double mid;              // (best YES bid + best YES ask) / 2
+    double ewma_mid;         // exponentially weighted mid, per book event
+    double microprice;       // touch prices weighted by the opposite side's size
+    double book_imbalance;   // (bid depth - ask depth) / total over the top levels, in [-1, 1]
+    double flow_imbalance;   // (buy - sell taker contracts) / total over the flow window, in [-1, 1]
+    double short_volatility; // sqrt of the summed squared mid changes over the short window, cents
+    double long_volatility;  // same over the long window
+  };
+
+  /**
+   * Market sink that keeps microstructure signals per market, updated on
+   * every snapshot, delta and trade:
+   *
+   * - mid and its EWMA, stepped once per book event (tick time, since
+   *   captured deltas do not always carry a timestamp)
+   * - microprice: (bid * ask_size + ask * bid_size) / (bid_size + ask_size)
+   * - book imbalance over the best depth_levels levels per side
+   * - trade-flow imbalance over the last flow_window trades, signed by
+   *   taker side (a YES taker buys, a NO taker sells)
+   * - realized volatility over the last short_window and long_window mid
+   *   changes
+   *
+   * YES bids are the YES side of the book and YES asks are 100 minus the
+   * NO side's bids, so bid depth is the YES side and ask depth the NO side.
+   *
+   * Every update is O(1) with memory fixed at construction:
+   * - a bitmap of non-empty prices per side gives the best price with a
+   *   count-leading-zeros; the top-level depth sum is adjusted in place
+   *   while the set of top levels is unchanged and rebuilt from the bitmap
+   *   (at most depth_levels steps) when a level inside it appears or
+   *   empties
+   * - volatility and flow windows are rings with running integer sums of
+   *   squared mid changes (in half cents) and signed trade sizes, so they
+   *   never drift
+   *
+   * The signals are stored as one array per signal indexed by market id,
+   * so scans over many markets (mid(), book_imbalance(), ...) read
+   * contiguous doubles. Book and window state is kept per market, since
+   * an update touches one market. Market ids are interned in first-seen
+   * order; events for markets beyond the capacity are dropped and
+   * counted. Single-threaded.
+   */
+  class MarketSignals
+  {
+  public:
+    /**
+     * Construct with fixed capacity and windows.
+     * @param options Sizing and windows.
+     */
+    explicit MarketSignals(SignalOptions options);
+
+    /**
+     * Rebuild a market's book and refresh its book signals. The change in
+     * mid across a snapshot is not counted as a mid change.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const OrderbookSnapshot &s);
+
+    /**
+     * Apply a delta and refresh the market's book signals.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const OrderbookDelta &d);
+
+    /**
+     * Add a trade to the market's flow window.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const TradeEvent &t);
+
+    /** Status does not change the signals. */
+    void on_status(const MarketStatusUpdate &) {}
+
+    /** Markets with a slot; ids below this are valid. */
+    [[nodiscard]] std::uint32_t market_count() const
+    {
+      return static_cast<std::uint32_t>(ids_.size());
+    }
+
+    /**
+     * Id of a market.
+     * @param market_ticker Market ticker.
+     * @return Id or std::nullopt if no event for the market was kept.
+     */
+    [[nodiscard]] std::optional<MarketId> find(std::string_view market_ticker) const
+    {
+      return ids_.find(market_ticker);
+    }
+
+    /**
+     * Ticker of a market.
+     * @param id Market id below market_count().
+     * @return Ticker.
+     */
+    [[nodiscard]] const std::string &ticker(MarketId id) const { return ids_.ticker(id); }
+
+    /**
+     * All signals of one market.
+     * @param id Market id below market_count().
+     * @return Signals.
+     */
+    [[nodiscard]] MarketSignal signal(MarketId id) const;
+
+    /** Mid per market, indexed by id. */
+    [[nodiscard]] std::span<const double> mid() const { return column(mid_); }
+
+    /** EWMA mid per market. */
+    [[nodiscard]] std::span<const double> ewma_mid() const { return column(ewma_mid_); }
+
+    /** Microprice per market. */
+    [[nodiscard]] std::span<const double> microprice() const { return column(microprice_); }
+
+    /** Book imbalance per market. */
+    [[nodiscard]] std::span<const double> book_imbalance() const { return column(book_imbalance_); }
+
+    /** Trade-flow imbalance per market. */
+    [[nodiscard]] std::span<const double> flow_imbalance() const { return column(flow_imbalance_); }
+
+    /** Short-window volatility per market. */
+    [[nodiscard]] std::span<const double> short_volatility() const { return column(short_volatility_); }
+
+    /** Long-window volatility per market. */
+    [[nodiscard]] std::span<const double> long_volatility() const { return column(long_volatility_); }
+
+    /** Events dropped because their market could not get a slot. */
+    [[nodiscard]] std::uint64_t dropped() const { return dropped_; }
+
+  private:
+    /** Book and window state of one market. */
+    struct State
+    {
+      std::array<OrderBook::Levels, 2> levels; // by BookSide, then price
+      std::array<std::array<std::uint64_t, 2>, 2> occupied; // bit p set while levels[side][p] != 0
+      std::array<std::uint64_t, 2> depth;      // size in the top levels
+      std::array<Price, 2> floor;              // lowest price counted in depth; 0 while short of levels
+      std::int32_t mid2;                       // bid + ask in cents, -1 while one-sided
+      std::uint32_t vol_head;
+      std::uint32_t vol_count;
+      std::uint32_t flow_head;
+      std::uint32_t flow_count;
+      std::uint64_t short_sum;                 // squared mid2 changes in the short window
+      std::uint64_t long_sum;
+      std::int64_t flow_net;                   // buy minus sell contracts in the flow window
+      std::uint64_t flow_total;
+    };
+
+    std::optional<MarketId> market(std::string_view market_ticker);
+    void rebuild_depth(State &state, std::size_t side) const;
+    void refresh(MarketId id, State &state, bool count_change);
+    void push_change(MarketId id, State &state, std::int32_t change);
+    std::span<const double> column(const std::unique_ptr<double[]> &values) const
+    {
+      return {values.get(), market_count()};
+    }
+
+    SignalOptions options_;
+    MarketIdTable ids_;
+    std::unique_ptr<State[]> states_;
+    std::unique_ptr<std::int16_t[]> changes_; // long_window mid2 changes per market, ring
+    std::unique_ptr<std::int32_t[]> flows_;   // flow_window signed trade sizes per market, ring
+    std::unique_ptr<double[]> mid_;
+    std::unique_ptr<double[]> ewma_mid_;
+    std::unique_ptr<double[]> microprice_;
+    std::unique_ptr<double[]> book_imbalance_;
+    std::unique_ptr<double[]> flow_imbalance_;
+    std::unique_ptr<double[]> short_volatility_;
+    std::unique_ptr<double[]> long_volatility_;
+    std::uint64_t dropped_ = 0;
+  };
+
+  static_assert(MarketSink<MarketSignals>);
+
+} // namespace kalshi::md
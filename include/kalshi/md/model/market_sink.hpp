@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <span>
 #include <tuple>
 
 #include "kalshi/md/model/exchange_events.hpp"
@@ -21,6 +22,88 @@ namespace kalshi::md
     { s.on_status(status) } -> std::same_as<void>;
   };
 
+  /**
+   * Sink that can also take runs of same-kind events in one call, so it can
+   * amortize book lookups and cache misses over a burst. Batches never span
+   * event kinds, so interleaving with per-event calls preserves order.
+   */
+  template <typename Sink>
+  concept BatchMarketSink = MarketSink<Sink> &&
+                            requires(Sink s,
+                                     std::span<const OrderbookSnapshot> snaps,
+                                     std::span<const OrderbookDelta> deltas,
+                                     std::span<const TradeEvent> trades) {
+                              { s.on_snapshots(snaps) } -> std::same_as<void>;
+                              { s.on_deltas(deltas) } -> std::same_as<void>;
+                              { s.on_trades(trades) } -> std::same_as<void>;
+                            };
+
+  /**
+   * Deliver snapshots as one batch, or one call each for per-event sinks.
+   * @param sink Destination sink.
+   * @param snapshots Snapshots in arrival order.
+   * @return void.
+   */
+  template <MarketSink Sink>
+  void deliver_snapshots(Sink &sink, std::span<const OrderbookSnapshot> snapshots)
+  {
+    if constexpr (BatchMarketSink<Sink>)
+    {
+      sink.on_snapshots(snapshots);
+    }
+    else
+    {
+      for (const auto &snapshot : snapshots)
+      {
+        sink.on_snapshot(snapshot);
+      }
+    }
+  }
+
+  /**
+   * Deliver deltas as one batch, or one call each for per-event sinks.
+   * @param sink Destination sink.
+   * @param deltas Deltas in arrival order.
+   * @return void.
+   */
+  template <MarketSink Sink>
+  void deliver_deltas(Sink &sink, std::span<const OrderbookDelta> deltas)
+  {
+    if constexpr (BatchMarketSink<Sink>)
+    {
+      sink.on_deltas(deltas);
+    }
+    else
+    {
+      for (const auto &delta : deltas)
+      {
+        sink.on_delta(delta);
+      }
+    }
+  }
+
+  /**
+   * Deliver trades as one batch, or one call each for per-event sinks.
+   * @param sink Destination sink.
+   * @param trades Trades in arrival order.
+   * @return void.
+   */
+  template <MarketSink Sink>
+  void deliver_trades(Sink &sink, std::span<const TradeEvent> trades)
+  {
+    if constexpr (BatchMarketSink<Sink>)
+    {
+      sink.on_trades(trades);
+    }
+    else
+    {
+      for (const auto &trade : trades)
+      {
+        sink.on_trade(trade);
+      }
+    }
+  }
+
   /**
    * Fan-out sink to broadcast events to multiple sinks.
    * @tparam Sinks Sink types.
@@ -79,6 +162,39 @@ namespace kalshi::md
                  { (sink.on_status(u), ...); }, sinks_);
     }
 
+    /**
+     * Pass a snapshot batch to each sink (per event for non-batch sinks).
+     * @param s Snapshots in arrival order.
+     * @return void.
+     */
+    void on_snapshots(std::span<const OrderbookSnapshot> s)
+    {
+      std::apply([&](auto &...sink)
+                 { (deliver_snapshots(sink, s), ...); }, sinks_);
+    }
+
+    /**
+     * Pass a delta batch to each sink (per event for non-batch sinks).
+     * @param d Deltas in arrival order.
+     * @return void.
+     */
+    void on_deltas(std::span<const OrderbookDelta> d)
+    {
+      std::apply([&](auto &...sink)
+                 { (deliver_deltas(sink, d), ...); }, sinks_);
+    }
+
+    /**
+     * Pass a trade batch to each sink (per event for non-batch sinks).
+     * @param t Trades in arrival order.
+     * @return void.
+     */
+    void on_trades(std::span<const TradeEvent> t)
+    {
+      std::apply([&](auto &...sink)
+                 { (deliver_trades(sink, t), ...); }, sinks_);
+    }
+
   private:
     std::tuple<Sinks &...> sinks_;
   };
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "kalshi/md/model/exchange_events.hpp"
+
+namespace kalshi::md
+{
+
+  /**
+   * Dense per-market book: one aggregate size per price and side. Kalshi
+   * books are bids on both sides, so the best price on a side is the
+   * highest price with a non-zero size.
+   */
+  class OrderBook
+  {
+  public:
+    using Levels = std::array<Size, PRICE_MAX + 1>;
+
+    /**
+     * Replace the book with a snapshot.
+     * @param snapshot Orderbook snapshot.
+     * @return void.
+     */
+    void apply(const OrderbookSnapshot &snapshot)
+    {
+      yes_.fill(0);
+      no_.fill(0);
+      for (const auto &level : snapshot.yes)
+      {
+        yes_[level.price] = level.size;
+      }
+      for (const auto &level : snapshot.no)
+      {
+        no_[level.price] = level.size;
+      }
+      sequence_ = snapshot.sequence;
+    }
+
+    /**
+     * Apply a delta. A delta that would take a level below zero clears it.
+     * @param delta Orderbook delta.
+     * @return Size at the level afterwards.
+     */
+    Size apply(const OrderbookDelta &delta)
+    {
+      sequence_ = delta.sequence;
+      return add(delta.side, delta.price, delta.delta);
+    }
+
+    /**
+     * Change the size at a level, clearing it rather than going below zero.
+     * @param side Book side.
+     * @param price Price in cents.
+     * @param delta Size change.
+     * @return Size at the level afterwards.
+     */
+    Size add(BookSide side, Price price, std::int64_t delta)
+    {
+      auto &level = (side == BookSide::Yes ? yes_ : no_)[price];
+      auto updated = static_cast<std::int64_t>(level) + delta;
+      level = updated > 0 ? static_cast<Size>(updated) : Size{0};
+      return level;
+    }
+
+    /**
+     * Set the size at a level.
+     * @param side Book side.
+     * @param price Price in cents.
+     * @param size New size.
+     * @return void.
+     */
+    void set(BookSide side, Price price, Size size)
+    {
+      (side == BookSide::Yes ? yes_ : no_)[price] = size;
+    }
+
+    /**
+     * Empty both sides and reset the sequence.
+     * @return void.
+     */
+    void clear()
+    {
+      yes_.fill(0);
+      no_.fill(0);
+      sequence_ = 0;
+    }
+
+    /**
+     * Size resting at a price.
+     * @param side Book side.
+     * @param price Price in cents.
+     * @return Aggregate size.
+     */
+    [[nodiscard]] Size size(BookSide side, Price price) const { return levels(side)[price]; }
+
+    /**
+     * Highest price with resting size.
+     * @param side Book side.
+     * @return Best price or std::nullopt if the side is empty.
+     */
+    [[nodiscard]] std::optional<Price> best(BookSide side) const
+    {
+      const auto &side_levels = levels(side);
+      for (auto price = static_cast<int>(PRICE_MAX); price >= 0; --price)
+      {
+        if (side_levels[static_cast<std::size_t>(price)] != 0)
+        {
+          return static_cast<Price>(price);
+        }
+      }
+      return std::nullopt;
+    }
+
+    /** Sequence of the last snapshot or delta applied. */
+    [[nodiscard]] Sequence sequence() const { return sequence_; }
+
+    /** All levels on a side, indexed by price. */
+    [[nodiscard]] const Levels &levels(BookSide side) const
+    {
+      return side == BookSide::Yes ? yes_ : no_;
+    }
+
+  private:
+    Levels yes_{};
+    Levels no_{};
+    Sequence sequence_ = 0;
+  };
+
+} // namespace kalshi::md
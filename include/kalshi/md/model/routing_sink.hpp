@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/market_sink.hpp"
+
+namespace kalshi::md
+{
+
+  /**
+   * Sink that forwards each event only to the sinks registered for its
+   * market, for the market's event (ticker prefix), or for all markets.
+   *
+   * Registration folds into one sink bitmask per interned MarketId, so an
+   * event costs one ticker lookup plus one flat-table read, and adding sinks
+   * adds one bit test each rather than another per-event filter. Batches are
+   * split into runs of events with the same mask and forwarded as
+   * sub-spans. Registration is expected to be rare; it rebuilds the masks.
+   * Not thread-safe: register on the dispatching thread or before it runs.
+   * @tparam Sinks Sink types (at most 64); sink I is addressed as route_*<I>.
+   */
+  template <MarketSink... Sinks>
+  class RoutingSink
+  {
+    static_assert(sizeof...(Sinks) <= 64, "RoutingSink masks hold at most 64 sinks");
+
+  public:
+    using Mask = std::uint64_t;
+
+    /**
+     * Construct a routing sink from references. Nothing is routed until a
+     * route_* call registers a sink.
+     * @param sinks Sink references.
+     */
+    explicit RoutingSink(Sinks &...sinks) : sinks_(sinks...) {}
+
+    /**
+     * Route every market to sink I.
+     * @return void.
+     */
+    template <std::size_t I>
+    void route_all()
+    {
+      all_mask_ |= bit<I>();
+      rebuild();
+    }
+
+    /**
+     * Route one market to sink I.
+     * @param market_ticker Market ticker.
+     * @return void.
+     */
+    template <std::size_t I>
+    void route_market(std::string_view market_ticker)
+    {
+      auto id = intern(market_ticker);
+      market_bits_[id] |= bit<I>();
+      masks_[id] = mask_of(id);
+    }
+
+    /**
+     * Route every market of an event, including ones not seen yet, to sink I.
+     * @param event Event ticker (see event_ticker()).
+     * @return void.
+     */
+    template <std::size_t I>
+    void route_event(std::string_view event)
+    {
+      auto id = events_.intern(event);
+      if (id >= event_bits_.size())
+      {
+        event_bits_.resize(id + 1, 0);
+      }
+      event_bits_[id] |= bit<I>();
+      rebuild();
+    }
+
+    /**
+     * Sinks an event on this market is forwarded to.
+     * @param market_ticker Market ticker.
+     * @return Bit I set for each routed sink I.
+     */
+    [[nodiscard]] Mask mask(std::string_view market_ticker)
+    {
+      return masks_[intern(market_ticker)];
+    }
+
+    /** Interned market tickers. */
+    [[nodiscard]] const MarketIdTable &markets() const { return markets_; }
+
+    /**
+     * Forward snapshot to routed sinks.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const OrderbookSnapshot &s)
+    {
+      for_each_routed(mask(s.market_ticker), [&](auto &sink) { sink.on_snapshot(s); });
+    }
+
+    /**
+     * Forward delta to routed sinks.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const OrderbookDelta &d)
+    {
+      for_each_routed(mask(d.market_ticker), [&](auto &sink) { sink.on_delta(d); });
+    }
+
+    /**
+     * Forward trade to routed sinks.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const TradeEvent &t)
+    {
+      for_each_routed(mask(t.market_ticker), [&](auto &sink) { sink.on_trade(t); });
+    }
+
+    /**
+     * Forward status update to routed sinks.
+     * @param u Market status update.
+     * @return void.
+     */
+    void on_status(const MarketStatusUpdate &u)
+    {
+      for_each_routed(mask(u.market_ticker), [&](auto &sink) { sink.on_status(u); });
+    }
+
+    /**
+     * Forward snapshot runs to routed sinks.
+     * @param s Snapshots in arrival order.
+     * @return void.
+     */
+    void on_snapshots(std::span<const OrderbookSnapshot> s)
+    {
+      route_runs(s, [](auto &sink, std::span<const OrderbookSnapshot> run)
+                 { deliver_snapshots(sink, run); });
+    }
+
+    /**
+     * Forward delta runs to routed sinks.
+     * @param d Deltas in arrival order.
+     * @return void.
+     */
+    void on_deltas(std::span<const OrderbookDelta> d)
+    {
+      route_runs(d, [](auto &sink, std::span<const OrderbookDelta> run)
+                 { deliver_deltas(sink, run); });
+    }
+
+    /**
+     * Forward trade runs to routed sinks.
+     * @param t Trades in arrival order.
+     * @return void.
+     */
+    void on_trades(std::span<const TradeEvent> t)
+    {
+      route_runs(t, [](auto &sink, std::span<const TradeEvent> run)
+                 { deliver_trades(sink, run); });
+    }
+
+  private:
+    template <std::size_t I>
+    static constexpr Mask bit()
+    {
+      static_assert(I < sizeof...(Sinks), "sink index out of range");
+      return Mask{1} << I;
+    }
+
+    MarketId intern(std::string_view market_ticker)
+    {
+      auto id = markets_.intern(market_ticker);
+      if (id >= masks_.size())
+      {
+        // First sighting: resolve its event once and cache the mask.
+        market_bits_.resize(id + 1, 0);
+        market_event_.resize(id + 1, events_.intern(event_ticker(market_ticker)));
+        masks_.resize(id + 1, 0);
+        masks_[id] = mask_of(id);
+      }
+      return id;
+    }
+
+    Mask mask_of(MarketId id) const
+    {
+      auto event = market_event_[id];
+      auto event_mask = event < event_bits_.size() ? event_bits_[event] : Mask{0};
+      return all_mask_ | event_mask | market_bits_[id];
+    }
+
+    void rebuild()
+    {
+      for (MarketId id = 0; id < masks_.size(); ++id)
+      {
+        masks_[id] = mask_of(id);
+      }
+    }
+
+    template <typename Fn>
+    void for_each_routed(Mask mask, Fn &&fn)
+    {
+      [&]<std::size_t... I>(std::index_sequence<I...>)
+      {
+        ((mask & (Mask{1} << I) ? fn(std::get<I>(sinks_)) : void()), ...);
+      }(std::index_sequence_for<Sinks...>{});
+    }
+
+    template <typename Event, typename Deliver>
+    void route_runs(std::span<const Event> events, Deliver deliver)
+    {
+      std::size_t begin = 0;
+      Mask run_mask = 0;
+      for (std::size_t i = 0; i < events.size(); ++i)
+      {
+        auto event_mask = mask(events[i].market_ticker);
+        if (i != begin && event_mask != run_mask)
+        {
+          for_each_routed(run_mask, [&](auto &sink)
+                          { deliver(sink, events.subspan(begin, i - begin)); });
+          begin = i;
+        }
+        run_mask = event_mask;
+      }
+      if (begin < events.size())
+      {
+        for_each_routed(run_mask, [&](auto &sink)
+                        { deliver(sink, events.subspan(begin)); });
+      }
+    }
+
+    std::tuple<Sinks &...> sinks_;
+    MarketIdTable markets_;
+    MarketIdTable events_;
+    std::vector<Mask> masks_;            // by MarketId: effective routing
+    std::vector<Mask> market_bits_;      // by MarketId: route_market
+    std::vector<MarketId> market_event_; // by MarketId: event id
+    std::vector<Mask> event_bits_;       // by event id: route_event
+    Mask all_mask_ = 0;
+  };
+
+} // namespace kalshi::md
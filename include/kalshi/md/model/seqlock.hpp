@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace kalshi::md
+{
+
+  /** Spin-wait hint for retry loops. */
+  inline void cpu_relax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+
+  /**
+   * Trivially copyable value held in relaxed atomic words, so a reader may
+   * copy it while the writer stores without a data race. The copy itself can
+   * be torn; callers detect that with a version check (see Seqlock). Holds no
+   * pointers and only lock-free words, so it can live in shared memory.
+   * @tparam T Value type.
+   */
+  template <typename T>
+  class AtomicWords
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "AtomicWords needs a trivially copyable type");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+  public:
+    static constexpr std::size_t WORDS =
+        (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    /**
+     * Store a value word by word.
+     * @param value Value to store.
+     * @return void.
+     */
+    void store(const T &value)
+    {
+      std::array<std::uint64_t, WORDS> raw{};
+      std::memcpy(raw.data(), &value, sizeof(T));
+      for (std::size_t i = 0; i < WORDS; ++i)
+      {
+        words_[i].store(raw[i], std::memory_order_relaxed);
+      }
+    }
+
+    /**
+     * Load a value word by word (possibly torn).
+     * @return Loaded value.
+     */
+    [[nodiscard]] T load() const
+    {
+      std::array<std::uint64_t, WORDS> raw;
+      for (std::size_t i = 0; i < WORDS; ++i)
+      {
+        raw[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      T value;
+      std::memcpy(&value, raw.data(), sizeof(T));
+      return value;
+    }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, WORDS> words_{};
+  };
+
+  /**
+   * Single-writer sequence lock. The writer never blocks or waits for
+   * readers; readers copy the value and retry if a write overlapped the
+   * copy. The version is odd while a write is in progress.
+   * @tparam T Trivially copyable value type.
+   */
+  template <typename T>
+  class Seqlock
+  {
+  public:
+    /**
+     * Publish a new value. Must only be called from the writer thread.
+     * @param value Value to publish.
+     * @return void.
+     */
+    void write(const T &value)
+    {
+      auto version = version_.load(std::memory_order_relaxed);
+      version_.store(version + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      value_.store(value);
+      version_.store(version + 2, std::memory_order_release);
+    }
+
+    /**
+     * Read once without retrying.
+     * @param out Receives the value when consistent.
+     * @return false if a write was in progress or overlapped the copy.
+     */
+    [[nodiscard]] bool try_read(T &out) const
+    {
+      auto before = version_.load(std::memory_order_acquire);
+      if ((before & 1) != 0)
+      {
+        return false;
+      }
+      out = value_.load();
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return version_.load(std::memory_order_relaxed) == before;
+    }
+
+    /**
+     * Read a consistent value, retrying torn reads.
+     * @return Value as of the last completed write.
+     */
+    [[nodiscard]] T read() const
+    {
+      T out;
+      while (!try_read(out))
+      {
+        cpu_relax();
+      }
+      return out;
+    }
+
+    /** Completed writes times two (odd while a write is in progress). */
+    [[nodiscard]] std::uint64_t version() const
+    {
+      return version_.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::atomic<std::uint64_t> version_{0};
+    AtomicWords<T> value_;
+  };
+
+} // namespace kalshi::md
@@ -32,6 +32,13 @@ namespace kalshi::md
     No
   };
 
+  /** Whether an order buys or sells contracts of its side. */
+  enum class OrderAction
+  {
+    Buy,
+    Sell
+  };
+
   /** Market lifecycle status. */
   enum class MarketStatus
   {
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+#include "kalshi/md/model/exchange_events.hpp"
+
+namespace kalshi::md
+{
+
+  /**
+   * Fast path for orderbook_delta messages in the exact compact layout the
+   * exchange sends:
+   *
+   *   {"type":"orderbook_delta","sid":N,"seq":N,"msg":{"market_ticker":"..",
+   *    "price":N,"delta":N,"side":"yes"|"no"[,"client_order_id":".."][,...]}}
+   *
+   * Fields are read in one forward pass with no DOM. Anything outside that
+   * layout (whitespace, reordered or nested fields, escapes, non-integer
+   * numbers, out-of-range values) is declined rather than diagnosed; callers
+   * fall back to parse_orderbook_delta, which produces the same result for
+   * every message the scanner accepts.
+   *
+   * @param json Raw websocket message.
+   * @return OrderbookDelta, or std::nullopt if the layout is not the fast one.
+   */
+  [[nodiscard]] std::optional<OrderbookDelta> scan_orderbook_delta(std::string_view json);
+
+} // namespace kalshi::md
@@ -3,6 +3,7 @@
 #include <expected>
 #include <string_view>
 
+#include "kalshi/md/model/control_events.hpp"
 #include "kalshi/md/model/exchange_events.hpp"
 #include "kalshi/md/parse/parse_errors.hpp"
 
@@ -30,5 +31,25 @@ namespace kalshi::md
    */
   [[nodiscard]] std::expected<TradeEvent, ParseError> parse_trade_event(
       std::string_view json);
+  /**
+   * Parse a fill from the authenticated fill channel.
+   * @param json Raw websocket message.
+   * @return FillEvent or ParseError.
+   */
+  [[nodiscard]] std::expected<FillEvent, ParseError> parse_fill_event(std::string_view json);
+  /**
+   * Parse an order update from the authenticated user_orders channel.
+   * @param json Raw websocket message.
+   * @return UserOrderEvent or ParseError.
+   */
+  [[nodiscard]] std::expected<UserOrderEvent, ParseError> parse_user_order_event(
+      std::string_view json);
+  /**
+   * Parse a control message (subscribed, unsubscribed, ok, error).
+   * @param json Raw websocket message.
+   * @return ControlEvent or ParseError (UnsupportedType for data messages).
+   */
+  [[nodiscard]] std::expected<ControlEvent, ParseError> parse_control_event(
+      std::string_view json);
 
 } // namespace kalshi::md
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+
+#include <simdjson.h>
+
+namespace kalshi::md
+{
+
+  /**
+   * Start an on-demand parse of a websocket payload. The payload is copied
+   * into a per-thread padded buffer and parsed with a per-thread parser,
+   * shared by every parse function in this directory. Both grow
+   * geometrically and are reused, so parsing allocates nothing once they
+   * have grown to the largest message seen.
+   *
+   * The document borrows the per-thread scratch: it is invalidated by the
+   * next call on the same thread.
+   * @param json Raw websocket message.
+   * @return On-demand document or simdjson error.
+   */
+  [[nodiscard]] simdjson::simdjson_result<simdjson::ondemand::document> iterate_document(
+      std::string_view json);
+
+} // namespace kalshi::md
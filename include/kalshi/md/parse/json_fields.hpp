@@ -7,8 +7,13 @@ namespace kalshi::md
    * JSON field names for websocket payloads.
    */
   inline constexpr const char *FIELD_TYPE = "type";
+  inline constexpr const char *FIELD_SID = "sid";
   inline constexpr const char *FIELD_SEQ = "seq";
   inline constexpr const char *FIELD_MSG = "msg";
+  inline constexpr const char *FIELD_ID = "id";
+  inline constexpr const char *FIELD_CHANNEL = "channel";
+  inline constexpr const char *FIELD_CODE = "code";
+  inline constexpr const char *FIELD_MARKET_TICKERS = "market_tickers";
   inline constexpr const char *FIELD_MARKET_TICKER = "market_ticker";
 
   inline constexpr const char *FIELD_YES = "yes";
@@ -25,7 +30,24 @@ namespace kalshi::md
   inline constexpr const char *FIELD_TAKER_SIDE = "taker_side";
   inline constexpr const char *FIELD_TIMESTAMP = "ts";
 
+  inline constexpr const char *FIELD_TICKER = "ticker";
+  inline constexpr const char *FIELD_TRADE_ID = "trade_id";
+  inline constexpr const char *FIELD_ORDER_ID = "order_id";
+  inline constexpr const char *FIELD_ACTION = "action";
+  inline constexpr const char *FIELD_IS_TAKER = "is_taker";
+  inline constexpr const char *FIELD_STATUS = "status";
+  inline constexpr const char *FIELD_FILL_COUNT = "fill_count";
+  inline constexpr const char *FIELD_REMAINING_COUNT = "remaining_count";
+
   inline constexpr const char *VALUE_SIDE_YES = "yes";
   inline constexpr const char *VALUE_SIDE_NO = "no";
 
+  inline constexpr const char *VALUE_ACTION_BUY = "buy";
+  inline constexpr const char *VALUE_ACTION_SELL = "sell";
+
+  inline constexpr const char *VALUE_STATUS_RESTING = "resting";
+  inline constexpr const char *VALUE_STATUS_CANCELED = "canceled";
+  inline constexpr const char *VALUE_STATUS_EXECUTED = "executed";
+  inline constexpr const char *VALUE_STATUS_PENDING = "pending";
+
 } // namespace kalshi::md
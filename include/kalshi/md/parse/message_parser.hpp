@@ -1,20 +1,42 @@
 #pragma once
 
+#include <cstdint>
 #include <expected>
+#include <optional>
 #include <string>
 #include <string_view>
 
 #include "kalshi/md/parse/parse_errors.hpp"
+#include "kalshi/md/protocol/message_types.hpp"
 
 namespace kalshi::md
 {
 
   /**
-   * Extract message type string from a websocket JSON payload.
+   * Extract and classify the message type of a websocket JSON payload.
    * @param json Raw websocket message.
-   * @return Message type string or ParseError.
+   * @return MessageType (Unknown for unrecognised types) or ParseError.
    */
-  [[nodiscard]] std::expected<std::string, ParseError> parse_message_type(
+  [[nodiscard]] std::expected<MessageType, ParseError> parse_message_type(
+      std::string_view json);
+
+  /**
+   * Envelope fields used to order messages within a subscription.
+   */
+  struct SequenceHeader
+  {
+    MessageType type = MessageType::Unknown;
+    std::uint64_t sid = 0;
+    std::optional<std::uint64_t> seq;
+  };
+
+  /**
+   * Extract the message type and the top-level sid and seq from a
+   * websocket JSON payload.
+   * @param json Raw websocket message.
+   * @return SequenceHeader or ParseError (MissingField if there is no sid).
+   */
+  [[nodiscard]] std::expected<SequenceHeader, ParseError> parse_sequence_header(
       std::string_view json);
 
 } // namespace kalshi::md
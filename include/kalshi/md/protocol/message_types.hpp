@@ -1,5 +1,10 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
 namespace kalshi::md
 {
 
@@ -10,8 +15,152 @@ namespace kalshi::md
   inline constexpr const char *ORDERBOOK_DELTA = "orderbook_delta";
   inline constexpr const char *TRADE = "trade";
   inline constexpr const char *TICKER = "ticker";
+  inline constexpr const char *TICKER_V2 = "ticker_v2";
   inline constexpr const char *MARKET_STATUS = "market_status";
+  inline constexpr const char *MARKET_LIFECYCLE = "market_lifecycle_v2";
+  inline constexpr const char *FILL = "fill";
+  inline constexpr const char *USER_ORDER = "user_order";
   inline constexpr const char *SUBSCRIBED = "subscribed";
+  /** Channel carrying USER_ORDER messages (the message type is singular). */
+  inline constexpr const char *USER_ORDERS = "user_orders";
+  inline constexpr const char *UNSUBSCRIBED = "unsubscribed";
+  inline constexpr const char *UPDATE_OK = "ok";
   inline constexpr const char *ERROR = "error";
 
+  /** Known websocket message types. */
+  enum class MessageType : std::uint8_t
+  {
+    Unknown,
+    OrderbookSnapshot,
+    OrderbookDelta,
+    Trade,
+    Ticker,
+    TickerV2,
+    MarketLifecycle,
+    Fill,
+    UserOrder,
+    Subscribed,
+    Unsubscribed,
+    UpdateOk,
+    Error,
+    Count_
+  };
+
+  /** Number of MessageType values (size for handler tables). */
+  inline constexpr std::size_t MESSAGE_TYPE_COUNT = static_cast<std::size_t>(MessageType::Count_);
+
+  namespace detail
+  {
+
+    struct MessageTypeName
+    {
+      std::string_view name;
+      MessageType type;
+    };
+
+    /** Add new types here; the hash below is regenerated at compile time. */
+    inline constexpr std::array<MessageTypeName, 12> MESSAGE_TYPE_NAMES{{
+        {ORDERBOOK_SNAPSHOT, MessageType::OrderbookSnapshot},
+        {ORDERBOOK_DELTA, MessageType::OrderbookDelta},
+        {TRADE, MessageType::Trade},
+        {TICKER, MessageType::Ticker},
+        {TICKER_V2, MessageType::TickerV2},
+        {MARKET_LIFECYCLE, MessageType::MarketLifecycle},
+        {FILL, MessageType::Fill},
+        {USER_ORDER, MessageType::UserOrder},
+        {SUBSCRIBED, MessageType::Subscribed},
+        {UNSUBSCRIBED, MessageType::Unsubscribed},
+        {UPDATE_OK, MessageType::UpdateOk},
+        {ERROR, MessageType::Error},
+    }};
+
+    /** Hash over length and first character; cheap and enough to separate the names. */
+    constexpr std::size_t type_key(std::string_view name, std::size_t seed)
+    {
+      return name.size() * seed + static_cast<unsigned char>(name.front());
+    }
+
+    struct MessageTypeHash
+    {
+      std::size_t seed = 0;
+      std::size_t buckets = 0;
+    };
+
+    constexpr bool type_hash_is_perfect(std::size_t seed, std::size_t buckets)
+    {
+      for (std::size_t i = 0; i < MESSAGE_TYPE_NAMES.size(); ++i)
+      {
+        for (std::size_t j = i + 1; j < MESSAGE_TYPE_NAMES.size(); ++j)
+        {
+          if (type_key(MESSAGE_TYPE_NAMES[i].name, seed) % buckets ==
+              type_key(MESSAGE_TYPE_NAMES[j].name, seed) % buckets)
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    /** Smallest power-of-two table (and a seed for it) with no collisions. */
+    constexpr MessageTypeHash find_type_hash()
+    {
+      for (std::size_t buckets = 16; buckets <= 256; buckets *= 2)
+      {
+        for (std::size_t seed = 1; seed < 64; ++seed)
+        {
+          if (type_hash_is_perfect(seed, buckets))
+          {
+            return {seed, buckets};
+          }
+        }
+      }
+      return {};
+    }
+
+    inline constexpr MessageTypeHash TYPE_HASH = find_type_hash();
+    static_assert(TYPE_HASH.buckets != 0, "no perfect hash for MESSAGE_TYPE_NAMES");
+
+    /** Slot -> index into MESSAGE_TYPE_NAMES (+1; 0 = empty). */
+    constexpr auto build_type_slots()
+    {
+      std::array<std::uint8_t, TYPE_HASH.buckets> slots{};
+      for (std::size_t i = 0; i < MESSAGE_TYPE_NAMES.size(); ++i)
+      {
+        auto slot = type_key(MESSAGE_TYPE_NAMES[i].name, TYPE_HASH.seed) % TYPE_HASH.buckets;
+        slots[slot] = static_cast<std::uint8_t>(i + 1);
+      }
+      return slots;
+    }
+
+    inline constexpr auto TYPE_SLOTS = build_type_slots();
+
+  } // namespace detail
+
+  /**
+   * Classify a message type string without allocating: one table probe and
+   * one comparison.
+   * @param type Type string (typically a view into the parsed document).
+   * @return MessageType (Unknown if not recognised).
+   */
+  constexpr MessageType classify_message_type(std::string_view type)
+  {
+    if (type.empty())
+    {
+      return MessageType::Unknown;
+    }
+    auto slot = detail::TYPE_SLOTS[detail::type_key(type, detail::TYPE_HASH.seed) %
+                                   detail::TYPE_HASH.buckets];
+    if (slot == 0)
+    {
+      return MessageType::Unknown;
+    }
+    const auto &entry = detail::MESSAGE_TYPE_NAMES[slot - 1];
+    return entry.name == type ? entry.type : MessageType::Unknown;
+  }
+
+  static_assert(classify_message_type("orderbook_delta") == MessageType::OrderbookDelta);
+  static_assert(classify_message_type("orderbook_deltx") == MessageType::Unknown);
+  static_assert(classify_message_type("error") == MessageType::Error);
+
 } // namespace kalshi::md
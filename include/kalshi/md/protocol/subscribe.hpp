@@ -2,6 +2,7 @@
 
 #include "kalshi/core/config.hpp"
 
+#include <cstdint>
 #include <expected>
 #include <string>
 #include <string_view>
@@ -21,7 +22,15 @@ struct SubscribeRequest
 /** Errors returned while building subscription requests. */
 enum class SubscribeError
 {
-  MissingMarketTickers
+  MissingMarketTickers,
+  UnknownChannel
+};
+
+/** Action for an update_subscription command. */
+enum class UpdateAction
+{
+  AddMarkets,
+  DeleteMarkets
 };
 
 /**
@@ -73,4 +82,24 @@ private:
   std::string json_;
 };
 
+/**
+ * Build an update_subscription command that adds or removes markets on an
+ * existing subscription.
+ * @param id Request id.
+ * @param sid Subscription id from the `subscribed` reply.
+ * @param action Add or delete.
+ * @param market_tickers Markets to add or remove.
+ * @return JSON payload string.
+ */
+[[nodiscard]] std::string build_update_subscription_json(
+    int id, std::uint64_t sid, UpdateAction action, const std::vector<std::string>& market_tickers);
+
+/**
+ * Build an unsubscribe command.
+ * @param id Request id.
+ * @param sids Subscription ids to cancel.
+ * @return JSON payload string.
+ */
+[[nodiscard]] std::string build_unsubscribe_json(int id, const std::vector<std::uint64_t>& sids);
+
 } // namespace kalshi::md
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "kalshi/md/protocol/subscribe.hpp"
+
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kalshi::md
+{
+
+/**
+ * Tracks the desired channel/market set for one websocket connection and
+ * produces the minimal commands to move the live subscriptions towards it.
+ *
+ * Subscription ids are learned from `subscribed` replies. Market changes on
+ * a channel with a known sid become update_subscription commands carrying
+ * only the difference; changes made while a subscribe is still in flight
+ * are applied once its reply arrives. On reconnect every sid is forgotten
+ * and the full desired set is subscribed again. Mutations made while
+ * disconnected only update the desired set.
+ *
+ * Methods return the commands to send, in order. Not thread-safe.
+ */
+class SubscriptionManager
+{
+public:
+  SubscriptionManager() = default;
+
+  /**
+   * Seed the desired set from an initial subscribe request.
+   * @param initial Request whose channels all share its market tickers
+   *        (no tickers = all markets).
+   */
+  explicit SubscriptionManager(const SubscribeRequest& initial);
+
+  /**
+   * Connection opened: forget previous sids and subscribe everything.
+   * @return Commands to send.
+   */
+  [[nodiscard]] std::vector<std::string> on_connected();
+
+  /**
+   * Connection lost: sids are no longer valid.
+   * @return void.
+   */
+  void on_disconnected();
+
+  /**
+   * Record the sid from a `subscribed` reply.
+   * @param channel Channel name from the reply.
+   * @param sid Subscription id.
+   * @return Commands to send (deferred updates for that channel).
+   */
+  [[nodiscard]] std::vector<std::string> on_subscribed(std::string_view channel, std::uint64_t sid);
+
+  /**
+   * Handle an `error` reply. Channels whose subscribe command was rejected
+   * are dropped from the desired set so they are not retried on reconnect.
+   * @param id Request id from the error reply.
+   * @return Names of the dropped channels.
+   */
+  std::vector<std::string> on_command_failed(std::int64_t id);
+
+  /**
+   * Add markets to a channel, subscribing the channel if it is new. An
+   * empty list on a new channel subscribes it for all markets.
+   * @param channel Channel name.
+   * @param market_tickers Markets to add.
+   * @return Commands to send or SubscribeError.
+   */
+  [[nodiscard]] std::expected<std::vector<std::string>, SubscribeError> add_markets(
+      std::string_view channel, const std::vector<std::string>& market_tickers);
+
+  /**
+   * Remove markets from a channel. Removing the last market unsubscribes
+   * the channel.
+   * @param channel Channel name.
+   * @param market_tickers Markets to remove.
+   * @return Commands to send or SubscribeError.
+   */
+  [[nodiscard]] std::expected<std::vector<std::string>, SubscribeError> remove_markets(
+      std::string_view channel, const std::vector<std::string>& market_tickers);
+
+  /**
+   * Unsubscribe a channel entirely.
+   * @param channel Channel name.
+   * @return Commands to send or SubscribeError.
+   */
+  [[nodiscard]] std::expected<std::vector<std::string>, SubscribeError> remove_channel(
+      std::string_view channel);
+
+  /**
+   * Channel a sid belongs to on the current connection.
+   * @param sid Subscription id.
+   * @return Channel name or std::nullopt.
+   */
+  [[nodiscard]] std::optional<std::string_view> channel_for_sid(std::uint64_t sid) const;
+
+  /**
+   * Desired markets on a channel (empty for all-market or unknown channels).
+   * @param channel Channel name.
+   * @return Market tickers.
+   */
+  [[nodiscard]] std::vector<std::string> markets(std::string_view channel) const;
+
+private:
+  struct Channel
+  {
+    std::string name;
+    bool all_markets = false;
+    std::set<std::string> desired;
+    std::set<std::string> active; // markets requested on this connection
+    std::optional<std::uint64_t> sid;
+    bool pending = false; // subscribe sent, waiting for sid
+    int request_id = 0;   // id of the subscribe command in flight
+    bool removed = false; // unsubscribe once the sid is known
+  };
+
+  Channel* find(std::string_view channel);
+  const Channel* find(std::string_view channel) const;
+  void subscribe(std::vector<std::string>& out, std::vector<Channel*> group);
+  void reconcile(std::vector<std::string>& out, Channel& channel);
+  void erase_removed();
+
+  std::vector<Channel> channels_;
+  int next_id_ = 1;
+  bool connected_ = false;
+};
+
+} // namespace kalshi::md
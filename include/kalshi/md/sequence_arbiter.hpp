@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace kalshi::md
+{
+
+  /** Recent messages kept per stream (delivered) and per leg (held back) for alignment. */
+  inline constexpr std::size_t ARBITER_HISTORY = 1024;
+  /** Consecutive consistent fingerprint matches needed to align a leg. */
+  inline constexpr std::uint32_t ARBITER_ALIGN_CONFIRMATIONS = 3;
+  /** Streams above this are passed through without arbitration. */
+  inline constexpr std::uint64_t ARBITER_MAX_STREAM = 4096;
+
+  /**
+   * Fingerprint of a message body for cross-connection matching. Hashes the
+   * bytes from the `msg` field onward so per-connection sid/seq values do
+   * not affect the result.
+   * @param json Raw websocket message.
+   * @return 64-bit FNV-1a hash.
+   */
+  [[nodiscard]] std::uint64_t message_fingerprint(std::string_view json);
+
+  /**
+   * First-copy-wins arbitration between redundant connections ("legs")
+   * subscribed to the same channels.
+   *
+   * Messages are arbitrated per stream: a small dense id the caller
+   * assigns per channel, the same on every leg. Subscription ids cannot
+   * serve as the key, since each connection numbers its subscriptions in
+   * the order it made them, and a leg that reconnects after a channel was
+   * removed numbers the rest differently. Sequence numbers are per
+   * subscription and therefore per connection, so each leg's seq is mapped
+   * into one canonical sequence space per stream by a learned offset. The first leg to deliver on a stream defines the space. A
+   * leg that joins later is aligned by matching message fingerprints against
+   * recently delivered messages, and its messages are held back until then.
+   * Once aligned, a message is delivered only if its canonical seq is above
+   * the high-water mark, so the faster leg wins every message and a stalled
+   * or dropped leg costs nothing while another aligned leg is live. A leg
+   * that aligned while ahead of the others has already dropped messages they
+   * have not delivered yet, so it only takes over once it is contiguous with
+   * the high-water mark.
+   *
+   * If no aligned leg remains for a stream, the next leg to deliver starts a
+   * new epoch that continues the canonical numbering.
+   */
+  class SequenceArbiter
+  {
+  public:
+    /**
+     * Construct for a fixed number of legs.
+     * @param legs Number of legs.
+     */
+    explicit SequenceArbiter(std::size_t legs);
+
+    /**
+     * Decide whether a message from a leg should be delivered.
+     * @param leg Leg index.
+     * @param stream Stream id of the message's channel.
+     * @param seq Leg-local sequence number, if the message carries one.
+     * @param fingerprint message_fingerprint() of the payload.
+     * @return True to deliver, false to drop.
+     */
+    [[nodiscard]] bool accept(std::size_t leg,
+                              std::uint64_t stream,
+                              std::optional<std::uint64_t> seq,
+                              std::uint64_t fingerprint);
+
+    /**
+     * Mark a leg as disconnected; it must realign after reconnecting.
+     * @param leg Leg index.
+     * @return void.
+     */
+    void on_leg_down(std::size_t leg);
+
+    /**
+     * A leg's subscription to a stream ended; it must realign if it
+     * subscribes again. Once no live leg is aligned on the stream, the
+     * stream's history is dropped as well.
+     * @param leg Leg index.
+     * @param stream Stream id.
+     * @return void.
+     */
+    void reset_stream(std::size_t leg, std::uint64_t stream);
+
+    /** Messages delivered. */
+    [[nodiscard]] std::uint64_t delivered() const { return delivered_; }
+    /** Duplicate copies dropped. */
+    [[nodiscard]] std::uint64_t duplicates() const { return duplicates_; }
+    /** Messages held back while a leg was aligning. */
+    [[nodiscard]] std::uint64_t unaligned_drops() const { return unaligned_drops_; }
+    /** Times a leg started a new epoch because no aligned leg was live. */
+    [[nodiscard]] std::uint64_t epoch_restarts() const { return epoch_restarts_; }
+    /**
+     * Messages a leg delivered first.
+     * @param leg Leg index.
+     * @return Win count.
+     */
+    [[nodiscard]] std::uint64_t wins(std::size_t leg) const { return wins_[leg]; }
+
+  private:
+    struct HistoryEntry
+    {
+      std::uint64_t fingerprint = 0;
+      std::uint64_t canonical = 0;
+    };
+
+    struct PendingEntry
+    {
+      std::uint64_t fingerprint = 0;
+      std::uint64_t local = 0;
+    };
+
+    struct LegStream
+    {
+      bool aligned = false;
+      bool caught_up = false;
+      std::int64_t offset = 0;
+      std::int64_t candidate = 0;
+      std::uint32_t confirmations = 0;
+      std::vector<PendingEntry> pending; // sized to ARBITER_HISTORY on first use
+      std::size_t pending_next = 0;
+      std::size_t pending_size = 0;
+    };
+
+    struct StreamState
+    {
+      bool started = false;
+      std::size_t leader = 0;
+      std::uint64_t high_water = 0;
+      std::vector<HistoryEntry> history;
+      std::size_t history_next = 0;
+    };
+
+    void ensure_stream(std::uint64_t stream);
+    bool has_other_aligned_leg(std::size_t leg, std::uint64_t stream) const;
+    bool try_align(std::size_t leg, std::uint64_t stream, std::uint64_t seq, std::uint64_t fingerprint);
+    void note_candidate(LegStream &state, std::int64_t candidate, bool ahead);
+    void record(std::size_t leg, std::uint64_t stream, std::uint64_t canonical, std::uint64_t fingerprint);
+
+    std::vector<bool> live_;
+    std::vector<std::uint64_t> wins_;
+    std::vector<StreamState> streams_;
+    std::vector<std::vector<LegStream>> legs_;
+
+    std::uint64_t delivered_ = 0;
+    std::uint64_t duplicates_ = 0;
+    std::uint64_t unaligned_drops_ = 0;
+    std::uint64_t epoch_restarts_ = 0;
+  };
+
+} // namespace kalshi::md
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <utility>
+
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/seqlock.hpp"
+#include "kalshi/md/model/types.hpp"
+
+namespace kalshi::md
+{
+
+  /**
+   * Shared-memory feed segment, written by one ShmPublisher and mapped
+   * read-only by any number of ShmReader processes:
+   *
+   *   ShmHeader | ShmMarket[market_capacity] | ShmSlot[ring_capacity]
+   *
+   * Markets get dense ids in first-seen order. Each market slot has a
+   * seqlocked top of book. The ring is a broadcast journal of every event.
+   * Readers keep their own cursor, and the publisher never waits for them:
+   * a reader that falls a full ring behind is lapped and told so (see
+   * ShmReader::lost()).
+   */
+
+  /** Written last when creating a segment; readers reject anything else. */
+  inline constexpr std::uint64_t SHM_MAGIC = 0x4b414c53484d4431; // "KALSHMD1"
+  /** Bumped on any change to the structs below. */
+  inline constexpr std::uint32_t SHM_LAYOUT_VERSION = 1;
+  /** Longest ticker a segment can hold. */
+  inline constexpr std::size_t SHM_TICKER_CAPACITY = 64;
+  /** Smallest ring; it must hold a full snapshot plus headroom. */
+  inline constexpr std::uint64_t SHM_RING_MIN = 1024;
+
+  /** Errors returned while creating or opening a segment. */
+  enum class ShmError
+  {
+    InvalidOptions,
+    OpenFailed,
+    ResizeFailed,
+    MapFailed,
+    NotReady,
+    LayoutMismatch
+  };
+
+  /**
+   * Convert ShmError to a string literal.
+   * @param error Error to stringify.
+   * @return String literal describing the error.
+   */
+  [[nodiscard]] const char *to_string(ShmError error);
+
+  /** Event kinds carried by the ring. */
+  enum class ShmEventKind : std::uint8_t
+  {
+    /** Book replaced; `quantity` SnapshotLevel records follow. */
+    Snapshot,
+    SnapshotLevel,
+    BookDelta,
+    Trade,
+    Status
+  };
+
+  /** One ring record. Fields not listed for a kind are zero. */
+  struct ShmEvent
+  {
+    ShmEventKind kind;
+    MarketId market;
+    /** Snapshot, SnapshotLevel, BookDelta: book sequence. */
+    Sequence sequence;
+    /** Exchange timestamp in nanoseconds. */
+    std::int64_t ts_ns;
+    /** SnapshotLevel, BookDelta: book side. Trade: taker side. */
+    BookSide side;
+    /** SnapshotLevel, BookDelta: level price. Trade: yes price. */
+    Price price;
+    /** Trade: no price. */
+    Price no_price;
+    /**
+     * Snapshot: levels that follow. SnapshotLevel: size. BookDelta: size
+     * change. Trade: count.
+     */
+    std::int64_t quantity;
+    /** Status: new status. */
+    MarketStatus status;
+  };
+
+  /** Best levels and last trade of one market. Empty sides have size 0. */
+  struct ShmTopOfBook
+  {
+    Sequence sequence;
+    std::int64_t ts_ns;
+    Price yes_price;
+    Size yes_size;
+    Price no_price;
+    Size no_size;
+    Price last_trade_price; // yes price
+    Count last_trade_count; // 0 = no trade yet
+    MarketStatus status;
+    bool has_status;
+  };
+
+  /** Segment header. */
+  struct alignas(64) ShmHeader
+  {
+    std::atomic<std::uint64_t> magic;
+    std::uint32_t layout_version;
+    std::uint32_t market_capacity;
+    std::uint64_t ring_capacity; // power of two
+    std::uint64_t segment_size;
+    /** Market slots published so far; slots below it are immutable. */
+    alignas(64) std::atomic<std::uint32_t> market_count;
+    /** Set once the publisher has stopped. */
+    std::atomic<std::uint32_t> closed;
+    /** Events ever written to the ring. */
+    alignas(64) std::atomic<std::uint64_t> head;
+  };
+
+  /** Market slot. The ticker is written once, before the slot is published. */
+  struct alignas(64) ShmMarket
+  {
+    std::array<char, SHM_TICKER_CAPACITY> ticker;
+    std::uint32_t ticker_length;
+    alignas(64) Seqlock<ShmTopOfBook> top;
+  };
+
+  /**
+   * Ring slot. Event n lives in slot n % ring_capacity; its version is
+   * 2n + 1 while being written and 2n + 2 once complete.
+   */
+  struct alignas(64) ShmSlot
+  {
+    std::atomic<std::uint64_t> version;
+    AtomicWords<ShmEvent> event;
+  };
+
+  /** Byte offsets of a segment's regions. */
+  struct ShmLayout
+  {
+    std::size_t markets_offset;
+    std::size_t ring_offset;
+    std::size_t size;
+  };
+
+  /**
+   * Compute a segment's layout.
+   * @param market_capacity Market slots.
+   * @param ring_capacity Ring slots.
+   * @return Layout.
+   */
+  [[nodiscard]] constexpr ShmLayout shm_layout(std::uint32_t market_capacity,
+                                               std::uint64_t ring_capacity)
+  {
+    auto markets_offset = sizeof(ShmHeader);
+    auto ring_offset = markets_offset + market_capacity * sizeof(ShmMarket);
+    return ShmLayout{.markets_offset = markets_offset,
+                     .ring_offset = ring_offset,
+                     .size = ring_offset + ring_capacity * sizeof(ShmSlot)};
+  }
+
+  /**
+   * Owns one POSIX shared-memory mapping. The creator also owns the name and
+   * unlinks it on destruction; readers that still have it mapped keep
+   * working.
+   */
+  class ShmRegion
+  {
+  public:
+    /**
+     * Create a zeroed read-write segment, replacing any stale one with the
+     * same name.
+     * @param name Segment name ("/kalshi_md").
+     * @param size Segment size in bytes.
+     * @return Region or ShmError.
+     */
+    [[nodiscard]] static std::expected<ShmRegion, ShmError> create(const std::string &name,
+                                                                   std::size_t size);
+
+    /**
+     * Map an existing segment read-only.
+     * @param name Segment name.
+     * @return Region or ShmError.
+     */
+    [[nodiscard]] static std::expected<ShmRegion, ShmError> open(const std::string &name);
+
+    ShmRegion(ShmRegion &&other) noexcept;
+    ShmRegion &operator=(ShmRegion &&other) noexcept;
+    ShmRegion(const ShmRegion &) = delete;
+    ShmRegion &operator=(const ShmRegion &) = delete;
+    ~ShmRegion();
+
+    /** Start of the mapping. */
+    [[nodiscard]] std::byte *data() const { return static_cast<std::byte *>(base_); }
+
+    /** Mapping size in bytes. */
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+  private:
+    ShmRegion(std::string owned_name, void *base, std::size_t size)
+        : owned_name_(std::move(owned_name)), base_(base), size_(size)
+    {
+    }
+
+    void release();
+
+    std::string owned_name_; // empty for readers
+    void *base_ = nullptr;
+    std::size_t size_ = 0;
+  };
+
+} // namespace kalshi::md
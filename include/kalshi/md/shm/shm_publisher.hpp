@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/order_book.hpp"
+#include "kalshi/md/shm/shm_layout.hpp"
+
+namespace kalshi::md
+{
+
+  /**
+   * Market sink that publishes normalized book state into a shared-memory
+   * segment (see shm_layout.hpp), so strategy processes can share one feed
+   * connection through ShmReader.
+   *
+   * Every event updates the publisher's private book for its market, then
+   * rewrites that market's seqlocked top of book and appends one ring
+   * record. A snapshot appends one Snapshot record plus one SnapshotLevel
+   * record per level. Nothing on the hot path allocates or makes a
+   * syscall, and the publisher never waits for readers. Events for markets
+   * beyond market_capacity, or with tickers longer than SHM_TICKER_CAPACITY,
+   * are dropped and counted. Not thread-safe: call from the dispatching
+   * thread.
+   */
+  class ShmPublisher
+  {
+  public:
+    /** Segment sizing. */
+    struct Options
+    {
+      std::uint32_t market_capacity = 4096;
+      std::uint64_t ring_capacity = 1 << 16; // power of two, >= SHM_RING_MIN
+    };
+
+    /**
+     * Create the segment, replacing a stale one with the same name. The
+     * segment is unlinked again when the publisher is destroyed.
+     * @param name Segment name ("/kalshi_md").
+     * @param options Segment sizing.
+     * @return Publisher or ShmError.
+     */
+    [[nodiscard]] static std::expected<ShmPublisher, ShmError> create(const std::string &name,
+                                                                      Options options);
+
+    /**
+     * Publish a snapshot.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const OrderbookSnapshot &s);
+
+    /**
+     * Publish a delta.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const OrderbookDelta &d);
+
+    /**
+     * Publish a trade.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const TradeEvent &t);
+
+    /**
+     * Publish a status update.
+     * @param u Market status update.
+     * @return void.
+     */
+    void on_status(const MarketStatusUpdate &u);
+
+    /**
+     * Tell readers no more events will arrive.
+     * @return void.
+     */
+    void close();
+
+    /** Ring records written so far. */
+    [[nodiscard]] std::uint64_t published() const { return head_; }
+
+    /** Events dropped because their market could not get a slot. */
+    [[nodiscard]] std::uint64_t dropped() const { return dropped_; }
+
+  private:
+    struct MarketState
+    {
+      OrderBook book;
+      ShmTopOfBook top{};
+    };
+
+    ShmPublisher(ShmRegion region, Options options);
+
+    std::optional<MarketId> market(std::string_view market_ticker);
+    void update_best(MarketState &state, BookSide side, Price price, Size size);
+    void publish_top(MarketId id, const MarketState &state);
+    void append(const ShmEvent &event);
+
+    ShmRegion region_;
+    ShmHeader *header_;
+    ShmMarket *markets_;
+    ShmSlot *ring_;
+    std::uint32_t market_capacity_;
+    std::uint64_t ring_mask_;
+    std::uint64_t head_ = 0;
+    std::uint64_t dropped_ = 0;
+    MarketIdTable ids_;
+    std::vector<MarketState> states_; // by MarketId
+  };
+
+} // namespace kalshi::md
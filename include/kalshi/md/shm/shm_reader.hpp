@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/shm/shm_layout.hpp"
+
+namespace kalshi::md
+{
+
+  /**
+   * Read side of a ShmPublisher segment, for use in another process.
+   *
+   * The segment is mapped read-only. top_of_book() and poll() are plain
+   * loads from the mapping, with no syscalls or locks. Each ring record is
+   * copied into a local ShmEvent (48 bytes) so the slot version can confirm
+   * it was not overwritten during the copy. A reader starts at the live
+   * head and sees events published after open(); current state comes from
+   * top_of_book(). If the publisher laps the reader, the reader skips ahead
+   * and counts the skipped events in lost(). Books rebuilt from the ring
+   * are stale after that until the market's next Snapshot. A reader polls;
+   * when idle it should back off on its own. Not thread-safe: use one
+   * reader per consuming thread.
+   */
+  class ShmReader
+  {
+  public:
+    /**
+     * Map a segment created by ShmPublisher.
+     * @param name Segment name.
+     * @return Reader or ShmError (NotReady while the publisher is still
+     *         initializing it).
+     */
+    [[nodiscard]] static std::expected<ShmReader, ShmError> open(const std::string &name);
+
+    /** Markets published so far; ids below this are valid. */
+    [[nodiscard]] std::uint32_t market_count() const
+    {
+      return header_->market_count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Ticker of a market.
+     * @param id Market id below market_count().
+     * @return Ticker view into the segment.
+     */
+    [[nodiscard]] std::string_view ticker(MarketId id) const
+    {
+      const auto &market = markets_[id];
+      return {market.ticker.data(), market.ticker_length};
+    }
+
+    /**
+     * Id of a market by ticker.
+     * @param market_ticker Market ticker.
+     * @return Id or std::nullopt if the publisher has not seen the market.
+     */
+    [[nodiscard]] std::optional<MarketId> find(std::string_view market_ticker);
+
+    /**
+     * Consistent top of book of a market, retrying torn reads.
+     * @param id Market id below market_count().
+     * @return Top of book.
+     */
+    [[nodiscard]] ShmTopOfBook top_of_book(MarketId id) const { return markets_[id].top.read(); }
+
+    /**
+     * Deliver ring events published since the last poll.
+     * @param fn Called as fn(const ShmEvent &) per event, in publish order.
+     * @param max_events Stop after this many events.
+     * @return Number of events delivered.
+     */
+    template <typename Fn>
+    std::size_t poll(Fn &&fn, std::size_t max_events = std::numeric_limits<std::size_t>::max())
+    {
+      std::size_t delivered = 0;
+      while (delivered < max_events)
+      {
+        const auto &slot = ring_[cursor_ & ring_mask_];
+        auto expected = 2 * cursor_ + 2;
+        auto before = slot.version.load(std::memory_order_acquire);
+        if (before < expected)
+        {
+          break; // not written yet, or write in progress
+        }
+        auto event = slot.event.load();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (before != expected || slot.version.load(std::memory_order_relaxed) != expected)
+        {
+          skip_lapped();
+          continue;
+        }
+        ++cursor_;
+        ++delivered;
+        fn(event);
+      }
+      return delivered;
+    }
+
+    /**
+     * Skip everything published so far.
+     * @return void.
+     */
+    void seek_latest() { cursor_ = header_->head.load(std::memory_order_acquire); }
+
+    /** Index of the next event poll() will deliver. */
+    [[nodiscard]] std::uint64_t cursor() const { return cursor_; }
+
+    /** Events skipped because the publisher lapped this reader. */
+    [[nodiscard]] std::uint64_t lost() const { return lost_; }
+
+    /** Whether the publisher has stopped; drain with poll() afterwards. */
+    [[nodiscard]] bool closed() const
+    {
+      return header_->closed.load(std::memory_order_acquire) != 0;
+    }
+
+  private:
+    explicit ShmReader(ShmRegion region);
+
+    void skip_lapped();
+
+    ShmRegion region_;
+    const ShmHeader *header_;
+    const ShmMarket *markets_;
+    const ShmSlot *ring_;
+    std::uint64_t ring_capacity_;
+    std::uint64_t ring_mask_;
+    std::uint64_t cursor_ = 0;
+    std::uint64_t lost_ = 0;
+    MarketIdTable ids_; // mirrors the publisher's ids
+  };
+
+} // namespace kalshi::md
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <openssl/ssl.h>
+
+#include "kalshi/md/ws/ws_constants.hpp"
+
+namespace kalshi::md
+{
+
+  /**
+   * Connection state shared across successive WsClient instances so a
+   * reconnect can skip DNS and resume the previous TLS session.
+   *
+   * Holds the resolved endpoints for one host:port (refreshed in the
+   * background once per TTL) and the most recent resumable TLS session.
+   * Must be used from the IO context thread.
+   */
+  class ConnectionCache
+  {
+  public:
+    using Endpoints = boost::asio::ip::tcp::resolver::results_type;
+
+    /**
+     * Construct a cache.
+     * @param ioc IO context used for background DNS refresh.
+     * @param dns_ttl Refresh interval; zero disables endpoint caching.
+     * @param tls_resumption Whether to store and offer TLS sessions.
+     */
+    ConnectionCache(boost::asio::io_context &ioc,
+                    std::chrono::milliseconds dns_ttl,
+                    bool tls_resumption);
+    ~ConnectionCache();
+
+    ConnectionCache(const ConnectionCache &) = delete;
+    ConnectionCache &operator=(const ConnectionCache &) = delete;
+
+    /**
+     * Cached endpoints for host:port, if any.
+     * @param host Host name.
+     * @param port Port string.
+     * @return Endpoints or std::nullopt.
+     */
+    [[nodiscard]] std::optional<Endpoints> endpoints(std::string_view host,
+                                                     std::string_view port) const;
+    /**
+     * Store freshly resolved endpoints and start background refresh.
+     * @param host Host name.
+     * @param port Port string.
+     * @param results Resolver results.
+     * @return void.
+     */
+    void store_endpoints(std::string_view host, std::string_view port, Endpoints results);
+    /**
+     * Drop cached endpoints (e.g. after a connect failure).
+     * @return void.
+     */
+    void invalidate_endpoints();
+
+    /**
+     * Session to offer on the next handshake (borrowed, may be null).
+     * @return SSL_SESSION pointer or nullptr.
+     */
+    [[nodiscard]] SSL_SESSION *session() const { return session_; }
+    /**
+     * Take ownership of a session reference from SSL_get1_session.
+     * Non-resumable sessions are released immediately.
+     * @param session Session reference.
+     * @return void.
+     */
+    void store_session(SSL_SESSION *session);
+    /**
+     * Drop the cached session (e.g. after a failed handshake).
+     * @return void.
+     */
+    void clear_session();
+
+    /**
+     * Stop background refresh.
+     * @return void.
+     */
+    void stop();
+
+  private:
+    void schedule_refresh();
+
+    boost::asio::ip::tcp::resolver resolver_;
+    boost::asio::steady_timer refresh_timer_;
+    std::chrono::milliseconds dns_ttl_;
+    bool tls_resumption_;
+    bool refreshing_ = false;
+
+    std::string host_;
+    std::string port_;
+    std::optional<Endpoints> endpoints_;
+    SSL_SESSION *session_ = nullptr;
+  };
+
+} // namespace kalshi::md
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <expected>
 #include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -11,11 +12,14 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
 
 #include "kalshi/core/auth.hpp"
+#include "kalshi/core/rate_limiter.hpp"
+#include "kalshi/md/ws/connection_cache.hpp"
 #include "kalshi/md/ws/ws_constants.hpp"
 
 namespace kalshi::md
@@ -30,7 +34,8 @@ namespace kalshi::md
     SslHandshakeFailed,
     WsHandshakeFailed,
     ReadFailed,
-    WriteFailed
+    WriteFailed,
+    WriteQueueFull
   };
 
   /** Parsed websocket URL parts. */
@@ -48,13 +53,19 @@ namespace kalshi::md
    */
   [[nodiscard]] std::expected<WsUrl, WsError> parse_ws_url(std::string_view url);
 
-  /** Async websocket client using Boost.Beast. */
-  class WsClient
+  /**
+   * Async websocket client using Boost.Beast. Must be owned by a
+   * std::shared_ptr: pending handlers hold a reference, so a client
+   * replaced on reconnect stays valid until they have run. Errors are
+   * reported once; a failed or closed client reports nothing further.
+   */
+  class WsClient : public std::enable_shared_from_this<WsClient>
   {
   public:
     using MessageCallback = std::function<void(std::string)>;
     using ErrorCallback = std::function<void(WsError, std::string_view)>;
     using OpenCallback = std::function<void()>;
+    using ReadIdleCallback = std::function<void()>;
     using ControlCallback =
         std::function<void(boost::beast::websocket::frame_type, std::string_view)>;
 
@@ -89,6 +100,14 @@ namespace kalshi::md
      * @return void.
      */
     void set_control_callback(ControlCallback cb);
+    /**
+     * Register callback invoked once every frame that was already readable
+     * has been delivered, i.e. when a read does not complete immediately.
+     * Consumers use it to close out work batched across a read burst.
+     * @param cb Callback to invoke.
+     * @return void.
+     */
+    void set_read_idle_callback(ReadIdleCallback cb);
 
     /**
      * Configure websocket timeouts.
@@ -101,6 +120,35 @@ namespace kalshi::md
                       std::chrono::seconds idle_timeout,
                       bool keep_alive_pings);
 
+    /**
+     * Share DNS results and TLS sessions with other clients. The cache must
+     * outlive the client.
+     * @param cache Connection cache, or nullptr to disable.
+     * @return void.
+     */
+    void set_connection_cache(ConnectionCache *cache);
+
+    /**
+     * Pace outbound messages through a token bucket, one token per message.
+     * A message without a token stays in the outbound queue and is written
+     * when the bucket allows, so send_text() never blocks; it fails only
+     * when the queue is full. The bucket must outlive the client.
+     * @param bucket Bucket to draw from, or nullptr for no limit.
+     * @return void.
+     */
+    void set_rate_limit(kalshi::TokenBucket *bucket);
+
+    /**
+     * Whether the last connect skipped DNS using cached endpoints.
+     * @return True if endpoints came from the cache.
+     */
+    [[nodiscard]] bool used_cached_endpoints() const { return used_cached_endpoints_; }
+    /**
+     * Whether the TLS handshake resumed a cached session.
+     * @return True if the session was resumed.
+     */
+    [[nodiscard]] bool session_resumed() const { return session_resumed_; }
+
     /**
      * Connect to websocket and apply headers.
      * @param url Websocket URL.
@@ -109,11 +157,20 @@ namespace kalshi::md
      */
     void connect(const std::string &url, const std::vector<kalshi::Header> &headers);
     /**
-     * Send a text message.
+     * Queue a text message for sending. Messages are written one at a time
+     * in FIFO order; the payload is copied into a preallocated slot that
+     * stays alive until its write completes. Messages queued before the
+     * handshake completes are flushed on open. Must be called on the IO
+     * context thread.
      * @param payload Text payload.
-     * @return void.
+     * @return void or WsError::WriteQueueFull.
      */
-    void send_text(std::string payload);
+    [[nodiscard]] std::expected<void, WsError> send_text(std::string_view payload);
+    /**
+     * Number of queued messages, including the one being written.
+     * @return Pending message count.
+     */
+    [[nodiscard]] std::size_t pending_writes() const { return out_size_; }
     /**
      * Close websocket gracefully.
      * @return void.
@@ -129,12 +186,16 @@ namespace kalshi::md
     void on_ws_handshake(boost::system::error_code ec);
     void do_read();
     void on_read(boost::system::error_code ec, std::size_t bytes);
+    void check_read_idle();
+    void do_write();
+    void start_write();
     void on_write(boost::system::error_code ec, std::size_t bytes);
     void fail(WsError err, std::string_view msg);
     void configure_timeouts();
     void configure_headers();
     void resolve_host(std::string port);
     void configure_control_callback();
+    void save_session();
 
     boost::asio::ip::tcp::resolver resolver_;
     boost::beast::websocket::stream<
@@ -144,12 +205,30 @@ namespace kalshi::md
     boost::beast::flat_buffer buffer_;
     std::vector<kalshi::Header> headers_;
     std::string host_;
+    std::string port_;
     std::string target_;
 
+    ConnectionCache *cache_ = nullptr;
+    bool used_cached_endpoints_ = false;
+    bool session_resumed_ = false;
+    bool session_saved_ = false;
+
     MessageCallback on_message_;
     ErrorCallback on_error_;
     OpenCallback on_open_;
     ControlCallback on_control_;
+    ReadIdleCallback on_read_idle_;
+    bool idle_check_posted_ = false;
+    bool read_since_idle_check_ = false;
+
+    std::vector<std::string> outbound_;
+    std::size_t out_head_ = 0;
+    std::size_t out_size_ = 0;
+    bool writing_ = false; // a write, or the wait for its token, is in flight
+    kalshi::TokenBucket *rate_limit_ = nullptr;
+    boost::asio::steady_timer throttle_timer_;
+    bool open_ = false;
+    bool stopped_ = false; // failed or closed; nothing more is reported
 
     std::chrono::seconds handshake_timeout_{CONNECT_TIMEOUT};
     std::chrono::seconds idle_timeout_{IDLE_TIMEOUT};
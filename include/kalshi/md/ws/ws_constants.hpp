@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <string_view>
 
 namespace kalshi::md {
 
@@ -16,5 +18,13 @@ inline constexpr std::string_view WSS_PREFIX = "wss://";
 inline constexpr std::chrono::seconds CONNECT_TIMEOUT{30};
 /** Default websocket idle timeout. */
 inline constexpr std::chrono::seconds IDLE_TIMEOUT{60};
+/** Time before a scheduled reconnect at which auth headers are signed. */
+inline constexpr std::chrono::milliseconds PRESIGN_LEAD{250};
+/** Max outbound messages queued behind the in-flight write. */
+inline constexpr std::size_t OUTBOUND_QUEUE_CAPACITY = 64;
+/** Bytes reserved per outbound slot so typical commands never reallocate. */
+inline constexpr std::size_t OUTBOUND_SLOT_RESERVE = 1024;
+/** Connections opened in hot-standby mode. */
+inline constexpr std::size_t HOT_STANDBY_LEGS = 2;
 
 } // namespace kalshi::md
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "kalshi/md/model/book_views.hpp"
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/sim/event_log.hpp"
+#include "kalshi/sim/matching_engine.hpp"
+#include "kalshi/strategy/pipeline.hpp"
+#include "kalshi/trade/position_tracker.hpp"
+#include "kalshi/trade/risk_engine.hpp"
+
+namespace kalshi::sim
+{
+
+  /** Limits and costs of a backtest. */
+  struct BacktestOptions
+  {
+    trade::RiskLimits limits{};
+    trade::FeeSchedule fees{};
+    std::uint32_t order_capacity = 4096;
+  };
+
+  /** Outcome of one backtest. Money in cents. */
+  struct BacktestResult
+  {
+    std::int64_t realized;   // closed P&L before fees
+    std::int64_t unrealized; // open positions at the final book mids
+    std::int64_t fees;
+    std::int64_t net;        // realized + unrealized - fees
+    std::uint64_t events;
+    std::uint64_t orders;    // placed
+    std::uint64_t fills;
+    std::uint64_t contracts; // filled
+    std::uint64_t rejects;   // refused by risk or the gateway
+  };
+
+  /**
+   * Add one result into a running total.
+   * @param total Total to update.
+   * @param result Result to add.
+   * @return void.
+   */
+  inline void accumulate(BacktestResult &total, const BacktestResult &result)
+  {
+    total.realized += result.realized;
+    total.unrealized += result.unrealized;
+    total.fees += result.fees;
+    total.net += result.net;
+    total.events += result.events;
+    total.orders += result.orders;
+    total.fills += result.fills;
+    total.contracts += result.contracts;
+    total.rejects += result.rejects;
+  }
+
+  template <strategy::Strategy Strat>
+  /**
+   * Run a strategy over an event log against a MatchingEngine.
+   *
+   * The chain is the live one with the engine as gateway: event ->
+   * engine -> StrategyPipeline -> RiskGate -> GatewaySink -> engine.
+   * Simulated fills go to a PositionTracker. At the end, open positions
+   * are marked at the mids of the engine's final books, published through
+   * BookViews as the feed publishes them live.
+   *
+   * Everything but the log is local to the call, so backtests on different
+   * threads share nothing but the read-only log.
+   *
+   * @param log Event log.
+   * @param strategy Strategy, sized for log.market_count() markets.
+   * @param options Limits and costs.
+   * @return Result.
+   */
+  BacktestResult run_backtest(const EventLog &log, Strat &strategy, const BacktestOptions &options)
+  {
+    using Gateway = strategy::GatewaySink<MatchingEngine>;
+    using Gate = strategy::RiskGate<Gateway>;
+    using Pipeline = strategy::StrategyPipeline<Strat, Gate>;
+
+    auto markets = std::max<std::uint32_t>(1, log.market_count());
+    MatchingEngine engine(MatchingOptions{.market_capacity = markets,
+                                          .order_capacity = options.order_capacity,
+                                          .client_id_prefix = "bt-"});
+    trade::RiskEngine risk(markets, options.limits);
+    engine.set_risk_engine(&risk);
+    md::BookViews views(markets);
+    trade::PositionTracker positions(views, options.fees);
+    engine.set_fill_handler([&positions](const md::FillEvent &fill) { (void)positions.on_fill(fill); });
+
+    Gateway gateway(engine);
+    Gate gate(risk, gateway);
+    Pipeline pipeline(markets, strategy, gate);
+    BacktestSink<Pipeline> sink(engine, pipeline);
+    auto events = replay(log, sink);
+
+    for (std::size_t id = 0; id < positions.market_count(); ++id)
+    {
+      const auto &ticker = positions.ticker(static_cast<md::MarketId>(id));
+      auto book_id = engine.find(ticker);
+      if (positions.position(static_cast<md::MarketId>(id)).position == 0 || !book_id)
+      {
+        continue;
+      }
+      md::OrderbookSnapshot snapshot;
+      snapshot.market_ticker = ticker;
+      snapshot.sequence = engine.book(*book_id).sequence();
+      snapshot.ts = md::Timestamp(0);
+      for (auto side : {md::BookSide::Yes, md::BookSide::No})
+      {
+        const auto &levels = engine.book(*book_id).levels(side);
+        for (md::Price price = 0; price <= md::PRICE_MAX; ++price)
+        {
+          if (levels[price] != 0)
+          {
+            (side == md::BookSide::Yes ? snapshot.yes : snapshot.no)
+                .push_back(md::PriceLevel{.price = price, .size = levels[price]});
+          }
+        }
+      }
+      views.on_snapshot(snapshot);
+    }
+    auto mark = positions.mark_all();
+
+    const auto &stats = engine.stats();
+    return BacktestResult{.realized = mark.realized,
+                          .unrealized = mark.unrealized,
+                          .fees = mark.fees,
+                          .net = mark.realized + mark.unrealized - mark.fees,
+                          .events = events,
+                          .orders = stats.placed,
+                          .fills = stats.maker_fills + stats.taker_fills,
+                          .contracts = stats.filled_contracts,
+                          .rejects = gate.rejected() + gateway.failed()};
+  }
+
+} // namespace kalshi::sim
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/market_sink.hpp"
+#include "kalshi/md/shm/shm_layout.hpp"
+
+namespace kalshi::sim
+{
+
+  /**
+   * Parsed capture on disk, replayed without any JSON work:
+   *
+   *   EventLogHeader | md::ShmEvent[event_count] | EventLogTicker[market_count] | chars
+   *
+   * Events use the shared-memory journal's record (one Snapshot record
+   * followed by its SnapshotLevel records, then one record per delta, trade
+   * or status update), with market ids local to the file. A log is written
+   * once from a newline-delimited JSON capture and then mapped read-only,
+   * so any number of backtest threads or processes share one copy through
+   * the page cache.
+   */
+
+  /** First field of every log; readers reject anything else. */
+  inline constexpr std::uint64_t EVENT_LOG_MAGIC = 0x4b414c45564c4f47; // "KALEVLOG"
+  /** Bumped on any change to the layout, including md::ShmEvent. */
+  inline constexpr std::uint32_t EVENT_LOG_VERSION = 1;
+
+  /** Event log file header. */
+  struct EventLogHeader
+  {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t market_count;
+    std::uint64_t event_count;
+    std::uint64_t events_offset;
+    std::uint64_t tickers_offset;
+    std::uint64_t file_size;
+  };
+
+  /** Ticker table entry; chars are relative to the end of the table. */
+  struct EventLogTicker
+  {
+    std::uint32_t offset;
+    std::uint32_t length;
+  };
+
+  /** Errors of writing or opening an event log. */
+  enum class EventLogError
+  {
+    CaptureOpenFailed,
+    OutputOpenFailed,
+    WriteFailed,
+    OpenFailed,
+    MapFailed,
+    LayoutMismatch
+  };
+
+  /**
+   * Convert EventLogError to a string literal.
+   * @param error Error to stringify.
+   * @return String literal describing the error.
+   */
+  [[nodiscard]] const char *to_string(EventLogError error);
+
+  /**
+   * Market sink that records events for an event log. Feed it from a
+   * Dispatcher, then write().
+   */
+  class EventLogWriter
+  {
+  public:
+    /**
+     * Record a snapshot and its levels.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const md::OrderbookSnapshot &s);
+
+    /**
+     * Record a delta.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const md::OrderbookDelta &d);
+
+    /**
+     * Record a trade.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const md::TradeEvent &t);
+
+    /**
+     * Record a status update.
+     * @param u Market status update.
+     * @return void.
+     */
+    void on_status(const md::MarketStatusUpdate &u);
+
+    /**
+     * Write the recorded events.
+     * @param path Output file; replaced if it exists.
+     * @return Nothing or EventLogError.
+     */
+    [[nodiscard]] std::expected<void, EventLogError> write(const std::string &path) const;
+
+    /** Events recorded, counting snapshot levels. */
+    [[nodiscard]] std::size_t event_count() const { return events_.size(); }
+
+  private:
+    md::MarketId market(std::string_view market_ticker) { return ids_.intern(market_ticker); }
+
+    md::MarketIdTable ids_;
+    std::vector<md::ShmEvent> events_;
+  };
+
+  /** What convert_capture() read and wrote. */
+  struct CaptureStats
+  {
+    std::uint64_t messages;
+    std::uint64_t rejected; // lines the dispatcher could not parse or route
+    std::uint64_t events;
+  };
+
+  /**
+   * Parse a newline-delimited JSON capture (as written by FeedHandler's raw
+   * message capture) into an event log.
+   * @param capture_path Capture file.
+   * @param log_path Event log to write.
+   * @return Stats or EventLogError.
+   */
+  [[nodiscard]] std::expected<CaptureStats, EventLogError> convert_capture(const std::string &capture_path,
+                                                                         const std::string &log_path);
+
+  /** Read-only mapping of an event log. Move-only; safe to share across threads. */
+  class EventLog
+  {
+  public:
+    /**
+     * Map an event log and validate its layout.
+     * @param path Event log file.
+     * @return Log or EventLogError.
+     */
+    [[nodiscard]] static std::expected<EventLog, EventLogError> open(const std::string &path);
+
+    EventLog(EventLog &&other) noexcept;
+    EventLog &operator=(EventLog &&other) noexcept;
+    EventLog(const EventLog &) = delete;
+    EventLog &operator=(const EventLog &) = delete;
+    ~EventLog();
+
+    /** Events in capture order. */
+    [[nodiscard]] std::span<const md::ShmEvent> events() const { return events_; }
+
+    /** Markets in the log; event market ids are below this. */
+    [[nodiscard]] std::uint32_t market_count() const
+    {
+      return static_cast<std::uint32_t>(tickers_.size());
+    }
+
+    /**
+     * Ticker of a market.
+     * @param id Market id below market_count().
+     * @return Ticker, viewing the mapping.
+     */
+    [[nodiscard]] std::string_view ticker(md::MarketId id) const { return tickers_[id]; }
+
+  private:
+    EventLog(void *base, std::size_t size);
+    void release();
+
+    void *base_ = nullptr;
+    std::size_t size_ = 0;
+    std::span<const md::ShmEvent> events_;
+    std::vector<std::string_view> tickers_;
+  };
+
+  template <md::MarketSink Sink>
+  /**
+   * Replay an event log into a sink, one call per event. Event objects are
+   * built once per market up front, so replay itself does not allocate.
+   * @param log Event log.
+   * @param sink Destination sink.
+   * @return Events delivered (a snapshot counts once).
+   */
+  std::uint64_t replay(const EventLog &log, Sink &sink)
+  {
+    struct Scratch
+    {
+      md::OrderbookDelta delta;
+      md::TradeEvent trade;
+      md::MarketStatusUpdate status;
+    };
+    std::vector<Scratch> scratch(log.market_count());
+    for (md::MarketId id = 0; id < log.market_count(); ++id)
+    {
+      auto ticker = std::string(log.ticker(id));
+      scratch[id].delta.market_ticker = ticker;
+      scratch[id].trade.market_ticker = ticker;
+      scratch[id].status.market_ticker = std::move(ticker);
+    }
+
+    md::OrderbookSnapshot snapshot;
+    std::uint64_t levels = 0;
+    std::uint64_t delivered = 0;
+    for (const auto &e : log.events())
+    {
+      if (e.market >= log.market_count())
+      {
+        continue;
+      }
+      if (levels != 0 && e.kind != md::ShmEventKind::SnapshotLevel)
+      {
+        levels = 0;
+        sink.on_snapshot(snapshot);
+        ++delivered;
+      }
+      auto &s = scratch[e.market];
+      switch (e.kind)
+      {
+      case md::ShmEventKind::Snapshot:
+        snapshot.market_ticker = s.delta.market_ticker;
+        snapshot.sequence = e.sequence;
+        snapshot.yes.clear();
+        snapshot.no.clear();
+        snapshot.ts = md::Timestamp(e.ts_ns);
+        levels = static_cast<std::uint64_t>(e.quantity);
+        if (levels == 0)
+        {
+          sink.on_snapshot(snapshot);
+          ++delivered;
+        }
+        break;
+      case md::ShmEventKind::SnapshotLevel:
+        if (levels == 0)
+        {
+          break;
+        }
+        (e.side == md::BookSide::Yes ? snapshot.yes : snapshot.no)
+            .push_back(md::PriceLevel{.price = e.price, .size = static_cast<md::Size>(e.quantity)});
+        if (--levels == 0)
+        {
+          sink.on_snapshot(snapshot);
+          ++delivered;
+        }
+        break;
+      case md::ShmEventKind::BookDelta:
+        s.delta.sequence = e.sequence;
+        s.delta.price = e.price;
+        s.delta.delta = static_cast<md::Delta>(e.quantity);
+        s.delta.side = e.side;
+        s.delta.ts = md::Timestamp(e.ts_ns);
+        sink.on_delta(s.delta);
+        ++delivered;
+        break;
+      case md::ShmEventKind::Trade:
+        s.trade.yes_price = e.price;
+        s.trade.no_price = e.no_price;
+        s.trade.count = static_cast<md::Count>(e.quantity);
+        s.trade.taker_side = e.side;
+        s.trade.ts = md::Timestamp(e.ts_ns);
+        sink.on_trade(s.trade);
+        ++delivered;
+        break;
+      case md::ShmEventKind::Status:
+        s.status.status = e.status;
+        s.status.ts = md::Timestamp(e.ts_ns);
+        sink.on_status(s.status);
+        ++delivered;
+        break;
+      }
+    }
+    if (levels != 0)
+    {
+      sink.on_snapshot(snapshot);
+      ++delivered;
+    }
+    return delivered;
+  }
+
+} // namespace kalshi::sim
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/market_sink.hpp"
+#include "kalshi/md/model/order_book.hpp"
+#include "kalshi/trade/order_gateway.hpp"
+#include "kalshi/trade/order_manager.hpp"
+#include "kalshi/trade/risk_engine.hpp"
+
+namespace kalshi::sim
+{
+
+  /** Sizing of MatchingEngine. */
+  struct MatchingOptions
+  {
+    std::uint32_t market_capacity = 4096;
+    std::uint32_t order_capacity = 4096;
+    std::string_view client_id_prefix = "sim-";
+  };
+
+  /** Counters of MatchingEngine. */
+  struct MatchingStats
+  {
+    std::uint64_t snapshots;
+    std::uint64_t deltas;
+    std::uint64_t trades;
+    std::uint64_t dropped;          // events for markets beyond the capacity
+    std::uint64_t placed;
+    std::uint64_t canceled;
+    std::uint64_t maker_fills;
+    std::uint64_t taker_fills;
+    std::uint64_t filled_contracts;
+  };
+
+  /**
+   * Simulated exchange for backtests: replays captured market data into
+   * per-market books and matches our orders against it, behind the same
+   * OrderGateway API as trade::LiveGateway.
+   *
+   * Our orders are virtual; the replayed book never contains them and is
+   * never changed by them. Matching follows the replayed flow:
+   *
+   * - Placing an order that crosses the book takes the displayed size of
+   *   each crossed level at that level's price; the rest rests.
+   * - A resting order joins the back of its level, so the size ahead of it
+   *   is the level's size when it was placed.
+   * - A trade against the order's side at its price first consumes the
+   *   size ahead and then fills the order. A trade at a worse price means
+   *   the level traded through, so the order fills up to the trade size.
+   * - A size decrease at the order's level that is not explained by a
+   *   trade already seen is taken as cancels spread evenly over the queue,
+   *   so the size ahead shrinks in proportion. Size ahead never exceeds
+   *   the level's size.
+   * - Size added on the other side at a crossing price fills the order as
+   *   maker, up to the size added.
+   *
+   * Orders are acked and canceled immediately, with no latency. Fills are
+   * applied to the engine's OrderManager and RiskEngine and reported as
+   * md::FillEvent, as the fill channel reports them live, so a
+   * PositionTracker can consume either. Terminal orders are released.
+   *
+   * Market ids are interned from snapshots and deltas in first-seen order,
+   * as StrategyPipeline does, so both number markets alike when fed the
+   * same events. Delta and trade handling is O(1) for a market with no
+   * orders of ours and linear in our open orders there otherwise.
+   * Single-threaded.
+   */
+  class MatchingEngine
+  {
+  public:
+    /** Receives each simulated fill. */
+    using FillHandler = std::function<void(const md::FillEvent &)>;
+
+    /**
+     * Construct with fixed market and order capacities.
+     * @param options Sizing.
+     */
+    explicit MatchingEngine(MatchingOptions options);
+
+    /**
+     * Report reservations, fills and closes to a risk engine.
+     * @param risk Risk engine, or nullptr to stop; must outlive the engine.
+     * @return void.
+     */
+    void set_risk_engine(trade::RiskEngine *risk) { risk_ = risk; }
+
+    /**
+     * Set the fill callback.
+     * @param handler Callback; empty to drop fills.
+     * @return void.
+     */
+    void set_fill_handler(FillHandler handler) { on_fill_ = std::move(handler); }
+
+    /**
+     * Replace a market's book.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const md::OrderbookSnapshot &s);
+
+    /**
+     * Apply a delta and move queue positions at its level.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const md::OrderbookDelta &d);
+
+    /**
+     * Match a trade against our resting orders.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const md::TradeEvent &t);
+
+    /**
+     * Cancel our orders in a market that stops trading.
+     * @param u Market status update.
+     * @return void.
+     */
+    void on_status(const md::MarketStatusUpdate &u);
+
+    /**
+     * Place an order: take what it crosses and rest the remainder.
+     * @param spec Order to place.
+     * @return Handle (stale if the order filled completely) or GatewayError.
+     */
+    [[nodiscard]] std::expected<trade::OrderHandle, trade::GatewayError>
+    place(const trade::OrderSpec &spec);
+
+    /**
+     * Cancel an order.
+     * @param handle Order handle.
+     * @return Nothing or GatewayError::UnknownOrder.
+     */
+    [[nodiscard]] std::expected<void, trade::GatewayError> cancel(trade::OrderHandle handle);
+
+    /**
+     * Cancel every open order in a market.
+     * @param market Market id.
+     * @return Orders canceled.
+     */
+    std::size_t cancel_market(md::MarketId market);
+
+    /** Order states. */
+    [[nodiscard]] const trade::OrderManager &orders() const { return orders_; }
+
+    /**
+     * Id of a market.
+     * @param market_ticker Market ticker.
+     * @return Id or std::nullopt if the engine has not seen the market.
+     */
+    [[nodiscard]] std::optional<md::MarketId> find(std::string_view market_ticker) const
+    {
+      return ids_.find(market_ticker);
+    }
+
+    /**
+     * Replayed book of a market.
+     * @param id Market id returned by find().
+     * @return Book.
+     */
+    [[nodiscard]] const md::OrderBook &book(md::MarketId id) const { return markets_[id].book; }
+
+    /**
+     * Size queued ahead of a resting order.
+     * @param handle Order handle.
+     * @return Contracts ahead or std::nullopt if the order is not open.
+     */
+    [[nodiscard]] std::optional<std::uint64_t> queue_ahead(trade::OrderHandle handle) const;
+
+    /** Counters. */
+    [[nodiscard]] const MatchingStats &stats() const { return stats_; }
+
+  private:
+    /** Per-market state. */
+    struct Market
+    {
+      md::OrderBook book;
+      // Traded size per level not yet matched by a delta, so a trade and
+      // the delta that removes its size do not move the queue twice.
+      std::array<md::OrderBook::Levels, 2> traded{};
+    };
+
+    /** Book position of a resting order, per OrderManager slot. */
+    struct Resting
+    {
+      md::BookSide side; // side of the book the order rests on
+      md::Price price;   // price in that side's cents
+      std::uint64_t ahead;
+    };
+
+    std::optional<md::MarketId> market(std::string_view market_ticker);
+    void level_reduced(md::MarketId id, Market &m, md::BookSide side, md::Price price,
+                       md::Size before, md::Size after);
+    void level_added(md::MarketId id, md::BookSide side, md::Price price, md::Size added);
+    bool fill(trade::OrderHandle handle, md::Price book_price, std::uint32_t count, bool taker);
+    void close(trade::OrderHandle handle, const trade::Order &order);
+
+    std::uint32_t market_capacity_;
+    std::unique_ptr<Market[]> markets_;
+    md::MarketIdTable ids_;
+    trade::OrderManager orders_;
+    trade::OpenOrderIndex open_;
+    std::unique_ptr<Resting[]> resting_;
+    trade::RiskEngine *risk_ = nullptr;
+    FillHandler on_fill_;
+    md::Timestamp now_{0};
+    MatchingStats stats_{};
+  };
+
+  static_assert(md::MarketSink<MatchingEngine>);
+  static_assert(trade::OrderGateway<MatchingEngine>);
+
+  template <md::MarketSink Downstream>
+  /**
+   * Market sink for backtests: hands each event to the engine and then to
+   * the sink that trades against it (typically a StrategyPipeline whose
+   * gateway is the engine). Deliberately not a BatchMarketSink, so a
+   * Dispatcher delivers events one at a time and the strategy never sees
+   * a book that is ahead of the engine's or behind it, which a batching
+   * FanoutSink would allow.
+   */
+  class BacktestSink
+  {
+  public:
+    /**
+     * Construct on an engine and the sink behind it.
+     * @param engine Matching engine; must outlive the sink.
+     * @param downstream Trading sink; must outlive the sink.
+     */
+    BacktestSink(MatchingEngine &engine, Downstream &downstream)
+        : engine_(engine), downstream_(downstream)
+    {
+    }
+
+    /**
+     * Forward a snapshot to the engine, then downstream.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const md::OrderbookSnapshot &s)
+    {
+      engine_.on_snapshot(s);
+      downstream_.on_snapshot(s);
+    }
+
+    /**
+     * Forward a delta to the engine, then downstream.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const md::OrderbookDelta &d)
+    {
+      engine_.on_delta(d);
+      downstream_.on_delta(d);
+    }
+
+    /**
+     * Forward a trade to the engine, then downstream.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const md::TradeEvent &t)
+    {
+      engine_.on_trade(t);
+      downstream_.on_trade(t);
+    }
+
+    /**
+     * Forward a status update to the engine, then downstream.
+     * @param u Market status update.
+     * @return void.
+     */
+    void on_status(const md::MarketStatusUpdate &u)
+    {
+      engine_.on_status(u);
+      downstream_.on_status(u);
+    }
+
+  private:
+    MatchingEngine &engine_;
+    Downstream &downstream_;
+  };
+
+} // namespace kalshi::sim
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "kalshi/core/work_stealing_pool.hpp"
+#include "kalshi/sim/backtest.hpp"
+#include "kalshi/sim/event_log.hpp"
+
+namespace kalshi::sim
+{
+
+  /** Results of one parameter set across every log. */
+  struct SweepSummary
+  {
+    std::size_t params; // index into the grid
+    BacktestResult total;
+    std::int64_t worst_net; // lowest net of a single log
+    std::int64_t best_net;
+  };
+
+  /** Results of a sweep. */
+  struct SweepReport
+  {
+    std::size_t log_count;
+    std::size_t params_count;
+    std::vector<BacktestResult> runs;     // runs[log * params_count + params]
+    std::vector<SweepSummary> summaries;  // one per parameter set, in grid order
+  };
+
+  template <typename Params, typename Run>
+    requires std::is_invocable_r_v<BacktestResult, const Run &, const EventLog &, const Params &>
+  /**
+   * Run every (log, parameter set) pair as one job on a pool and summarize
+   * per parameter set.
+   *
+   * Jobs share the logs read-only and keep all other state to themselves,
+   * each writing its result to its own slot, so a sweep scales with the
+   * pool's workers until memory bandwidth runs out. Jobs are submitted
+   * longest log first and each worker runs its share in that order,
+   * leaving short jobs for the end, where idle workers steal the shortest
+   * and even out the finish.
+   *
+   * @param pool Pool to run on; waited on as a whole, so do not share it
+   *        with other submitters during the sweep.
+   * @param logs Event logs.
+   * @param grid Parameter sets.
+   * @param run Runs one job as run(log, params); called concurrently.
+   * @return Report.
+   */
+  SweepReport run_sweep(WorkStealingPool &pool,
+                        std::span<const EventLog> logs,
+                        std::span<const Params> grid,
+                        const Run &run)
+  {
+    SweepReport report{.log_count = logs.size(),
+                       .params_count = grid.size(),
+                       .runs = std::vector<BacktestResult>(logs.size() * grid.size()),
+                       .summaries = {}};
+
+    std::vector<std::size_t> order(logs.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](std::size_t a, std::size_t b)
+                     { return logs[a].events().size() > logs[b].events().size(); });
+    for (auto log : order)
+    {
+      for (std::size_t params = 0; params < grid.size(); ++params)
+      {
+        pool.submit([&report, &run, &logs, &grid, log, params]
+                    { report.runs[log * grid.size() + params] = run(logs[log], grid[params]); });
+      }
+    }
+    pool.wait();
+
+    report.summaries.reserve(grid.size());
+    for (std::size_t params = 0; params < grid.size(); ++params)
+    {
+      SweepSummary summary{.params = params,
+                           .total = BacktestResult{},
+                           .worst_net = INT64_MAX,
+                           .best_net = INT64_MIN};
+      for (std::size_t log = 0; log < logs.size(); ++log)
+      {
+        const auto &result = report.runs[log * grid.size() + params];
+        accumulate(summary.total, result);
+        summary.worst_net = std::min(summary.worst_net, result.net);
+        summary.best_net = std::max(summary.best_net, result.net);
+      }
+      report.summaries.push_back(summary);
+    }
+    return report;
+  }
+
+} // namespace kalshi::sim
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+#include "kalshi/strategy/pipeline.hpp"
+
+namespace kalshi::strategy
+{
+
+  /** Quoting parameters of MarketMaker. Prices in YES cents. */
+  struct MarketMakerParams
+  {
+    md::Price half_spread = 2;    // quote distance from the mid
+    std::uint32_t size = 10;      // contracts per quote
+    md::Price min_book_width = 2; // do not quote inside a tighter book
+    md::Price requote_move = 1;   // mid move that triggers a requote
+  };
+
+  /**
+   * Sample market maker: quotes a YES bid and a YES ask half_spread either
+   * side of the book mid, requoting when the mid moves by requote_move.
+   * Kalshi has no YES ask order, so the ask is sent as a NO bid at 100
+   * minus the ask. A requote cancels the market's quotes and places both
+   * sides again; a book that is one-sided or tighter than min_book_width
+   * cancels without requoting.
+   *
+   * State is one 4-byte record per market id, so on_book costs a few
+   * compares on a book update that does not move the quote.
+   */
+  class MarketMaker
+  {
+  public:
+    /**
+     * Construct with a fixed number of market slots.
+     * @param market_capacity Markets; match the pipeline's capacity.
+     * @param params Quoting parameters.
+     */
+    MarketMaker(std::uint32_t market_capacity, MarketMakerParams params)
+        : params_(params), quotes_(std::make_unique<Quote[]>(market_capacity))
+    {
+    }
+
+    /**
+     * React to a book change.
+     * @param update Book update.
+     * @param out Intent sink.
+     * @return void.
+     */
+    template <IntentSink Out>
+    void on_book(const BookUpdate &update, Out &out)
+    {
+      if (!update.top_changed)
+      {
+        return;
+      }
+      auto &quote = quotes_[update.market];
+      if (!update.best_yes || !update.best_no)
+      {
+        pull(update.market, quote, out);
+        return;
+      }
+      auto bid = static_cast<int>(*update.best_yes);
+      auto ask = static_cast<int>(md::PRICE_MAX) - static_cast<int>(*update.best_no);
+      if (ask - bid < static_cast<int>(params_.min_book_width))
+      {
+        pull(update.market, quote, out);
+        return;
+      }
+      auto mid = (bid + ask) / 2;
+      if (quote.active && std::abs(mid - static_cast<int>(quote.mid)) < static_cast<int>(params_.requote_move))
+      {
+        return;
+      }
+      auto our_bid = mid - static_cast<int>(params_.half_spread);
+      auto our_ask = mid + static_cast<int>(params_.half_spread);
+      if (our_bid < 1 || our_ask >= static_cast<int>(md::PRICE_MAX))
+      {
+        pull(update.market, quote, out);
+        return;
+      }
+
+      if (quote.active)
+      {
+        out.on_intent(cancel(update.market));
+      }
+      out.on_intent(place(update.market, md::BookSide::Yes, static_cast<md::Price>(our_bid)));
+      out.on_intent(
+          place(update.market, md::BookSide::No, static_cast<md::Price>(md::PRICE_MAX - our_ask)));
+      quote.active = true;
+      quote.mid = static_cast<md::Price>(mid);
+    }
+
+    /** Parameters in force. */
+    [[nodiscard]] const MarketMakerParams &params() const { return params_; }
+
+  private:
+    struct Quote
+    {
+      md::Price mid = 0;
+      bool active = false;
+    };
+
+    template <IntentSink Out>
+    void pull(md::MarketId market, Quote &quote, Out &out)
+    {
+      if (quote.active)
+      {
+        out.on_intent(cancel(market));
+        quote.active = false;
+      }
+    }
+
+    OrderIntent place(md::MarketId market, md::BookSide side, md::Price price) const
+    {
+      return OrderIntent{.kind = IntentKind::Place,
+                         .order = trade::OrderSpec{.market = market,
+                                                   .side = side,
+                                                   .action = trade::OrderAction::Buy,
+                                                   .price = price,
+                                                   .count = params_.size}};
+    }
+
+    static OrderIntent cancel(md::MarketId market)
+    {
+      return OrderIntent{.kind = IntentKind::CancelAll,
+                         .order = trade::OrderSpec{.market = market,
+                                                   .side = md::BookSide::Yes,
+                                                   .action = trade::OrderAction::Buy,
+                                                   .price = 0,
+                                                   .count = 0}};
+    }
+
+    MarketMakerParams params_;
+    std::unique_ptr<Quote[]> quotes_;
+  };
+
+  static_assert(Strategy<MarketMaker>);
+
+} // namespace kalshi::strategy
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/order_book.hpp"
+#include "kalshi/trade/order_gateway.hpp"
+#include "kalshi/trade/order_manager.hpp"
+#include "kalshi/trade/risk_engine.hpp"
+
+namespace kalshi::strategy
+{
+
+  /** What a strategy wants done. */
+  enum class IntentKind : std::uint8_t
+  {
+    Place,    // send order
+    CancelAll // cancel our open orders in order.market
+  };
+
+  /** Order intent emitted by a strategy. */
+  struct OrderIntent
+  {
+    IntentKind kind;
+    trade::OrderSpec order; // only market is used for CancelAll
+  };
+
+  /** Book state handed to a strategy after the book of one market changed. */
+  struct BookUpdate
+  {
+    md::MarketId market;
+    std::string_view ticker;
+    const md::OrderBook &book;
+    std::optional<md::Price> best_yes; // best YES bid
+    std::optional<md::Price> best_no;  // best NO bid; the YES ask is 100 minus it
+    md::Sequence sequence;
+    bool top_changed; // a best price or its size changed
+  };
+
+  /**
+   * Receives intents; the next stage after a strategy (risk, gateway). A
+   * stage may also define on_book(const BookUpdate &), which the pipeline
+   * calls on every top change before the strategy sees it.
+   */
+  template <typename Sink>
+  concept IntentSink = requires(Sink s, const OrderIntent &intent) {
+    { s.on_intent(intent) } -> std::same_as<void>;
+  };
+
+  /** Drops intents. Also the stand-in used to check the Strategy concept. */
+  struct NullIntentSink
+  {
+    void on_intent(const OrderIntent &) {}
+  };
+
+  /**
+   * A strategy reacts to book updates by emitting intents into the sink it
+   * is handed. on_book is a template over the sink type, so the whole
+   * chain is resolved at compile time. A strategy may also define
+   * on_trade(const md::TradeEvent &, md::MarketId, Out &) and
+   * on_status(const md::MarketStatusUpdate &, md::MarketId, Out &).
+   */
+  template <typename S>
+  concept Strategy = requires(S s, const BookUpdate &update, NullIntentSink &out) {
+    { s.on_book(update, out) } -> std::same_as<void>;
+  };
+
+  template <Strategy Strat, IntentSink Out>
+  /**
+   * Market sink that keeps a book per market and drives a strategy from it.
+   *
+   * Feed, book, strategy and the intent sink chain (typically RiskGate and
+   * an order gateway) are template parameters, so an event travels from the
+   * dispatcher to an order intent through direct, inlinable calls with no
+   * virtual dispatch. The pipeline satisfies MarketSink, so it can sit in a
+   * FanoutSink or RoutingSink next to other sinks.
+   *
+   * Market ids are interned in first-seen order and match the ids the
+   * strategy and RiskEngine see, so both can keep flat per-market tables.
+   * Market slots are preallocated; events for markets beyond the capacity
+   * are dropped and counted. Best prices are kept incrementally, so a delta
+   * below the touch costs no scan.
+   *
+   * Not thread-safe; runs on the feed thread.
+   */
+  class StrategyPipeline
+  {
+  public:
+    /**
+     * Construct with a fixed number of market slots.
+     * @param market_capacity Market slots.
+     * @param strategy Strategy to drive; must outlive the pipeline.
+     * @param out First stage after the strategy; must outlive the pipeline.
+     */
+    StrategyPipeline(std::uint32_t market_capacity, Strat &strategy, Out &out)
+        : market_capacity_(market_capacity),
+          slots_(std::make_unique<Slot[]>(market_capacity)),
+          strategy_(strategy),
+          out_(out)
+    {
+    }
+
+    /**
+     * Replace a market's book and notify the strategy.
+     * @param s Orderbook snapshot.
+     * @return void.
+     */
+    void on_snapshot(const md::OrderbookSnapshot &s)
+    {
+      auto id = market(s.market_ticker);
+      if (!id)
+      {
+        return;
+      }
+      auto &slot = slots_[*id];
+      slot.book.apply(s);
+      slot.best_yes = slot.book.best(md::BookSide::Yes);
+      slot.best_no = slot.book.best(md::BookSide::No);
+      notify(*id, slot, true);
+    }
+
+    /**
+     * Apply a delta and notify the strategy.
+     * @param d Orderbook delta.
+     * @return void.
+     */
+    void on_delta(const md::OrderbookDelta &d)
+    {
+      auto id = market(d.market_ticker);
+      if (!id)
+      {
+        return;
+      }
+      auto &slot = slots_[*id];
+      auto size = slot.book.apply(d);
+      auto &best = d.side == md::BookSide::Yes ? slot.best_yes : slot.best_no;
+      bool top_changed = false;
+      if (size > 0 && (!best || d.price >= *best))
+      {
+        best = d.price;
+        top_changed = true;
+      }
+      else if (size == 0 && best == d.price)
+      {
+        best = below(slot.book.levels(d.side), d.price);
+        top_changed = true;
+      }
+      notify(*id, slot, top_changed);
+    }
+
+    /**
+     * Forward a trade to strategies that take trades.
+     * @param t Trade event.
+     * @return void.
+     */
+    void on_trade(const md::TradeEvent &t)
+    {
+      if constexpr (requires(md::MarketId id) { strategy_.on_trade(t, id, out_); })
+      {
+        if (auto id = ids_.find(t.market_ticker))
+        {
+          strategy_.on_trade(t, *id, out_);
+        }
+      }
+    }
+
+    /**
+     * Forward a status update to strategies that take them.
+     * @param u Market status update.
+     * @return void.
+     */
+    void on_status(const md::MarketStatusUpdate &u)
+    {
+      if constexpr (requires(md::MarketId id) { strategy_.on_status(u, id, out_); })
+      {
+        if (auto id = ids_.find(u.market_ticker))
+        {
+          strategy_.on_status(u, *id, out_);
+        }
+      }
+    }
+
+    /**
+     * Id of a market.
+     * @param market_ticker Market ticker.
+     * @return Id or std::nullopt if the pipeline has not seen the market.
+     */
+    [[nodiscard]] std::optional<md::MarketId> find(std::string_view market_ticker) const
+    {
+      return ids_.find(market_ticker);
+    }
+
+    /**
+     * Book of a market.
+     * @param id Market id returned by find().
+     * @return Book.
+     */
+    [[nodiscard]] const md::OrderBook &book(md::MarketId id) const { return slots_[id].book; }
+
+    /** Events dropped because their market could not get a slot. */
+    [[nodiscard]] std::uint64_t dropped() const { return dropped_; }
+
+  private:
+    struct Slot
+    {
+      md::OrderBook book;
+      std::optional<md::Price> best_yes;
+      std::optional<md::Price> best_no;
+    };
+
+    std::optional<md::MarketId> market(std::string_view market_ticker)
+    {
+      if (auto id = ids_.find(market_ticker))
+      {
+        return id;
+      }
+      if (ids_.size() >= market_capacity_)
+      {
+        ++dropped_;
+        return std::nullopt;
+      }
+      return ids_.intern(market_ticker);
+    }
+
+    static std::optional<md::Price> below(const md::OrderBook::Levels &levels, md::Price price)
+    {
+      for (auto p = static_cast<int>(price) - 1; p >= 0; --p)
+      {
+        if (levels[static_cast<std::size_t>(p)] != 0)
+        {
+          return static_cast<md::Price>(p);
+        }
+      }
+      return std::nullopt;
+    }
+
+    void notify(md::MarketId id, const Slot &slot, bool top_changed)
+    {
+      BookUpdate update{.market = id,
+                        .ticker = ids_.ticker(id),
+                        .book = slot.book,
+                        .best_yes = slot.best_yes,
+                        .best_no = slot.best_no,
+                        .sequence = slot.book.sequence(),
+                        .top_changed = top_changed};
+      if constexpr (requires { out_.on_book(update); })
+      {
+        // Stages first, so intents from this update see the new touch.
+        if (top_changed)
+        {
+          out_.on_book(update);
+        }
+      }
+      strategy_.on_book(update, out_);
+    }
+
+    std::uint32_t market_capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    md::MarketIdTable ids_;
+    Strat &strategy_;
+    Out &out_;
+    std::uint64_t dropped_ = 0;
+  };
+
+  template <IntentSink Out>
+  /**
+   * Intent stage that runs every Place intent through RiskEngine::check.
+   * Passing orders are forwarded; rejected ones are counted and dropped.
+   * CancelAll always passes. The gateway behind the gate reserves the
+   * orders it sends and reports fills and closes back to the engine, so an
+   * order the gateway cannot send reserves nothing.
+   *
+   * On every top change the gate sets the market's risk reference to the
+   * book mid, or clears it while the book is one-sided, so the price band
+   * follows the market.
+   */
+  class RiskGate
+  {
+  public:
+    /**
+     * Construct in front of the next stage.
+     * @param risk Risk engine; must outlive the gate.
+     * @param out Next stage; must outlive the gate.
+     */
+    RiskGate(trade::RiskEngine &risk, Out &out) : risk_(risk), out_(out) {}
+
+    /**
+     * Check and forward an intent.
+     * @param intent Intent from the strategy.
+     * @return void.
+     */
+    void on_intent(const OrderIntent &intent)
+    {
+      if (intent.kind == IntentKind::Place)
+      {
+        auto checked = risk_.check(intent.order);
+        if (!checked)
+        {
+          ++rejected_;
+          last_reject_ = checked.error();
+          return;
+        }
+      }
+      out_.on_intent(intent);
+    }
+
+    /**
+     * Set the market's reference to the mid and pass the update on.
+     * @param update Book update with a changed top.
+     * @return void.
+     */
+    void on_book(const BookUpdate &update)
+    {
+      if (update.market < risk_.market_capacity())
+      {
+        md::Price mid = 0;
+        if (update.best_yes && update.best_no)
+        {
+          auto ask = static_cast<int>(md::PRICE_MAX) - static_cast<int>(*update.best_no);
+          mid = static_cast<md::Price>((static_cast<int>(*update.best_yes) + ask) / 2);
+        }
+        risk_.set_reference(update.market, mid);
+      }
+      if constexpr (requires { out_.on_book(update); })
+      {
+        out_.on_book(update);
+      }
+    }
+
+    /** Intents rejected so far. */
+    [[nodiscard]] std::uint64_t rejected() const { return rejected_; }
+
+    /** Reason of the last rejection, if any. */
+    [[nodiscard]] std::optional<trade::RiskReject> last_reject() const { return last_reject_; }
+
+  private:
+    trade::RiskEngine &risk_;
+    Out &out_;
+    std::uint64_t rejected_ = 0;
+    std::optional<trade::RiskReject> last_reject_;
+  };
+
+  template <trade::OrderGateway Gateway>
+  /**
+   * Last intent stage: turns intents into gateway calls, so the same chain
+   * drives trade::LiveGateway or sim::MatchingEngine. Place intents are
+   * placed and CancelAll intents cancel the market's open orders. Failed
+   * placements are counted and dropped.
+   */
+  class GatewaySink
+  {
+  public:
+    /**
+     * Construct on a gateway.
+     * @param gateway Order gateway; must outlive the sink.
+     */
+    explicit GatewaySink(Gateway &gateway) : gateway_(gateway) {}
+
+    /**
+     * Execute an intent.
+     * @param intent Intent from the previous stage.
+     * @return void.
+     */
+    void on_intent(const OrderIntent &intent)
+    {
+      if (intent.kind == IntentKind::CancelAll)
+      {
+        (void)gateway_.cancel_market(intent.order.market);
+        return;
+      }
+      auto placed = gateway_.place(intent.order);
+      if (!placed)
+      {
+        ++failed_;
+        last_error_ = placed.error();
+      }
+    }
+
+    /** Place intents the gateway refused. */
+    [[nodiscard]] std::uint64_t failed() const { return failed_; }
+
+    /** Reason of the last refusal, if any. */
+    [[nodiscard]] std::optional<trade::GatewayError> last_error() const { return last_error_; }
+
+  private:
+    Gateway &gateway_;
+    std::uint64_t failed_ = 0;
+    std::optional<trade::GatewayError> last_error_;
+  };
+
+} // namespace kalshi::strategy
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/trade/order_gateway.hpp"
+#include "kalshi/trade/order_manager.hpp"
+#include "kalshi/trade/rest_client.hpp"
+#include "kalshi/trade/risk_engine.hpp"
+
+namespace kalshi::trade
+{
+
+  /** Counters of LiveGateway. */
+  struct LiveGatewayStats
+  {
+    std::uint64_t placed;
+    std::uint64_t rejected;  // refused by the exchange (HTTP 400+) or never sent
+    std::uint64_t unconfirmed; // place response lost in transit; left pending for user_orders
+    std::uint64_t cancels_sent;
+    std::uint64_t cancels_failed; // not sent or refused; the order can be canceled again
+    std::uint64_t fills;
+    std::uint64_t unmatched; // fill or order updates for orders we do not track
+  };
+
+  /**
+   * OrderGateway on the exchange: orders go out through RestClient and
+   * their lifecycle comes back from the authenticated feed channels.
+   *
+   * - Acks and cancels arrive as user_orders updates (on_user_order);
+   *   a cancel asked for before the exchange order id is known (ack not
+   *   yet seen, even if a fill overtook it) is sent once the ack arrives,
+   *   since the exchange cancels by its own order id.
+   * - A cancel that cannot be sent, or that the exchange refuses, is
+   *   forgotten so the order can be canceled again.
+   * - Fills arrive on the fill channel (on_fill).
+   * - An order the exchange refuses over REST (HTTP 400 or above) is
+   *   rejected in the response callback. A place whose response is lost
+   *   (read failure, timeout) may still have reached the exchange, so the
+   *   order stays pending with its risk reservation until a user_orders
+   *   update or fill settles it.
+   *
+   * Updates are matched to orders by client order id. Orders are released
+   * once terminal, so the pool only holds working orders. All calls,
+   * including RestClient callbacks, must come from the thread running the
+   * client's io_context (the feed and REST client share it in AppContext).
+   */
+  class LiveGateway
+  {
+  public:
+    /** Ticker of a market id, empty if unknown. */
+    using TickerLookup = std::function<std::string_view(md::MarketId)>;
+
+    /**
+     * Construct on a REST client.
+     * @param rest REST client; must outlive the gateway.
+     * @param ticker Ticker of a market id, as numbered by the strategy.
+     * @param market_capacity Market slots.
+     * @param order_capacity Maximum working orders.
+     * @param client_id_prefix Prefix of client order ids; see OrderManager.
+     */
+    LiveGateway(RestClient &rest,
+                TickerLookup ticker,
+                std::uint32_t market_capacity,
+                std::uint32_t order_capacity,
+                std::string_view client_id_prefix);
+
+    /**
+     * Report reservations, fills and closes to a risk engine.
+     * @param risk Risk engine, or nullptr to stop; must outlive the gateway.
+     * @return void.
+     */
+    void set_risk_engine(RiskEngine *risk) { risk_ = risk; }
+
+    /**
+     * Create an order and send it.
+     * @param spec Order to place.
+     * @return Handle or GatewayError.
+     */
+    [[nodiscard]] std::expected<OrderHandle, GatewayError> place(const OrderSpec &spec);
+
+    /**
+     * Ask the exchange to cancel an order.
+     * @param handle Order handle.
+     * @return Nothing or GatewayError.
+     */
+    [[nodiscard]] std::expected<void, GatewayError> cancel(OrderHandle handle);
+
+    /**
+     * Ask the exchange to cancel every open order in a market.
+     * @param market Market id.
+     * @return Orders asked to cancel.
+     */
+    std::size_t cancel_market(md::MarketId market);
+
+    /**
+     * Apply an update from the user_orders channel.
+     * @param event Order update.
+     * @return void.
+     */
+    void on_user_order(const md::UserOrderEvent &event);
+
+    /**
+     * Apply a fill from the fill channel.
+     * @param event Fill.
+     * @return void.
+     */
+    void on_fill(const md::FillEvent &event);
+
+    /** Order states. */
+    [[nodiscard]] const OrderManager &orders() const { return orders_; }
+
+    /** Counters. */
+    [[nodiscard]] const LiveGatewayStats &stats() const { return stats_; }
+
+  private:
+    std::expected<void, GatewayError> send_cancel(OrderHandle handle, const Order &order);
+    void cancel_failed(OrderHandle handle);
+    void reject(OrderHandle handle);
+    void close(OrderHandle handle, const Order &order);
+    const Order *lookup(const std::optional<std::string> &client_order_id,
+                        OrderHandle &handle);
+
+    RestClient &rest_;
+    TickerLookup ticker_;
+    OrderManager orders_;
+    OpenOrderIndex open_;
+    RiskEngine *risk_ = nullptr;
+    LiveGatewayStats stats_{};
+  };
+
+  static_assert(OrderGateway<LiveGateway>);
+
+} // namespace kalshi::trade
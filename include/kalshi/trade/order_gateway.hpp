@@ -0,0 +1,178 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <utility>
+
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/trade/order_manager.hpp"
+
+namespace kalshi::trade
+{
+
+  /** Why a gateway could not take an order action. */
+  enum class GatewayError
+  {
+    UnknownMarket,
+    InvalidOrder,
+    PoolExhausted,
+    UnknownOrder,
+    AlreadyCanceling,
+    SendFailed
+  };
+
+  /**
+   * Stable name of a GatewayError for logs.
+   * @param error Error value.
+   * @return Static string.
+   */
+  [[nodiscard]] const char *to_string(GatewayError error);
+
+  /**
+   * Order entry API shared by the live exchange path and the simulator, so
+   * a strategy chain runs unchanged against either.
+   *
+   * - place(spec) creates the order in the gateway's OrderManager and sends
+   *   it. The handle stays valid until the order is terminal; the gateway
+   *   releases terminal orders itself.
+   * - cancel(handle) asks for one order to be canceled.
+   * - cancel_market(market) asks for every open order in a market to be
+   *   canceled and returns how many were asked.
+   * - orders() exposes the order states.
+   *
+   * A gateway given a RiskEngine reserves each order with on_sent() when it
+   * is placed and reports fills and closes back, so the engine's counters
+   * track the gateway's open orders.
+   */
+  template <typename G>
+  concept OrderGateway =
+      requires(G g, const OrderSpec &spec, OrderHandle handle, md::MarketId market) {
+        { g.place(spec) } -> std::same_as<std::expected<OrderHandle, GatewayError>>;
+        { g.cancel(handle) } -> std::same_as<std::expected<void, GatewayError>>;
+        { g.cancel_market(market) } -> std::same_as<std::size_t>;
+        { std::as_const(g).orders() } -> std::same_as<const OrderManager &>;
+      };
+
+  /**
+   * Spec an order was created from.
+   * @param order Tracked order.
+   * @return Order spec.
+   */
+  [[nodiscard]] inline OrderSpec spec_of(const Order &order)
+  {
+    return OrderSpec{.market = order.market,
+                     .side = order.side,
+                     .action = order.action,
+                     .price = order.price,
+                     .count = order.count};
+  }
+
+  /**
+   * Open orders per market, in placement order, as intrusive lists over
+   * the OrderManager's slot indices. Insert and erase are O(1) and nothing
+   * allocates after construction. Not thread-safe.
+   */
+  class OpenOrderIndex
+  {
+  public:
+    /**
+     * Construct for fixed market and order capacities.
+     * @param market_capacity Market slots.
+     * @param order_capacity OrderManager capacity.
+     */
+    OpenOrderIndex(std::uint32_t market_capacity, std::uint32_t order_capacity)
+        : market_capacity_(market_capacity),
+          heads_(std::make_unique<Ends[]>(market_capacity)),
+          links_(std::make_unique<Link[]>(order_capacity))
+    {
+    }
+
+    /**
+     * Append an order to its market's list.
+     * @param market Market id; must be below the market capacity.
+     * @param handle Order not in any list.
+     * @return void.
+     */
+    void insert(md::MarketId market, OrderHandle handle)
+    {
+      auto &ends = heads_[market];
+      auto &link = links_[handle.index];
+      link = Link{.handle = handle, .prev = ends.tail, .next = NONE};
+      if (ends.tail == NONE)
+      {
+        ends.head = handle.index;
+      }
+      else
+      {
+        links_[ends.tail].next = handle.index;
+      }
+      ends.tail = handle.index;
+    }
+
+    /**
+     * Remove an order from its market's list.
+     * @param market Market the order was inserted under.
+     * @param handle Order in the list.
+     * @return void.
+     */
+    void erase(md::MarketId market, OrderHandle handle)
+    {
+      auto &ends = heads_[market];
+      const auto &link = links_[handle.index];
+      (link.prev == NONE ? ends.head : links_[link.prev].next) = link.next;
+      (link.next == NONE ? ends.tail : links_[link.next].prev) = link.prev;
+    }
+
+    /**
+     * Visit a market's open orders oldest first. The visitor may erase the
+     * order it is handed.
+     * @param market Market id.
+     * @param visit Callable taking an OrderHandle.
+     * @return void.
+     */
+    template <typename Visit>
+    void for_each(md::MarketId market, Visit &&visit) const
+    {
+      for (auto index = heads_[market].head; index != NONE;)
+      {
+        const auto &link = links_[index];
+        index = link.next;
+        visit(link.handle);
+      }
+    }
+
+    /**
+     * Whether a market has open orders.
+     * @param market Market id.
+     * @return True if none.
+     */
+    [[nodiscard]] bool empty(md::MarketId market) const { return heads_[market].head == NONE; }
+
+    /** Market slots. */
+    [[nodiscard]] std::uint32_t market_capacity() const { return market_capacity_; }
+
+  private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Ends
+    {
+      std::uint32_t head = NONE;
+      std::uint32_t tail = NONE;
+    };
+
+    struct Link
+    {
+      OrderHandle handle;
+      std::uint32_t prev;
+      std::uint32_t next;
+    };
+
+    std::uint32_t market_capacity_;
+    std::unique_ptr<Ends[]> heads_;
+    std::unique_ptr<Link[]> links_;
+  };
+
+} // namespace kalshi::trade
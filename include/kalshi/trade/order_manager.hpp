@@ -0,0 +1,314 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/types.hpp"
+#include "kalshi/trade/order_types.hpp"
+
+namespace kalshi::trade
+{
+
+  /**
+   * Order lifecycle. Pending until the exchange answers; Filled, Canceled
+   * and Rejected are terminal.
+   *
+   *   Pending -> Acked | PartiallyFilled | Filled | Canceled | Rejected
+   *   Acked -> PartiallyFilled | Filled | Canceled
+   *   PartiallyFilled -> PartiallyFilled | Filled | Canceled
+   *
+   * A fill may arrive before the ack, so Pending can fill directly.
+   */
+  enum class OrderState : std::uint8_t
+  {
+    Pending,
+    Acked,
+    PartiallyFilled,
+    Filled,
+    Canceled,
+    Rejected
+  };
+
+  /** Order manager errors. */
+  enum class OrderError
+  {
+    PoolExhausted,
+    IdTooLong,
+    DuplicateClientOrderId,
+    UnknownOrder,
+    InvalidTransition,
+    Overfill
+  };
+
+  /**
+   * Stable name of an OrderState for logs.
+   * @param state State value.
+   * @return Static string.
+   */
+  [[nodiscard]] const char *to_string(OrderState state);
+
+  /**
+   * Stable name of an OrderError for logs.
+   * @param error Error value.
+   * @return Static string.
+   */
+  [[nodiscard]] const char *to_string(OrderError error);
+
+  /**
+   * Whether the state machine allows a transition.
+   * @param from Current state.
+   * @param to Next state.
+   * @return True if allowed.
+   */
+  [[nodiscard]] bool can_transition(OrderState from, OrderState to);
+
+  /**
+   * Whether a state is terminal.
+   * @param state State value.
+   * @return True for Filled, Canceled and Rejected.
+   */
+  [[nodiscard]] inline constexpr bool is_terminal(OrderState state)
+  {
+    return state == OrderState::Filled || state == OrderState::Canceled ||
+           state == OrderState::Rejected;
+  }
+
+  /** Longest client or exchange order id kept inline (UUIDs are 36). */
+  inline constexpr std::size_t ORDER_ID_CAPACITY = 47;
+
+  /** Longest generated-id prefix; leaves room for a 20-digit sequence. */
+  inline constexpr std::size_t CLIENT_ID_PREFIX_CAPACITY = ORDER_ID_CAPACITY - 20;
+
+  /** Order id stored inline, so orders never own heap memory. */
+  class InlineOrderId
+  {
+  public:
+    /**
+     * Replace the id.
+     * @param id New id.
+     * @return False (and unchanged) if id exceeds ORDER_ID_CAPACITY.
+     */
+    bool assign(std::string_view id)
+    {
+      if (id.size() > ORDER_ID_CAPACITY)
+      {
+        return false;
+      }
+      id.copy(chars_.data(), id.size());
+      length_ = static_cast<std::uint8_t>(id.size());
+      return true;
+    }
+
+    /** View of the id. */
+    [[nodiscard]] std::string_view view() const { return {chars_.data(), length_}; }
+
+  private:
+    std::array<char, ORDER_ID_CAPACITY> chars_{};
+    std::uint8_t length_ = 0;
+  };
+
+  /** Order as tracked by OrderManager. */
+  struct Order
+  {
+    InlineOrderId client_order_id;
+    InlineOrderId order_id; // exchange id, set on ack
+    md::MarketId market;
+    md::BookSide side;
+    OrderAction action;
+    OrderState state;
+    bool cancel_requested;
+    md::Price price;
+    std::uint32_t count;
+    std::uint32_t filled;
+  };
+
+  /** What to place; the manager assigns the client order id. */
+  struct OrderSpec
+  {
+    md::MarketId market;
+    md::BookSide side;
+    OrderAction action;
+    md::Price price;
+    std::uint32_t count;
+  };
+
+  /**
+   * Reference to a pooled order. The generation makes handles to released
+   * slots fail lookups instead of aliasing the slot's next order.
+   */
+  struct OrderHandle
+  {
+    std::uint32_t index;
+    std::uint32_t generation;
+  };
+
+  /**
+   * Owns every live order in a pool allocated once at construction, so the
+   * trading path never touches the heap.
+   *
+   * Free slots form an intrusive singly linked list through the slots
+   * themselves. Client order ids are indexed by an open-addressing table
+   * sized to twice the pool, with linear probing and backward-shift
+   * deletion, so create, lookup, transition and release are all O(1).
+   * Client order ids are the prefix given at construction followed by a
+   * decimal sequence number, or adopted from the caller (e.g. to rebuild
+   * state from the exchange after a restart).
+   *
+   * Orders in terminal states keep their slot until release(), so their
+   * final state stays readable. Not thread-safe.
+   */
+  class OrderManager
+  {
+  public:
+    /**
+     * Construct a manager with a fixed pool.
+     * @param capacity Maximum live orders.
+     * @param client_id_prefix Prefix of generated client order ids; keep it
+     *        unique per session so ids never repeat across restarts. At most
+     *        CLIENT_ID_PREFIX_CAPACITY characters are used.
+     */
+    OrderManager(std::uint32_t capacity, std::string_view client_id_prefix);
+
+    /**
+     * Create a Pending order with a generated client order id.
+     * @param spec Order to create.
+     * @return Handle or OrderError::PoolExhausted.
+     */
+    [[nodiscard]] std::expected<OrderHandle, OrderError> create(const OrderSpec &spec);
+
+    /**
+     * Create a Pending order with a given client order id.
+     * @param spec Order to create.
+     * @param client_order_id Id to use.
+     * @return Handle or OrderError.
+     */
+    [[nodiscard]] std::expected<OrderHandle, OrderError> adopt(const OrderSpec &spec,
+                                                               std::string_view client_order_id);
+
+    /**
+     * Look up a live order by client order id.
+     * @param client_order_id Client order id.
+     * @return Handle or std::nullopt.
+     */
+    [[nodiscard]] std::optional<OrderHandle> find(std::string_view client_order_id) const;
+
+    /**
+     * Order behind a handle.
+     * @param handle Handle from create(), adopt() or find().
+     * @return Order or nullptr if the handle is stale.
+     */
+    [[nodiscard]] const Order *get(OrderHandle handle) const;
+
+    /**
+     * Exchange accepted the order.
+     * @param handle Order handle.
+     * @param order_id Exchange order id.
+     * @return New state or OrderError.
+     */
+    std::expected<OrderState, OrderError> on_ack(OrderHandle handle, std::string_view order_id);
+
+    /**
+     * Contracts filled.
+     * @param handle Order handle.
+     * @param count Contracts in this fill.
+     * @return PartiallyFilled, Filled or OrderError (Overfill if the
+     *         total would exceed the order count).
+     */
+    std::expected<OrderState, OrderError> on_fill(OrderHandle handle, std::uint32_t count);
+
+    /**
+     * Exchange canceled the order (on request, expiry or market close).
+     * @param handle Order handle.
+     * @return New state or OrderError.
+     */
+    std::expected<OrderState, OrderError> on_cancel(OrderHandle handle);
+
+    /**
+     * Exchange rejected the order.
+     * @param handle Order handle.
+     * @return New state or OrderError.
+     */
+    std::expected<OrderState, OrderError> on_reject(OrderHandle handle);
+
+    /**
+     * Record that a cancel was sent, so it is not sent twice.
+     * @param handle Order handle.
+     * @return False if the order is unknown, terminal or already canceling.
+     */
+    bool request_cancel(OrderHandle handle);
+
+    /**
+     * Forget a cancel that could not be sent or was refused, so it can be
+     * asked for again.
+     * @param handle Order handle.
+     * @return False if the order is unknown or was not canceling.
+     */
+    bool clear_cancel(OrderHandle handle);
+
+    /**
+     * Return an order's slot to the pool and drop it from the index. Any
+     * handle to it becomes stale.
+     * @param handle Order handle.
+     * @return False if the handle was already stale.
+     */
+    bool release(OrderHandle handle);
+
+    /**
+     * Wire request for an order.
+     * @param handle Order handle.
+     * @param ticker Ticker of the order's market.
+     * @return OrderRequest viewing the order's client order id, or
+     *         std::nullopt if the handle is stale.
+     */
+    [[nodiscard]] std::optional<OrderRequest> request(OrderHandle handle,
+                                                      std::string_view ticker) const;
+
+    /** Orders holding a slot. */
+    [[nodiscard]] std::uint32_t live() const { return live_; }
+
+    /** Pool size. */
+    [[nodiscard]] std::uint32_t capacity() const { return capacity_; }
+
+  private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Slot
+    {
+      Order order;
+      std::uint32_t hash;      // client order id hash, as stored in the index
+      std::uint32_t generation;
+      std::uint32_t next_free; // NONE while the slot is in use
+    };
+
+    /** Index entry. The hash lets probes skip mismatches without touching the slot. */
+    struct Bucket
+    {
+      std::uint32_t slot; // NONE if empty
+      std::uint32_t hash;
+    };
+
+    Order *live_order(OrderHandle handle);
+    std::expected<OrderState, OrderError> transition(OrderHandle handle, OrderState to);
+    static std::uint32_t hash(std::string_view client_order_id);
+    std::optional<std::size_t> find_bucket(std::string_view client_order_id) const;
+    void erase_bucket(std::size_t bucket);
+
+    std::uint32_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::uint32_t free_head_;
+    std::uint32_t live_ = 0;
+
+    std::unique_ptr<Bucket[]> index_;
+    std::uint32_t index_mask_;
+
+    InlineOrderId prefix_;
+    std::uint64_t next_sequence_ = 1;
+  };
+
+} // namespace kalshi::trade
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "kalshi/md/model/types.hpp"
+
+namespace kalshi::trade
+{
+
+  /** Shared with the fill events decoded by the feed. */
+  using OrderAction = md::OrderAction;
+
+  /**
+   * Limit order to place. Views must stay valid until the request has been
+   * serialized, which happens inside the call that takes the request.
+   */
+  struct OrderRequest
+  {
+    std::string_view ticker;
+    std::string_view client_order_id;
+    md::BookSide side;
+    OrderAction action;
+    std::uint32_t count;
+    md::Price price; // limit price in cents of the order's side
+  };
+
+  /**
+   * Wire name of a side.
+   * @param side Order side.
+   * @return "yes" or "no".
+   */
+  [[nodiscard]] inline constexpr std::string_view to_wire(md::BookSide side)
+  {
+    return side == md::BookSide::Yes ? "yes" : "no";
+  }
+
+  /**
+   * Wire name of an action.
+   * @param action Order action.
+   * @return "buy" or "sell".
+   */
+  [[nodiscard]] inline constexpr std::string_view to_wire(OrderAction action)
+  {
+    return action == OrderAction::Buy ? "buy" : "sell";
+  }
+
+} // namespace kalshi::trade
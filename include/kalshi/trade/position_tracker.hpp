@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "kalshi/md/model/book_views.hpp"
+#include "kalshi/md/model/exchange_events.hpp"
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/types.hpp"
+
+namespace kalshi::trade
+{
+
+  /**
+   * Exchange fee rates in basis points. A fill of C contracts at P dollars
+   * costs rate * C * P * (1 - P), rounded up to the next cent.
+   */
+  struct FeeSchedule
+  {
+    std::uint32_t taker_bps = 700;
+    std::uint32_t maker_bps = 0;
+  };
+
+  /**
+   * Filled position of one market. Positions and prices are in YES terms
+   * (buying NO at p is selling YES at 100 - p); money is in cents.
+   */
+  struct MarketPosition
+  {
+    std::int32_t position; // YES-equivalent contracts, negative when short
+    std::int64_t cost;     // entry cost of the open position, signed like it
+    std::int64_t realized; // closed P&L before fees
+    std::int64_t fees;
+    std::uint64_t volume;  // contracts filled
+    md::MarketId view;     // BookViews id, NO_VIEW until the feed has the market
+    std::uint16_t mid_x2;  // last consistent mid in half cents, 0 if none
+  };
+
+  /** A position marked at the book mid, in cents. */
+  struct PositionMark
+  {
+    std::int32_t position;
+    std::int64_t realized;
+    std::int64_t unrealized; // at mid; 0 when not marked
+    std::int64_t fees;
+    bool marked;             // false if no two-sided book has been seen
+  };
+
+  /**
+   * Position and P&L per market from our own fills.
+   *
+   * A fill updates one record in place: the position and its entry cost
+   * move by the filled contracts, and the part of the fill that reduces
+   * the position realizes P&L against the average entry price. Realized
+   * P&L and fees are kept as running totals, so a fill is one id lookup
+   * and a few integer operations. The entry cost of a position that
+   * closes to flat is released exactly, so rounding never accumulates.
+   *
+   * Unrealized P&L is computed on demand at the mid of the market's
+   * BookViews top of book. The top is read with one seqlock try_read: the
+   * tracker never waits on the feed thread, and if the read overlaps a
+   * write it keeps the last consistent mid instead.
+   *
+   * Not thread-safe; fills and marks come from one thread, which may
+   * differ from the feed thread that writes the views.
+   */
+  class PositionTracker
+  {
+  public:
+    /** MarketPosition::view of a market the feed has not seen yet. */
+    static constexpr md::MarketId NO_VIEW = static_cast<md::MarketId>(-1);
+
+    /**
+     * Construct against the feed's book views.
+     * @param views Views to read mids from; must outlive the tracker.
+     * @param fees Fee rates.
+     */
+    PositionTracker(const md::BookViews &views, FeeSchedule fees);
+
+    /**
+     * Apply one of our fills.
+     * @param fill Fill event.
+     * @return The market's updated record.
+     */
+    const MarketPosition &on_fill(const md::FillEvent &fill);
+
+    /**
+     * Set a market's position, e.g. from the exchange at startup. Realized
+     * P&L and fees are kept.
+     * @param market_ticker Market ticker.
+     * @param position YES-equivalent contracts.
+     * @param cost Entry cost of that position in cents, signed like it.
+     * @return void.
+     */
+    void set_position(std::string_view market_ticker, std::int32_t position, std::int64_t cost);
+
+    /**
+     * Tracker id of a market.
+     * @param market_ticker Market ticker.
+     * @return Id or std::nullopt if the market has no fills.
+     */
+    [[nodiscard]] std::optional<md::MarketId> find(std::string_view market_ticker) const;
+
+    /**
+     * Mark a market at the current book mid.
+     * @param id Tracker id below market_count().
+     * @return Mark.
+     */
+    [[nodiscard]] PositionMark mark(md::MarketId id);
+
+    /**
+     * Mark every market and sum the results. O(markets).
+     * @return Totals; marked is false if any open position lacked a mid.
+     */
+    [[nodiscard]] PositionMark mark_all();
+
+    /**
+     * Record of a market.
+     * @param id Tracker id below market_count().
+     * @return Record.
+     */
+    [[nodiscard]] const MarketPosition &position(md::MarketId id) const { return positions_[id]; }
+
+    /**
+     * Ticker of a market.
+     * @param id Tracker id below market_count().
+     * @return Ticker.
+     */
+    [[nodiscard]] const std::string &ticker(md::MarketId id) const { return ids_.ticker(id); }
+
+    /** Markets with a record. */
+    [[nodiscard]] std::size_t market_count() const { return positions_.size(); }
+
+    /** Realized P&L across markets before fees, in cents. */
+    [[nodiscard]] std::int64_t realized() const { return realized_; }
+
+    /** Fees across markets, in cents. */
+    [[nodiscard]] std::int64_t fees() const { return fees_; }
+
+    /**
+     * Fee for a fill.
+     * @param schedule Fee rates.
+     * @param yes_price Execution price in YES cents.
+     * @param count Contracts.
+     * @param is_taker Whether the fill took liquidity.
+     * @return Cents, rounded up.
+     */
+    [[nodiscard]] static std::int64_t fee(const FeeSchedule &schedule,
+                                          md::Price yes_price,
+                                          md::Count count,
+                                          bool is_taker);
+
+  private:
+    MarketPosition &record(std::string_view market_ticker);
+    std::uint16_t mid_x2(MarketPosition &p);
+
+    const md::BookViews &views_;
+    md::BookViewIndex view_index_;
+    FeeSchedule fee_schedule_;
+    md::MarketIdTable ids_;
+    std::vector<MarketPosition> positions_;
+    std::int64_t realized_ = 0;
+    std::int64_t fees_ = 0;
+  };
+
+} // namespace kalshi::trade
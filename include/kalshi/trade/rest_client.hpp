@@ -0,0 +1,268 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+#include "kalshi/core/auth.hpp"
+#include "kalshi/core/rate_limiter.hpp"
+#include "kalshi/md/ws/connection_cache.hpp"
+#include "kalshi/trade/order_types.hpp"
+
+namespace kalshi::trade
+{
+
+  /** REST connection and request errors. */
+  enum class RestError
+  {
+    InvalidUrl,
+    NotStarted,
+    NoIdleConnection,
+    ResolveFailed,
+    ConnectFailed,
+    TlsHandshakeFailed,
+    SigningFailed,
+    WriteFailed,
+    ReadFailed,
+    RateLimited
+  };
+
+  /**
+   * Stable name of a RestError for logs.
+   * @param error Error value.
+   * @return Static string.
+   */
+  [[nodiscard]] const char *to_string(RestError error);
+
+  /** HTTPS URL prefix. */
+  inline constexpr std::string_view HTTPS_PREFIX = "https://";
+  /** Order collection path, relative to the API base path. */
+  inline constexpr std::string_view ORDERS_PATH = "/portfolio/orders";
+  /** Unauthenticated path used to keep idle connections warm. */
+  inline constexpr std::string_view EXCHANGE_STATUS_PATH = "/exchange/status";
+  /** Bytes reserved per connection for a serialized request. */
+  inline constexpr std::size_t REQUEST_RESERVE = 2048;
+
+  /** Parsed REST base URL parts. */
+  struct RestUrl
+  {
+    std::string host;
+    std::string port;
+    std::string base_path; // e.g. /trade-api/v2, no trailing slash
+  };
+
+  /**
+   * Parse https://host[:port][/base] into host/port/base path.
+   * @param url REST base URL.
+   * @return RestUrl or RestError::InvalidUrl.
+   */
+  [[nodiscard]] std::expected<RestUrl, RestError> parse_rest_url(std::string_view url);
+
+  /**
+   * Append the JSON body of a create-order request to out.
+   * @param order Order to serialize.
+   * @param out Buffer to append to.
+   * @return void.
+   */
+  void serialize_order(const OrderRequest &order, std::string &out);
+
+  /** Options for RestClient. */
+  struct RestClientOptions
+  {
+    std::string base_url = "https://api.elections.kalshi.com/trade-api/v2";
+    std::size_t pool_size = 4;
+    std::chrono::milliseconds connect_timeout{5000};
+    std::chrono::milliseconds request_timeout{2000};
+    std::chrono::milliseconds keepalive_interval{15000}; // idle time before a warming request
+    std::chrono::milliseconds reconnect_delay{500};
+    std::chrono::milliseconds presigned_max_age{4000};
+  };
+
+  /** Response to a request. The body view is valid only inside the callback. */
+  struct RestResponse
+  {
+    unsigned status;
+    std::string_view body;
+  };
+
+  /**
+   * HTTPS client for the order endpoints, built on a pool of persistent
+   * keep-alive TLS connections.
+   *
+   * start() opens every connection up front, so a request never pays for
+   * DNS, TCP or TLS. Each request takes an idle connection, serializes into
+   * that connection's reused buffer and is written as raw bytes: the request
+   * line and the static headers are built once, and only the auth headers,
+   * Content-Length and body are added per request. Auth headers come from
+   * the signer's presigned cache when a fresh set is there (the signature
+   * covers timestamp, method and path but not the body, so an AuthPresigner
+   * can keep POST orders_path() signed). Otherwise the request is signed
+   * inline. Connections idle for keepalive_interval send an unauthenticated
+   * GET to keep the TCP and TLS state warm. A connection that fails or is
+   * closed by the server reconnects after reconnect_delay.
+   *
+   * All calls and callbacks happen on the IO context thread. The client must
+   * outlive the IO context's pending handlers, as with WsClient.
+   */
+  class RestClient
+  {
+  public:
+    using ResponseCallback = std::function<void(std::expected<RestResponse, RestError>)>;
+    using ErrorCallback = std::function<void(RestError, std::string_view)>;
+
+    /**
+     * Construct a client. Nothing connects until start().
+     * @param ioc IO context.
+     * @param ssl_ctx Client SSL context.
+     * @param signer Request signer.
+     * @param options Client options.
+     */
+    RestClient(boost::asio::io_context &ioc,
+               boost::asio::ssl::context &ssl_ctx,
+               std::shared_ptr<kalshi::AuthSigner> signer,
+               RestClientOptions options);
+    ~RestClient();
+
+    RestClient(const RestClient &) = delete;
+    RestClient &operator=(const RestClient &) = delete;
+
+    /**
+     * Register callback for connection failures outside a request
+     * (connect, TLS, keepalive). Request failures go to the request's
+     * callback.
+     * @param cb Callback to invoke.
+     * @return void.
+     */
+    void set_error_callback(ErrorCallback cb);
+
+    /**
+     * Share DNS results and TLS sessions through a cache, so reconnects
+     * skip DNS and resume TLS. The cache must outlive the client.
+     * @param cache Connection cache, or nullptr to disable.
+     * @return void.
+     */
+    void set_connection_cache(md::ConnectionCache *cache);
+
+    /**
+     * Charge requests to the limiter's RestRead (GET) or RestWrite (other
+     * methods) bucket. A request without a token fails at once with
+     * RestError::RateLimited instead of queueing, so a stale order is
+     * never sent late; the caller decides whether to retry. Only requests
+     * that are issued are charged: one that fails earlier (no idle
+     * connection, signing error) keeps its token. Keepalive requests are
+     * unauthenticated and not charged. The limiter must
+     * outlive the client.
+     * @param limiter Rate limiter, or nullptr for no limit.
+     * @return void.
+     */
+    void set_rate_limiter(kalshi::RateLimiter *limiter);
+
+    /**
+     * Parse the base URL and open every pool connection.
+     * @return void or RestError::InvalidUrl.
+     */
+    [[nodiscard]] std::expected<void, RestError> start();
+
+    /**
+     * Close every connection and stop reconnecting.
+     * @return void.
+     */
+    void stop();
+
+    /**
+     * Place a limit order (POST orders_path()).
+     * @param order Order to place.
+     * @param cb Called with the response or a RestError.
+     * @return void, or RestError if the request could not be issued (cb is
+     *         not called in that case).
+     */
+    [[nodiscard]] std::expected<void, RestError> create_order(const OrderRequest &order,
+                                                              ResponseCallback cb);
+
+    /**
+     * Cancel an order (DELETE orders_path()/order_id).
+     * @param order_id Exchange order id.
+     * @param cb Called with the response or a RestError.
+     * @return void, or RestError if the request could not be issued.
+     */
+    [[nodiscard]] std::expected<void, RestError> cancel_order(std::string_view order_id,
+                                                              ResponseCallback cb);
+
+    /**
+     * Send a signed request on an idle connection.
+     * @param method HTTP method.
+     * @param path Path relative to the base path (e.g. ORDERS_PATH).
+     * @param body Request body; empty for none.
+     * @param cb Called with the response or a RestError.
+     * @return void, or RestError if the request could not be issued.
+     */
+    [[nodiscard]] std::expected<void, RestError> send(std::string_view method,
+                                                      std::string_view path,
+                                                      std::string_view body,
+                                                      ResponseCallback cb);
+
+    /** Full order path, as signed; valid after start(). */
+    [[nodiscard]] const std::string &orders_path() const { return orders_path_; }
+
+    /** Connections ready to take a request. */
+    [[nodiscard]] std::size_t idle_connections() const;
+
+    /** Requests signed inline because no fresh presigned set was cached. */
+    [[nodiscard]] std::uint64_t inline_signatures() const { return inline_signatures_; }
+
+    /** Connections (re)opened since start(), including the initial ones. */
+    [[nodiscard]] std::uint64_t connects() const { return connects_; }
+
+  private:
+    struct Connection;
+
+    void connect(Connection &conn);
+    void on_resolve(Connection &conn, boost::asio::ip::tcp::resolver::results_type results);
+    void on_connect(Connection &conn, boost::system::error_code ec);
+    void on_handshake(Connection &conn, boost::system::error_code ec);
+    void on_write(Connection &conn, boost::system::error_code ec);
+    void on_read(Connection &conn, boost::system::error_code ec);
+    void arm_keepalive(Connection &conn);
+    void on_keepalive(Connection &conn);
+    void issue(Connection &conn, ResponseCallback cb);
+    void fail(Connection &conn, RestError err, std::string_view msg);
+    void close(Connection &conn);
+    void schedule_reconnect(Connection &conn);
+    Connection *idle_connection();
+    std::expected<void, RestError> append_auth(std::string &out, std::string_view method);
+    void begin_request(std::string &out, std::string_view method, std::string_view path);
+    static void end_request(std::string &out, std::string_view body);
+
+    boost::asio::io_context &ioc_;
+    boost::asio::ssl::context &ssl_ctx_;
+    boost::asio::ip::tcp::resolver resolver_;
+    std::shared_ptr<kalshi::AuthSigner> signer_;
+    RestClientOptions options_;
+    md::ConnectionCache *cache_ = nullptr;
+    kalshi::RateLimiter *rate_limiter_ = nullptr;
+    ErrorCallback on_error_;
+
+    RestUrl url_;
+    std::string orders_path_;
+    std::string header_block_; // static headers, serialized once
+    std::string full_path_;    // path of the request being built, as signed
+    std::string path_scratch_; // relative path for cancels
+    std::string body_scratch_; // order body
+    std::vector<std::unique_ptr<Connection>> pool_;
+    bool started_ = false;
+    bool stopped_ = false;
+    std::uint64_t inline_signatures_ = 0;
+    std::uint64_t connects_ = 0;
+  };
+
+} // namespace kalshi::trade
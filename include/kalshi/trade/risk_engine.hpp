@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+
+#include "kalshi/md/model/market_id.hpp"
+#include "kalshi/md/model/types.hpp"
+#include "kalshi/trade/order_manager.hpp"
+
+namespace kalshi::trade
+{
+
+  /** Why a pre-trade check failed. */
+  enum class RiskReject
+  {
+    UnknownMarket,
+    MarketHalted,
+    PriceOutOfRange,
+    OrderSize,
+    NoReference,
+    PriceBand,
+    PositionLimit,
+    MarketNotional,
+    TotalNotional,
+    MarketOpenOrders,
+    TotalOpenOrders
+  };
+
+  /**
+   * Stable name of a RiskReject for logs.
+   * @param reject Reject reason.
+   * @return Static string.
+   */
+  [[nodiscard]] const char *to_string(RiskReject reject);
+
+  /** Limits applied to every market. Notional is in cents. */
+  struct RiskLimits
+  {
+    std::uint32_t max_order_count = 1000;          // contracts per order
+    std::int32_t max_position = 5000;              // |YES-equivalent contracts|, open orders included
+    std::int64_t max_market_notional = 500'000;    // open order cost per market
+    std::int64_t max_total_notional = 5'000'000;   // open order cost across markets
+    std::uint32_t max_market_open_orders = 20;
+    std::uint32_t max_total_open_orders = 500;
+    md::Price price_band = 10;                     // max distance from the reference, YES cents
+    bool require_reference = true;                 // reject markets without a reference price
+  };
+
+  /**
+   * Per-market counters. Positions and prices are in YES terms: buying YES
+   * or selling NO raises the position; a NO price p is YES price 100 - p.
+   */
+  struct alignas(32) MarketRisk
+  {
+    std::int64_t open_notional; // cents reserved by open orders
+    std::int32_t position;      // filled YES-equivalent contracts
+    std::int32_t open_long;     // open contracts that would raise the position
+    std::int32_t open_short;    // open contracts that would lower it
+    std::uint16_t open_orders;
+    md::Price reference;        // YES cents, 0 if unknown
+    bool halted;
+  };
+
+  /**
+   * Pre-trade risk checks for every order before it leaves.
+   *
+   * Each market's counters are kept incrementally from order events, so a
+   * check is a handful of integer compares against one 32-byte record plus
+   * two totals. Nothing is recomputed from order lists. The records for
+   * 10k markets take 320 KB, so they stay cache-resident.
+   *
+   * Order events, in the order they happen:
+   * - on_sent() reserves an order's size, notional and open-order slot as
+   *   it is sent. Reserving before the ack means in-flight orders count
+   *   against the limits too.
+   * - on_fill() moves filled contracts from open to position.
+   * - on_closed() releases what is left when the order is canceled,
+   *   rejected or fully filled.
+   * The position limit is checked against the worst case: the current
+   * position plus every open order on the same side filling.
+   *
+   * Not thread-safe; runs on the order entry thread.
+   */
+  class RiskEngine
+  {
+  public:
+    /**
+     * Construct with a fixed number of market slots.
+     * @param market_capacity Markets; ids at or above this are rejected.
+     * @param limits Limits.
+     */
+    RiskEngine(std::uint32_t market_capacity, RiskLimits limits);
+
+    /**
+     * Check an order against every limit.
+     * @param order Order to check.
+     * @return void or the first failed limit.
+     */
+    [[nodiscard]] std::expected<void, RiskReject> check(const OrderSpec &order) const
+    {
+      if (order.market >= market_capacity_)
+      {
+        return std::unexpected(RiskReject::UnknownMarket);
+      }
+      const auto &m = markets_[order.market];
+      if (m.halted)
+      {
+        return std::unexpected(RiskReject::MarketHalted);
+      }
+      if (order.price == 0 || order.price >= md::PRICE_MAX)
+      {
+        return std::unexpected(RiskReject::PriceOutOfRange);
+      }
+      if (order.count == 0 || order.count > limits_.max_order_count)
+      {
+        return std::unexpected(RiskReject::OrderSize);
+      }
+      if (m.reference == 0)
+      {
+        if (limits_.require_reference)
+        {
+          return std::unexpected(RiskReject::NoReference);
+        }
+      }
+      else
+      {
+        auto distance = static_cast<int>(yes_price(order)) - static_cast<int>(m.reference);
+        if (distance > limits_.price_band || -distance > limits_.price_band)
+        {
+          return std::unexpected(RiskReject::PriceBand);
+        }
+      }
+      auto count = static_cast<std::int32_t>(order.count);
+      auto worst = raises_position(order) ? m.position + m.open_long + count
+                                          : m.open_short + count - m.position;
+      if (worst > limits_.max_position)
+      {
+        return std::unexpected(RiskReject::PositionLimit);
+      }
+      auto cost = notional(order, order.count);
+      if (m.open_notional + cost > limits_.max_market_notional)
+      {
+        return std::unexpected(RiskReject::MarketNotional);
+      }
+      if (total_notional_ + cost > limits_.max_total_notional)
+      {
+        return std::unexpected(RiskReject::TotalNotional);
+      }
+      if (m.open_orders >= limits_.max_market_open_orders)
+      {
+        return std::unexpected(RiskReject::MarketOpenOrders);
+      }
+      if (total_open_orders_ >= limits_.max_total_open_orders)
+      {
+        return std::unexpected(RiskReject::TotalOpenOrders);
+      }
+      return {};
+    }
+
+    /**
+     * Reserve an order that passed check() and is being sent.
+     * @param order Order sent.
+     * @return void.
+     */
+    void on_sent(const OrderSpec &order);
+
+    /**
+     * Apply a fill: open contracts become position.
+     * @param order Order that filled.
+     * @param count Contracts filled.
+     * @return void.
+     */
+    void on_fill(const OrderSpec &order, std::uint32_t count);
+
+    /**
+     * Release an order that will not fill further.
+     * @param order Order closed.
+     * @param remaining Contracts that were still open.
+     * @return void.
+     */
+    void on_closed(const OrderSpec &order, std::uint32_t remaining);
+
+    /**
+     * Set a market's reference price for the price band (e.g. the book mid).
+     * @param market Market id.
+     * @param yes_price YES price in cents, 0 to clear.
+     * @return void.
+     */
+    void set_reference(md::MarketId market, md::Price yes_price);
+
+    /**
+     * Stop or resume accepting orders for a market.
+     * @param market Market id.
+     * @param halted Whether to reject new orders.
+     * @return void.
+     */
+    void set_halted(md::MarketId market, bool halted);
+
+    /**
+     * Set a market's filled position, e.g. from the exchange at startup.
+     * @param market Market id.
+     * @param position YES-equivalent contracts.
+     * @return void.
+     */
+    void set_position(md::MarketId market, std::int32_t position);
+
+    /**
+     * Counters of one market.
+     * @param market Market id below market_capacity().
+     * @return Counters.
+     */
+    [[nodiscard]] const MarketRisk &market(md::MarketId market) const { return markets_[market]; }
+
+    /** Open order cost across markets, in cents. */
+    [[nodiscard]] std::int64_t total_notional() const { return total_notional_; }
+
+    /** Open orders across markets. */
+    [[nodiscard]] std::uint32_t total_open_orders() const { return total_open_orders_; }
+
+    /** Market slots. */
+    [[nodiscard]] std::uint32_t market_capacity() const { return market_capacity_; }
+
+    /** Limits in force. */
+    [[nodiscard]] const RiskLimits &limits() const { return limits_; }
+
+    /**
+     * Whether an order raises the YES position if it fills.
+     * @param order Order.
+     * @return True for buy YES and sell NO.
+     */
+    [[nodiscard]] static constexpr bool raises_position(const OrderSpec &order)
+    {
+      return (order.side == md::BookSide::Yes) == (order.action == OrderAction::Buy);
+    }
+
+    /**
+     * Order price in YES terms.
+     * @param order Order.
+     * @return YES cents.
+     */
+    [[nodiscard]] static constexpr md::Price yes_price(const OrderSpec &order)
+    {
+      return order.side == md::BookSide::Yes ? order.price
+                                             : static_cast<md::Price>(md::PRICE_MAX - order.price);
+    }
+
+    /**
+     * Cost of count contracts at the order's price, in cents.
+     * @param order Order.
+     * @param count Contracts.
+     * @return Cents.
+     */
+    [[nodiscard]] static constexpr std::int64_t notional(const OrderSpec &order, std::uint32_t count)
+    {
+      return static_cast<std::int64_t>(count) * order.price;
+    }
+
+  private:
+    std::uint32_t market_capacity_;
+    RiskLimits limits_;
+    std::unique_ptr<MarketRisk[]> markets_;
+    std::int64_t total_notional_ = 0;
+    std::uint32_t total_open_orders_ = 0;
+  };
+
+} // namespace kalshi::trade
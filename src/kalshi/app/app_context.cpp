@@ -33,6 +33,17 @@ std::expected<AppContext, AppError> AppContext::build(std::string_view config_pa
     return std::unexpected(AppError::AuthLoadFailed);
   }
 
+  auto signer = kalshi::AuthSigner::create(*auth);
+  if (!signer)
+  {
+    kalshi::logging::LogFields fields;
+    fields.add_string("error", std::string(kalshi::to_string(signer.error())));
+    fields.add_string("openssl_error", kalshi::last_sign_error());
+    logger->log(kalshi::logging::LogLevel::Error, "core.auth", "key_load_failed", std::move(fields));
+    return std::unexpected(AppError::AuthLoadFailed);
+  }
+  auto shared_signer = std::make_shared<kalshi::AuthSigner>(std::move(*signer));
+
   auto ws_url = kalshi::resolve_ws_url(*config_result);
 
   auto subscription = kalshi::md::SubscriptionCommand::from_config(*config_result, 1);
@@ -43,7 +54,7 @@ std::expected<AppContext, AppError> AppContext::build(std::string_view config_pa
     return std::unexpected(AppError::SubscriptionInvalid);
   }
 
-  auto headers = build_headers(*auth, *logger);
+  auto headers = build_headers(*shared_signer, *logger);
   if (!headers)
   {
     return std::unexpected(headers.error());
@@ -51,7 +62,7 @@ std::expected<AppContext, AppError> AppContext::build(std::string_view config_pa
 
   return AppContext(std::move(*config_result),
                     std::move(logger),
-                    std::move(*auth),
+                    std::move(shared_signer),
                     std::move(*headers),
                     std::move(*subscription),
                     std::move(ws_url));
@@ -59,9 +70,11 @@ std::expected<AppContext, AppError> AppContext::build(std::string_view config_pa
 
 kalshi::md::FeedHandler<LoggingSink>::RunOptions AppContext::build_run_options() const
 {
+  // FeedHandler calls this PRESIGN_LEAD before each reconnect, so the
+  // connect itself does no key work.
   auto refresh = [this]() -> std::optional<std::vector<kalshi::Header>>
   {
-    auto refreshed = build_headers(auth_, *logger_);
+    auto refreshed = build_headers(*signer_, *logger_);
     if (!refreshed)
     {
       return std::nullopt;
@@ -73,7 +86,7 @@ kalshi::md::FeedHandler<LoggingSink>::RunOptions AppContext::build_run_options()
       .ws_url = ws_url_,
       .headers = headers_,
       .refresh_headers = refresh,
-      .subscribe_cmd = subscription_.json(),
+      .subscription = subscription_.request(),
       .output_path = config_.output.raw_messages_path,
       .include_raw_on_parse_error = config_.logging.include_raw_on_parse_error,
       .log_raw_messages = config_.logging.log_raw_messages,
@@ -83,7 +96,14 @@ kalshi::md::FeedHandler<LoggingSink>::RunOptions AppContext::build_run_options()
       .handshake_timeout = std::chrono::milliseconds(config_.ws.handshake_timeout_ms),
       .idle_timeout = std::chrono::milliseconds(config_.ws.idle_timeout_ms),
       .keep_alive_pings = config_.ws.keep_alive_pings,
-      .max_messages = 0};
+      .max_messages = 0,
+      .tls_session_resumption = config_.ws.tls_session_resumption,
+      .dns_cache_ttl = std::chrono::milliseconds(config_.ws.dns_cache_ttl_ms),
+      .hot_standby = config_.ws.hot_standby,
+      .fast_delta_scan = true,
+      .on_fill = {},
+      .on_user_order = {},
+      .command_rate_limit = &rate_limiter_.bucket(kalshi::RateLimitEndpoint::WsCommand)};
 }
 
 void AppContext::log_config() const
@@ -122,12 +142,9 @@ std::expected<kalshi::logging::AsyncJsonLoggerOptions, AppError> AppContext::bui
 }
 
 std::expected<std::vector<kalshi::Header>, AppError> AppContext::build_headers(
-    const kalshi::AuthConfig& auth, kalshi::logging::Logger& logger)
+    kalshi::AuthSigner& signer, kalshi::logging::Logger& logger)
 {
-  auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::system_clock::now().time_since_epoch())
-                    .count();
-  auto built_headers = kalshi::build_ws_headers(auth, kalshi::WS_PATH, now_ms);
+  auto built_headers = signer.build_headers("GET", kalshi::WS_PATH, kalshi::unix_time_ms());
   if (!built_headers)
   {
     kalshi::logging::LogFields fields;
@@ -1,9 +1,11 @@
 #include "kalshi/core/auth.hpp"
 
+#include <condition_variable>
 #include <cstdlib>
 #include <expected>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 
 #include <openssl/err.h>
@@ -85,51 +87,49 @@ namespace kalshi
       return PkeyPtr(pkey, &EVP_PKEY_free);
     }
 
-    std::expected<std::string, AuthError> sign_rsa_pss(EVP_PKEY *pkey,
-                                                       std::string_view message)
+    /** Set up ctx for SHA-256 RSA-PSS signing with pkey. */
+    bool prepare_rsa_pss(EVP_MD_CTX *ctx, EVP_PKEY *pkey)
     {
-      MdCtxPtr ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
-      if (!ctx)
-      {
-        set_last_sign_error_from_openssl();
-        return std::unexpected(AuthError::SigningFailed);
-      }
-
       EVP_PKEY_CTX *pkey_ctx = nullptr;
-      if (EVP_DigestSignInit(ctx.get(), &pkey_ctx, EVP_sha256(), nullptr, pkey) <=
-          0)
+      if (EVP_DigestSignInit(ctx, &pkey_ctx, EVP_sha256(), nullptr, pkey) <= 0)
       {
         set_last_sign_error_from_openssl();
-        return std::unexpected(AuthError::SigningFailed);
+        return false;
       }
 
       if (EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) <= 0)
       {
         set_last_sign_error_from_openssl();
-        return std::unexpected(AuthError::SigningFailed);
+        return false;
       }
 
       if (EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1) <= 0)
       {
         set_last_sign_error_from_openssl();
-        return std::unexpected(AuthError::SigningFailed);
+        return false;
       }
+      return true;
+    }
 
-      if (EVP_DigestSignUpdate(ctx.get(), message.data(), message.size()) <= 0)
+    /** Hash and sign message with a prepared ctx. */
+    std::expected<std::string, AuthError> finish_rsa_pss(EVP_MD_CTX *ctx,
+                                                         std::string_view message)
+    {
+      if (EVP_DigestSignUpdate(ctx, message.data(), message.size()) <= 0)
       {
         set_last_sign_error_from_openssl();
         return std::unexpected(AuthError::SigningFailed);
       }
 
       size_t sig_len = 0;
-      if (EVP_DigestSignFinal(ctx.get(), nullptr, &sig_len) <= 0)
+      if (EVP_DigestSignFinal(ctx, nullptr, &sig_len) <= 0)
       {
         set_last_sign_error_from_openssl();
         return std::unexpected(AuthError::SigningFailed);
       }
 
       std::string signature(sig_len, '\0');
-      if (EVP_DigestSignFinal(ctx.get(),
+      if (EVP_DigestSignFinal(ctx,
                               reinterpret_cast<unsigned char *>(signature.data()),
                               &sig_len) <= 0)
       {
@@ -141,6 +141,22 @@ namespace kalshi
       return signature;
     }
 
+    std::expected<std::string, AuthError> sign_rsa_pss(EVP_PKEY *pkey,
+                                                       std::string_view message)
+    {
+      MdCtxPtr ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+      if (!ctx)
+      {
+        set_last_sign_error_from_openssl();
+        return std::unexpected(AuthError::SigningFailed);
+      }
+      if (!prepare_rsa_pss(ctx.get(), pkey))
+      {
+        return std::unexpected(AuthError::SigningFailed);
+      }
+      return finish_rsa_pss(ctx.get(), message);
+    }
+
     std::expected<std::string, AuthError> base64_encode(const std::string &bytes)
     {
       std::string b64;
@@ -257,4 +273,170 @@ namespace kalshi
         {"KALSHI-ACCESS-TIMESTAMP", std::to_string(timestamp_ms)}};
   }
 
+  struct AuthSigner::Keys
+  {
+    PkeyPtr pkey{nullptr, &EVP_PKEY_free};
+    MdCtxPtr prepared{nullptr, &EVP_MD_CTX_free}; // init'd with key + padding
+    MdCtxPtr work{nullptr, &EVP_MD_CTX_free};     // per-signature copy
+  };
+
+  std::expected<AuthSigner, AuthError> AuthSigner::create(const AuthConfig &auth)
+  {
+    ensure_legacy_provider_loaded();
+    if (is_openssh_key(auth.private_key_pem))
+    {
+      g_last_sign_error = "OpenSSH private key format detected; convert to PEM "
+                          "(PKCS#8) for OpenSSL";
+      return std::unexpected(AuthError::SigningFailed);
+    }
+
+    auto pkey = load_private_key(auth.private_key_pem);
+    if (!pkey)
+    {
+      return std::unexpected(pkey.error());
+    }
+
+    auto keys = std::make_unique<Keys>();
+    keys->pkey = std::move(*pkey);
+    keys->prepared.reset(EVP_MD_CTX_new());
+    keys->work.reset(EVP_MD_CTX_new());
+    if (!keys->prepared || !keys->work)
+    {
+      set_last_sign_error_from_openssl();
+      return std::unexpected(AuthError::SigningFailed);
+    }
+    if (!prepare_rsa_pss(keys->prepared.get(), keys->pkey.get()))
+    {
+      return std::unexpected(AuthError::SigningFailed);
+    }
+    return AuthSigner(auth.key_id, std::move(keys));
+  }
+
+  AuthSigner::AuthSigner(std::string key_id, std::unique_ptr<Keys> keys)
+      : key_id_(std::move(key_id)),
+        keys_(std::move(keys)),
+        sign_mutex_(std::make_unique<std::mutex>()),
+        presigned_mutex_(std::make_unique<std::mutex>())
+  {
+  }
+
+  AuthSigner::AuthSigner(AuthSigner &&other) noexcept = default;
+  AuthSigner &AuthSigner::operator=(AuthSigner &&other) noexcept = default;
+  AuthSigner::~AuthSigner() = default;
+
+  std::expected<std::string, AuthError> AuthSigner::sign(std::string_view message)
+  {
+    std::lock_guard lock(*sign_mutex_);
+    if (EVP_MD_CTX_copy_ex(keys_->work.get(), keys_->prepared.get()) <= 0)
+    {
+      set_last_sign_error_from_openssl();
+      return std::unexpected(AuthError::SigningFailed);
+    }
+    auto signature = finish_rsa_pss(keys_->work.get(), message);
+    if (!signature)
+    {
+      return std::unexpected(signature.error());
+    }
+    return base64_encode(*signature);
+  }
+
+  std::expected<std::vector<Header>, AuthError> AuthSigner::build_headers(
+      std::string_view method, std::string_view path, std::int64_t timestamp_ms)
+  {
+    auto timestamp = std::to_string(timestamp_ms);
+    std::string msg;
+    msg.reserve(timestamp.size() + method.size() + path.size());
+    msg.append(timestamp);
+    msg.append(method);
+    msg.append(path);
+
+    auto signature = sign(msg);
+    if (!signature)
+    {
+      return std::unexpected(signature.error());
+    }
+
+    return std::vector<Header>{{"KALSHI-ACCESS-KEY", key_id_},
+                               {"KALSHI-ACCESS-SIGNATURE", std::move(*signature)},
+                               {"KALSHI-ACCESS-TIMESTAMP", std::move(timestamp)}};
+  }
+
+  std::expected<void, AuthError> AuthSigner::presign(std::string_view method,
+                                                     std::string_view path,
+                                                     std::int64_t timestamp_ms)
+  {
+    auto headers = build_headers(method, path, timestamp_ms);
+    if (!headers)
+    {
+      return std::unexpected(headers.error());
+    }
+    std::lock_guard lock(*presigned_mutex_);
+    auto *entry = const_cast<Presigned *>(find_presigned(method, path));
+    if (entry == nullptr)
+    {
+      entry = &presigned_.emplace_back(Presigned{.method = std::string(method),
+                                                 .path = std::string(path),
+                                                 .timestamp_ms = 0,
+                                                 .headers = {}});
+    }
+    entry->timestamp_ms = timestamp_ms;
+    entry->headers = std::move(*headers);
+    return {};
+  }
+
+  std::optional<std::vector<Header>> AuthSigner::presigned(std::string_view method,
+                                                           std::string_view path,
+                                                           std::int64_t now_ms,
+                                                           std::int64_t max_age_ms) const
+  {
+    std::optional<std::vector<Header>> headers;
+    with_presigned(method, path, now_ms, max_age_ms,
+                   [&](const std::vector<Header> &cached) { headers = cached; });
+    return headers;
+  }
+
+  const AuthSigner::Presigned *AuthSigner::find_presigned(std::string_view method,
+                                                          std::string_view path) const
+  {
+    for (const auto &entry : presigned_)
+    {
+      if (entry.method == method && entry.path == path)
+      {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  std::int64_t unix_time_ms()
+  {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  }
+
+  AuthPresigner::AuthPresigner(std::shared_ptr<AuthSigner> signer,
+                               std::vector<Request> requests,
+                               std::chrono::milliseconds interval)
+      : thread_(
+            [signer = std::move(signer), requests = std::move(requests), interval](
+                std::stop_token stop)
+            {
+              std::mutex mutex;
+              std::condition_variable_any wake;
+              while (!stop.stop_requested())
+              {
+                for (const auto &request : requests)
+                {
+                  // A failure only means the caller signs inline and reports
+                  // the error itself.
+                  (void)signer->presign(request.method, request.path, unix_time_ms());
+                }
+                std::unique_lock lock(mutex);
+                wake.wait_for(lock, stop, interval, [] { return false; });
+              }
+            })
+  {
+  }
+
 } // namespace kalshi
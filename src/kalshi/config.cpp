@@ -158,9 +158,14 @@ namespace kalshi
           get_optional_size(ws.value(), "reconnect_initial_delay_ms");
       auto reconnect_max_delay_ms =
           get_optional_size(ws.value(), "reconnect_max_delay_ms");
+      auto tls_session_resumption =
+          get_optional_bool(ws.value(), "tls_session_resumption");
+      auto dns_cache_ttl_ms = get_optional_size(ws.value(), "dns_cache_ttl_ms");
+      auto hot_standby = get_optional_bool(ws.value(), "hot_standby");
 
       if (!handshake_timeout_ms || !idle_timeout_ms || !keep_alive_pings ||
-          !auto_reconnect || !reconnect_initial_delay_ms || !reconnect_max_delay_ms)
+          !auto_reconnect || !reconnect_initial_delay_ms || !reconnect_max_delay_ms ||
+          !tls_session_resumption || !dns_cache_ttl_ms || !hot_standby)
       {
         return std::unexpected(ConfigError::ParseFailed);
       }
@@ -192,6 +197,18 @@ namespace kalshi
         base.reconnect_max_delay_ms =
             static_cast<std::int64_t>(**reconnect_max_delay_ms);
       }
+      if (tls_session_resumption->has_value())
+      {
+        base.tls_session_resumption = **tls_session_resumption;
+      }
+      if (dns_cache_ttl_ms->has_value())
+      {
+        base.dns_cache_ttl_ms = static_cast<std::int64_t>(**dns_cache_ttl_ms);
+      }
+      if (hot_standby->has_value())
+      {
+        base.hot_standby = **hot_standby;
+      }
 
       if (base.handshake_timeout_ms < 0 || base.idle_timeout_ms < 0 ||
           base.reconnect_initial_delay_ms < 0 || base.reconnect_max_delay_ms < 0)
@@ -320,7 +337,10 @@ namespace kalshi
                       .keep_alive_pings = true,
                       .auto_reconnect = true,
                       .reconnect_initial_delay_ms = 500,
-                      .reconnect_max_delay_ms = 30000};
+                      .reconnect_max_delay_ms = 30000,
+                      .tls_session_resumption = true,
+                      .dns_cache_ttl_ms = 60000,
+                      .hot_standby = false};
     }
 
   } // namespace
@@ -0,0 +1,139 @@
+#include "kalshi/md/model/book_views.hpp"
+
+#include <algorithm>
+
+namespace kalshi::md {
+
+BookViews::BookViews(std::uint32_t market_capacity)
+    : market_capacity_(market_capacity),
+      slots_(std::make_unique<Slot[]>(market_capacity)) {}
+
+std::optional<MarketId> BookViews::market(std::string_view market_ticker) {
+  if (auto id = ids_.find(market_ticker)) {
+    return id;
+  }
+  if (ids_.size() == market_capacity_) {
+    return std::nullopt;
+  }
+  auto id = ids_.intern(market_ticker);
+  slots_[id].ticker = std::string(market_ticker);
+  market_count_.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+bool BookViews::update(const OrderBook &book, BookSide side, Price price,
+                       Size size, DepthView &view) {
+  auto yes = side == BookSide::Yes;
+  auto &levels = yes ? view.yes : view.no;
+  auto &count = yes ? view.yes_count : view.no_count;
+  std::uint32_t i = 0;
+  while (i < count && levels[i].price > price) {
+    ++i;
+  }
+  if (i < count && levels[i].price == price) {
+    if (size != 0) {
+      levels[i].size = size;
+      return true;
+    }
+    // Level removed: close the gap, then refill from below the old floor.
+    auto floor = levels[count - 1].price;
+    std::copy(levels.begin() + i + 1, levels.begin() + count,
+              levels.begin() + i);
+    --count;
+    if (count + 1 == BOOK_VIEW_DEPTH) {
+      const auto &sizes = book.levels(side);
+      for (auto below = static_cast<int>(floor) - 1; below >= 0; --below) {
+        auto below_size = sizes[static_cast<std::size_t>(below)];
+        if (below_size != 0) {
+          levels[count++] = PriceLevel{static_cast<Price>(below), below_size};
+          break;
+        }
+      }
+    }
+    return true;
+  }
+  if (size == 0 || i == BOOK_VIEW_DEPTH) {
+    return false; // not shown before and not shown now
+  }
+  // New level inside the view: shift the rest down, dropping the last one
+  // if the side is full.
+  auto kept = std::min<std::uint32_t>(count, BOOK_VIEW_DEPTH - 1);
+  std::copy_backward(levels.begin() + i, levels.begin() + kept,
+                     levels.begin() + kept + 1);
+  levels[i] = PriceLevel{price, size};
+  count = kept + 1;
+  return true;
+}
+
+void BookViews::collect(const OrderBook &book, BookSide side,
+                        DepthView &view) {
+  auto yes = side == BookSide::Yes;
+  auto &levels = yes ? view.yes : view.no;
+  const auto &sizes = book.levels(side);
+  std::uint32_t count = 0;
+  for (auto price = static_cast<int>(PRICE_MAX);
+       price >= 0 && count < BOOK_VIEW_DEPTH; --price) {
+    auto size = sizes[static_cast<std::size_t>(price)];
+    if (size != 0) {
+      levels[count++] = PriceLevel{static_cast<Price>(price), size};
+    }
+  }
+  (yes ? view.yes_count : view.no_count) = count;
+}
+
+void BookViews::publish(Slot &slot, Sequence sequence, std::int64_t ts_ns,
+                        bool depth_changed) {
+  auto &depth = slot.current_depth;
+  auto &top = slot.current_top;
+  if (depth_changed) {
+    depth.sequence = sequence;
+    slot.depth.write(depth);
+    top.yes_price = depth.yes_count > 0 ? depth.yes[0].price : Price{0};
+    top.yes_size = depth.yes_count > 0 ? depth.yes[0].size : Size{0};
+    top.no_price = depth.no_count > 0 ? depth.no[0].price : Price{0};
+    top.no_size = depth.no_count > 0 ? depth.no[0].size : Size{0};
+  }
+  top.sequence = sequence;
+  top.ts_ns = ts_ns;
+  slot.top.write(top);
+}
+
+void BookViews::on_snapshot(const OrderbookSnapshot &s) {
+  auto id = market(s.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &slot = slots_[*id];
+  slot.book.apply(s);
+  collect(slot.book, BookSide::Yes, slot.current_depth);
+  collect(slot.book, BookSide::No, slot.current_depth);
+  publish(slot, s.sequence, s.ts.count(), true);
+}
+
+void BookViews::on_delta(const OrderbookDelta &d) {
+  auto id = market(d.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &slot = slots_[*id];
+  auto size = slot.book.apply(d);
+  auto changed = update(slot.book, d.side, d.price, size, slot.current_depth);
+  publish(slot, d.sequence, d.ts.count(), changed);
+}
+
+std::optional<MarketId> BookViewIndex::find(std::string_view market_ticker) {
+  if (auto id = ids_.find(market_ticker)) {
+    return id;
+  }
+  // Ids are dense and assigned in order, so interning the new slots in
+  // order reproduces the feed thread's ids.
+  auto count = views_.market_count();
+  for (auto id = static_cast<MarketId>(ids_.size()); id < count; ++id) {
+    ids_.intern(views_.ticker(id));
+  }
+  return ids_.find(market_ticker);
+}
+
+} // namespace kalshi::md
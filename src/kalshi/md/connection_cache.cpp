@@ -0,0 +1,91 @@
+#include "kalshi/md/ws/connection_cache.hpp"
+
+#include <utility>
+
+namespace kalshi::md {
+
+ConnectionCache::ConnectionCache(boost::asio::io_context &ioc,
+                                 std::chrono::milliseconds dns_ttl,
+                                 bool tls_resumption)
+    : resolver_(ioc), refresh_timer_(ioc), dns_ttl_(dns_ttl),
+      tls_resumption_(tls_resumption) {}
+
+ConnectionCache::~ConnectionCache() {
+  stop();
+  clear_session();
+}
+
+std::optional<ConnectionCache::Endpoints>
+ConnectionCache::endpoints(std::string_view host, std::string_view port) const {
+  if (!endpoints_ || host != host_ || port != port_) {
+    return std::nullopt;
+  }
+  return endpoints_;
+}
+
+void ConnectionCache::store_endpoints(std::string_view host,
+                                      std::string_view port,
+                                      Endpoints results) {
+  if (dns_ttl_.count() <= 0) {
+    return;
+  }
+  host_ = std::string(host);
+  port_ = std::string(port);
+  endpoints_ = std::move(results);
+  if (!refreshing_) {
+    refreshing_ = true;
+    schedule_refresh();
+  }
+}
+
+void ConnectionCache::invalidate_endpoints() { endpoints_.reset(); }
+
+void ConnectionCache::store_session(SSL_SESSION *session) {
+  if (!session) {
+    return;
+  }
+  if (!tls_resumption_ || !SSL_SESSION_is_resumable(session)) {
+    SSL_SESSION_free(session);
+    return;
+  }
+  clear_session();
+  session_ = session;
+}
+
+void ConnectionCache::clear_session() {
+  if (session_) {
+    SSL_SESSION_free(session_);
+    session_ = nullptr;
+  }
+}
+
+void ConnectionCache::stop() {
+  refreshing_ = false;
+  refresh_timer_.cancel();
+  resolver_.cancel();
+}
+
+void ConnectionCache::schedule_refresh() {
+  refresh_timer_.expires_after(dns_ttl_);
+  refresh_timer_.async_wait([this](const boost::system::error_code &ec) {
+    if (ec || !refreshing_) {
+      return;
+    }
+    resolver_.async_resolve(
+        host_, port_,
+        [this](boost::system::error_code resolve_ec, Endpoints results) {
+          if (resolve_ec == boost::asio::error::operation_aborted) {
+            return;
+          }
+          // Keep serving the previous answer if the refresh fails.
+          if (!resolve_ec && !results.empty()) {
+            endpoints_ = std::move(results);
+          }
+          if (refreshing_) {
+            schedule_refresh();
+          }
+        });
+  });
+}
+
+} // namespace kalshi::md
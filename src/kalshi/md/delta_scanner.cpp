@@ -0,0 +1,199 @@
+#include "kalshi/md/parse/delta_scanner.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "kalshi/md/parse/json_fields.hpp"
+
+namespace kalshi::md {
+
+namespace {
+
+constexpr std::string_view DELTA_PREFIX = R"({"type":"orderbook_delta","sid":)";
+constexpr std::string_view SEQ_KEY = R"(,"seq":)";
+constexpr std::string_view MSG_KEY = R"(,"msg":{"market_ticker":)";
+constexpr std::string_view PRICE_KEY = R"(,"price":)";
+constexpr std::string_view DELTA_KEY = R"(,"delta":)";
+constexpr std::string_view SIDE_KEY = R"(,"side":)";
+
+/** Longest digit run that always fits: 19 for uint64, 18 for int64. */
+constexpr int MAX_UINT_DIGITS = 19;
+constexpr int MAX_INT_DIGITS = 18;
+
+bool is_scalar_char(char c) {
+  switch (c) {
+  case '0': case '1': case '2': case '3': case '4': case '5': case '6':
+  case '7': case '8': case '9': case '+': case '-': case '.': case 'e':
+  case 'E': case 't': case 'r': case 'u': case 'f': case 'a': case 'l':
+  case 's': case 'n':
+    return true;
+  default:
+    return false;
+  }
+}
+
+/** Forward-only view over the message; every step fails closed. */
+struct Cursor {
+  const char *p;
+  const char *end;
+
+  bool literal(std::string_view text) {
+    if (static_cast<std::size_t>(end - p) < text.size() ||
+        std::memcmp(p, text.data(), text.size()) != 0) {
+      return false;
+    }
+    p += text.size();
+    return true;
+  }
+
+  bool digits(std::uint64_t &out, int max_digits) {
+    // JSON forbids leading zeros, so "0" is only valid on its own.
+    if (p == end || *p < '0' || *p > '9') {
+      return false;
+    }
+    if (*p == '0') {
+      ++p;
+      out = 0;
+      return p == end || *p < '0' || *p > '9';
+    }
+    std::uint64_t value = 0;
+    int count = 0;
+    while (p != end && *p >= '0' && *p <= '9') {
+      if (++count > max_digits) {
+        return false;
+      }
+      value = value * 10 + static_cast<std::uint64_t>(*p - '0');
+      ++p;
+    }
+    out = value;
+    return true;
+  }
+
+  bool uint(std::uint64_t &out) { return digits(out, MAX_UINT_DIGITS); }
+
+  bool integer(std::int64_t &out) {
+    bool negative = p != end && *p == '-';
+    if (negative) {
+      ++p;
+    }
+    std::uint64_t magnitude = 0;
+    if (!digits(magnitude, MAX_INT_DIGITS) || (negative && magnitude == 0)) {
+      return false;
+    }
+    auto value = static_cast<std::int64_t>(magnitude);
+    out = negative ? -value : value;
+    return true;
+  }
+
+  /** Quoted printable-ASCII string without escapes. */
+  bool string(std::string_view &out) {
+    if (p == end || *p != '"') {
+      return false;
+    }
+    const char *begin = ++p;
+    while (p != end && *p != '"') {
+      auto c = static_cast<unsigned char>(*p);
+      if (c == '\\' || c < 0x20 || c >= 0x80) {
+        return false;
+      }
+      ++p;
+    }
+    if (p == end) {
+      return false;
+    }
+    out = std::string_view(begin, static_cast<std::size_t>(p - begin));
+    ++p;
+    return true;
+  }
+
+  /** Number or true/false/null; the characters only, not their grammar. */
+  bool scalar() {
+    const char *begin = p;
+    while (p != end && is_scalar_char(*p)) {
+      ++p;
+    }
+    return p != begin;
+  }
+};
+
+bool is_core_field(std::string_view key) {
+  return key == FIELD_MARKET_TICKER || key == FIELD_PRICE ||
+         key == FIELD_DELTA || key == FIELD_SIDE;
+}
+
+} // namespace
+
+std::optional<OrderbookDelta> scan_orderbook_delta(std::string_view json) {
+  Cursor in{json.data(), json.data() + json.size()};
+
+  std::uint64_t sid = 0;
+  std::uint64_t seq = 0;
+  std::string_view market;
+  std::int64_t price = 0;
+  std::int64_t delta = 0;
+  std::string_view side;
+  if (!in.literal(DELTA_PREFIX) || !in.uint(sid) || !in.literal(SEQ_KEY) ||
+      !in.uint(seq) || !in.literal(MSG_KEY) || !in.string(market) ||
+      !in.literal(PRICE_KEY) || !in.integer(price) ||
+      !in.literal(DELTA_KEY) || !in.integer(delta) ||
+      !in.literal(SIDE_KEY) || !in.string(side)) {
+    return std::nullopt;
+  }
+
+  // Optional trailing fields (client_order_id, ts, ...). Core fields
+  // repeated here or nested values are left to the full parser.
+  std::optional<std::string_view> client_order_id;
+  while (in.p != in.end && *in.p == ',') {
+    ++in.p;
+    std::string_view key;
+    if (!in.string(key) || !in.literal(":") || is_core_field(key)) {
+      return std::nullopt;
+    }
+    if (key == FIELD_CLIENT_ORDER_ID) {
+      std::string_view value;
+      if (!in.string(value)) {
+        return std::nullopt;
+      }
+      if (!client_order_id) {
+        client_order_id = value;
+      }
+      continue;
+    }
+    bool quoted = in.p != in.end && *in.p == '"';
+    std::string_view ignored;
+    if (quoted ? !in.string(ignored) : !in.scalar()) {
+      return std::nullopt;
+    }
+  }
+  if (!in.literal("}}") || in.p != in.end) {
+    return std::nullopt;
+  }
+
+  if (price < 0 || price > PRICE_MAX ||
+      delta < std::numeric_limits<Delta>::min() ||
+      delta > std::numeric_limits<Delta>::max()) {
+    return std::nullopt;
+  }
+  BookSide book_side;
+  if (side == VALUE_SIDE_YES) {
+    book_side = BookSide::Yes;
+  } else if (side == VALUE_SIDE_NO) {
+    book_side = BookSide::No;
+  } else {
+    return std::nullopt;
+  }
+
+  return OrderbookDelta{
+      .market_ticker = MarketTicker(market),
+      .sequence = seq,
+      .price = static_cast<Price>(price),
+      .delta = static_cast<Delta>(delta),
+      .side = book_side,
+      .client_order_id = client_order_id
+                             ? std::optional<std::string>(*client_order_id)
+                             : std::nullopt,
+      .ts = Timestamp{0}};
+}
+
+} // namespace kalshi::md
@@ -8,7 +8,9 @@
 
 #include <simdjson.h>
 
+#include "kalshi/md/parse/json_document.hpp"
 #include "kalshi/md/parse/json_fields.hpp"
+#include "kalshi/md/protocol/message_types.hpp"
 
 namespace kalshi::md {
 
@@ -50,8 +52,82 @@ std::expected<BookSide, ParseError> parse_side(std::string_view side) {
   return std::unexpected(ParseError::InvalidField);
 }
 
-std::expected<std::vector<PriceLevel>, ParseError>
-parse_levels(simdjson::ondemand::object &obj, std::string_view key) {
+std::expected<OrderAction, ParseError> parse_action(std::string_view action) {
+  if (action == VALUE_ACTION_BUY) {
+    return OrderAction::Buy;
+  }
+  if (action == VALUE_ACTION_SELL) {
+    return OrderAction::Sell;
+  }
+  return std::unexpected(ParseError::InvalidField);
+}
+
+std::expected<UserOrderStatus, ParseError>
+parse_order_status(std::string_view status) {
+  if (status == VALUE_STATUS_RESTING) {
+    return UserOrderStatus::Resting;
+  }
+  if (status == VALUE_STATUS_CANCELED) {
+    return UserOrderStatus::Canceled;
+  }
+  if (status == VALUE_STATUS_EXECUTED) {
+    return UserOrderStatus::Executed;
+  }
+  if (status == VALUE_STATUS_PENDING) {
+    return UserOrderStatus::Pending;
+  }
+  return std::unexpected(ParseError::InvalidField);
+}
+
+std::expected<bool, ParseError> get_bool(simdjson::ondemand::object &obj,
+                                         std::string_view key) {
+  auto field = obj[key];
+  if (field.error()) {
+    return std::unexpected(ParseError::MissingField);
+  }
+  auto val = field.get_bool();
+  if (val.error()) {
+    return std::unexpected(ParseError::InvalidField);
+  }
+  return val.value();
+}
+
+std::expected<Price, ParseError> get_price(simdjson::ondemand::object &obj,
+                                           std::string_view key) {
+  auto price = get_int(obj, key);
+  if (!price) {
+    return std::unexpected(price.error());
+  }
+  if (*price < 0 || *price > PRICE_MAX) {
+    return std::unexpected(ParseError::InvalidField);
+  }
+  return static_cast<Price>(*price);
+}
+
+std::expected<Count, ParseError> get_count(simdjson::ondemand::object &obj,
+                                           std::string_view key) {
+  auto count = get_int(obj, key);
+  if (!count) {
+    return std::unexpected(count.error());
+  }
+  if (*count < 0 || *count > std::numeric_limits<Count>::max()) {
+    return std::unexpected(ParseError::InvalidField);
+  }
+  return static_cast<Count>(*count);
+}
+
+std::expected<BookSide, ParseError> get_side(simdjson::ondemand::object &obj,
+                                             std::string_view key) {
+  auto side = get_string(obj, key);
+  if (!side) {
+    return std::unexpected(side.error());
+  }
+  return parse_side(*side);
+}
+
+std::expected<void, ParseError> parse_levels(simdjson::ondemand::object &obj,
+                                             std::string_view key,
+                                             PriceLevels &levels) {
   auto field = obj[key];
   if (field.error()) {
     return std::unexpected(ParseError::MissingField);
@@ -61,7 +137,7 @@ parse_levels(simdjson::ondemand::object &obj, std::string_view key) {
     return std::unexpected(ParseError::InvalidField);
   }
 
-  std::vector<PriceLevel> levels;
+  levels.clear();
   for (auto entry : arr) {
     auto pair = entry.get_array();
     if (pair.error()) {
@@ -88,11 +164,13 @@ parse_levels(simdjson::ondemand::object &obj, std::string_view key) {
             static_cast<std::int64_t>(std::numeric_limits<Size>::max())) {
       return std::unexpected(ParseError::InvalidField);
     }
-    levels.push_back(PriceLevel{static_cast<Price>(price.value()),
-                                static_cast<Size>(size.value())});
+    if (!levels.push_back(PriceLevel{static_cast<Price>(price.value()),
+                                     static_cast<Size>(size.value())})) {
+      return std::unexpected(ParseError::InvalidField);
+    }
   }
 
-  return levels;
+  return {};
 }
 
 using DocumentResult = simdjson::simdjson_result<simdjson::ondemand::document>;
@@ -144,12 +222,6 @@ Timestamp parse_optional_timestamp(simdjson::ondemand::object &obj) {
       std::chrono::seconds(val.value()));
 }
 
-struct SnapshotFields {
-  MarketTicker market;
-  std::vector<PriceLevel> yes;
-  std::vector<PriceLevel> no;
-};
-
 struct DeltaFields {
   MarketTicker market;
   Price price;
@@ -167,26 +239,25 @@ struct TradeFields {
   Timestamp ts;
 };
 
-std::expected<SnapshotFields, ParseError>
-parse_snapshot_fields(simdjson::ondemand::object &obj) {
+std::expected<void, ParseError>
+parse_snapshot_fields(simdjson::ondemand::object &obj, OrderbookSnapshot &out) {
   auto market = get_string(obj, FIELD_MARKET_TICKER);
   if (!market) {
     return std::unexpected(market.error());
   }
+  out.market_ticker = std::move(*market);
 
-  auto yes = parse_levels(obj, FIELD_YES);
+  auto yes = parse_levels(obj, FIELD_YES, out.yes);
   if (!yes) {
     return std::unexpected(yes.error());
   }
 
-  auto no = parse_levels(obj, FIELD_NO);
+  auto no = parse_levels(obj, FIELD_NO, out.no);
   if (!no) {
     return std::unexpected(no.error());
   }
 
-  return SnapshotFields{.market = std::move(*market),
-                        .yes = std::move(*yes),
-                        .no = std::move(*no)};
+  return {};
 }
 
 std::expected<DeltaFields, ParseError>
@@ -278,13 +349,110 @@ parse_trade_fields(simdjson::ondemand::object &obj) {
                      .ts = parse_optional_timestamp(obj)};
 }
 
+std::expected<FillEvent, ParseError>
+parse_fill_fields(simdjson::ondemand::object &obj) {
+  auto market = get_string(obj, FIELD_MARKET_TICKER);
+  if (!market) {
+    return std::unexpected(market.error());
+  }
+  auto trade_id = get_string(obj, FIELD_TRADE_ID);
+  if (!trade_id) {
+    return std::unexpected(trade_id.error());
+  }
+  auto order_id = get_string(obj, FIELD_ORDER_ID);
+  if (!order_id) {
+    return std::unexpected(order_id.error());
+  }
+  auto side = get_side(obj, FIELD_SIDE);
+  if (!side) {
+    return std::unexpected(side.error());
+  }
+  auto action_str = get_string(obj, FIELD_ACTION);
+  if (!action_str) {
+    return std::unexpected(action_str.error());
+  }
+  auto action = parse_action(*action_str);
+  if (!action) {
+    return std::unexpected(action.error());
+  }
+  auto yes_price = get_price(obj, FIELD_YES_PRICE);
+  if (!yes_price) {
+    return std::unexpected(yes_price.error());
+  }
+  auto count = get_count(obj, FIELD_COUNT);
+  if (!count) {
+    return std::unexpected(count.error());
+  }
+  auto is_taker = get_bool(obj, FIELD_IS_TAKER);
+  if (!is_taker) {
+    return std::unexpected(is_taker.error());
+  }
+
+  return FillEvent{.market_ticker = std::move(*market),
+                   .trade_id = std::move(*trade_id),
+                   .order_id = std::move(*order_id),
+                   .client_order_id =
+                       get_optional_string(obj, FIELD_CLIENT_ORDER_ID),
+                   .side = *side,
+                   .action = *action,
+                   .yes_price = *yes_price,
+                   .count = *count,
+                   .is_taker = *is_taker,
+                   .ts = parse_optional_timestamp(obj)};
+}
+
+std::expected<UserOrderEvent, ParseError>
+parse_user_order_fields(simdjson::ondemand::object &obj) {
+  auto market = get_string(obj, FIELD_TICKER);
+  if (!market) {
+    return std::unexpected(market.error());
+  }
+  auto order_id = get_string(obj, FIELD_ORDER_ID);
+  if (!order_id) {
+    return std::unexpected(order_id.error());
+  }
+  auto status_str = get_string(obj, FIELD_STATUS);
+  if (!status_str) {
+    return std::unexpected(status_str.error());
+  }
+  auto status = parse_order_status(*status_str);
+  if (!status) {
+    return std::unexpected(status.error());
+  }
+  auto side = get_side(obj, FIELD_SIDE);
+  if (!side) {
+    return std::unexpected(side.error());
+  }
+  auto yes_price = get_price(obj, FIELD_YES_PRICE);
+  if (!yes_price) {
+    return std::unexpected(yes_price.error());
+  }
+  auto fill_count = get_count(obj, FIELD_FILL_COUNT);
+  if (!fill_count) {
+    return std::unexpected(fill_count.error());
+  }
+  auto remaining_count = get_count(obj, FIELD_REMAINING_COUNT);
+  if (!remaining_count) {
+    return std::unexpected(remaining_count.error());
+  }
+
+  return UserOrderEvent{.market_ticker = std::move(*market),
+                        .order_id = std::move(*order_id),
+                        .client_order_id =
+                            get_optional_string(obj, FIELD_CLIENT_ORDER_ID),
+                        .status = *status,
+                        .side = *side,
+                        .yes_price = *yes_price,
+                        .fill_count = *fill_count,
+                        .remaining_count = *remaining_count,
+                        .ts = parse_optional_timestamp(obj)};
+}
+
 } // namespace
 
 std::expected<OrderbookSnapshot, ParseError>
 parse_orderbook_snapshot(std::string_view json) {
-  simdjson::ondemand::parser parser;
-  simdjson::padded_string padded(json.data(), json.size());
-  auto doc = parser.iterate(padded);
+  auto doc = iterate_document(json);
   if (doc.error()) {
     return std::unexpected(ParseError::InvalidJson);
   }
@@ -299,23 +467,22 @@ parse_orderbook_snapshot(std::string_view json) {
     return std::unexpected(msg.error());
   }
 
-  auto fields = parse_snapshot_fields(*msg);
+  std::expected<OrderbookSnapshot, ParseError> snapshot(
+      std::in_place, OrderbookSnapshot{.market_ticker = {},
+                                       .sequence = *seq,
+                                       .yes = {},
+                                       .no = {},
+                                       .ts = Timestamp{0}});
+  auto fields = parse_snapshot_fields(*msg, *snapshot);
   if (!fields) {
     return std::unexpected(fields.error());
   }
-
-  return OrderbookSnapshot{.market_ticker = std::move(fields->market),
-                           .sequence = *seq,
-                           .yes = std::move(fields->yes),
-                           .no = std::move(fields->no),
-                           .ts = Timestamp{0}};
+  return snapshot;
 }
 
 std::expected<OrderbookDelta, ParseError>
 parse_orderbook_delta(std::string_view json) {
-  simdjson::ondemand::parser parser;
-  simdjson::padded_string padded(json.data(), json.size());
-  auto doc = parser.iterate(padded);
+  auto doc = iterate_document(json);
   if (doc.error()) {
     return std::unexpected(ParseError::InvalidJson);
   }
@@ -345,9 +512,7 @@ parse_orderbook_delta(std::string_view json) {
 }
 
 std::expected<TradeEvent, ParseError> parse_trade_event(std::string_view json) {
-  simdjson::ondemand::parser parser;
-  simdjson::padded_string padded(json.data(), json.size());
-  auto doc = parser.iterate(padded);
+  auto doc = iterate_document(json);
   if (doc.error()) {
     return std::unexpected(ParseError::InvalidJson);
   }
@@ -370,4 +535,118 @@ std::expected<TradeEvent, ParseError> parse_trade_event(std::string_view json) {
                     .ts = fields->ts};
 }
 
+std::expected<FillEvent, ParseError> parse_fill_event(std::string_view json) {
+  auto doc = iterate_document(json);
+  if (doc.error()) {
+    return std::unexpected(ParseError::InvalidJson);
+  }
+
+  auto msg = get_message_object(doc);
+  if (!msg) {
+    return std::unexpected(msg.error());
+  }
+  return parse_fill_fields(*msg);
+}
+
+std::expected<UserOrderEvent, ParseError>
+parse_user_order_event(std::string_view json) {
+  auto doc = iterate_document(json);
+  if (doc.error()) {
+    return std::unexpected(ParseError::InvalidJson);
+  }
+
+  auto msg = get_message_object(doc);
+  if (!msg) {
+    return std::unexpected(msg.error());
+  }
+  return parse_user_order_fields(*msg);
+}
+
+std::expected<ControlEvent, ParseError>
+parse_control_event(std::string_view json) {
+  auto doc = iterate_document(json);
+  if (doc.error()) {
+    return std::unexpected(ParseError::InvalidJson);
+  }
+
+  auto type_field = doc[FIELD_TYPE].get_string();
+  if (type_field.error()) {
+    return std::unexpected(ParseError::MissingType);
+  }
+  auto type = classify_message_type(type_field.value());
+
+  std::optional<std::int64_t> id;
+  auto id_field = doc[FIELD_ID].get_int64();
+  if (!id_field.error()) {
+    id = id_field.value();
+  }
+  std::optional<std::uint64_t> top_sid;
+  auto sid_field = doc[FIELD_SID].get_uint64();
+  if (!sid_field.error()) {
+    top_sid = sid_field.value();
+  }
+
+  if (type == MessageType::Unsubscribed) {
+    if (!top_sid) {
+      return std::unexpected(ParseError::MissingField);
+    }
+    return UnsubscribedEvent{.id = id, .sid = *top_sid};
+  }
+
+  auto msg = get_message_object(doc);
+
+  if (type == MessageType::Subscribed) {
+    if (!msg) {
+      return std::unexpected(msg.error());
+    }
+    auto channel = get_string(*msg, FIELD_CHANNEL);
+    if (!channel) {
+      return std::unexpected(channel.error());
+    }
+    auto sid = get_int(*msg, FIELD_SID);
+    if (!sid) {
+      return std::unexpected(sid.error());
+    }
+    if (*sid < 0) {
+      return std::unexpected(ParseError::InvalidField);
+    }
+    return SubscribedEvent{.id = id,
+                           .channel = std::move(*channel),
+                           .sid = static_cast<std::uint64_t>(*sid)};
+  }
+
+  if (type == MessageType::UpdateOk) {
+    UpdateOkEvent event{.id = id, .sid = top_sid, .market_tickers = {}};
+    if (msg) {
+      auto tickers = (*msg)[FIELD_MARKET_TICKERS].get_array();
+      if (!tickers.error()) {
+        for (auto ticker : tickers) {
+          auto value = ticker.get_string();
+          if (value.error()) {
+            return std::unexpected(ParseError::InvalidField);
+          }
+          event.market_tickers.emplace_back(value.value());
+        }
+      }
+    }
+    return event;
+  }
+
+  if (type == MessageType::Error) {
+    if (!msg) {
+      return std::unexpected(msg.error());
+    }
+    auto code = get_int(*msg, FIELD_CODE);
+    if (!code) {
+      return std::unexpected(code.error());
+    }
+    auto message = get_optional_string(*msg, FIELD_MSG);
+    return CommandErrorEvent{.id = id,
+                             .code = *code,
+                             .message = message.value_or(std::string())};
+  }
+
+  return std::unexpected(ParseError::UnsupportedType);
+}
+
 } // namespace kalshi::md
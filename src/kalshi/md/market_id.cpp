@@ -0,0 +1,30 @@
+#include "kalshi/md/model/market_id.hpp"
+
+namespace kalshi::md {
+
+std::string_view event_ticker(std::string_view market_ticker) {
+  auto dash = market_ticker.rfind('-');
+  return dash == std::string_view::npos ? market_ticker
+                                        : market_ticker.substr(0, dash);
+}
+
+MarketId MarketIdTable::intern(std::string_view ticker) {
+  auto it = ids_.find(ticker);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  auto id = static_cast<MarketId>(tickers_.size());
+  tickers_.emplace_back(ticker);
+  ids_.emplace(tickers_.back(), id);
+  return id;
+}
+
+std::optional<MarketId> MarketIdTable::find(std::string_view ticker) const {
+  auto it = ids_.find(ticker);
+  if (it == ids_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+} // namespace kalshi::md
@@ -0,0 +1,236 @@
+#include "kalshi/md/model/market_signals.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace kalshi::md {
+
+namespace {
+
+constexpr double NOT_A_PRICE = std::numeric_limits<double>::quiet_NaN();
+
+/** Highest price with its bit set, -1 if none. */
+int highest(const std::array<std::uint64_t, 2> &bits) {
+  if (bits[1] != 0) {
+    return 127 - std::countl_zero(bits[1]);
+  }
+  if (bits[0] != 0) {
+    return 63 - std::countl_zero(bits[0]);
+  }
+  return -1;
+}
+
+void set_bit(std::array<std::uint64_t, 2> &bits, Price price, bool on) {
+  auto mask = std::uint64_t{1} << (price & 63);
+  auto &word = bits[price >> 6];
+  word = on ? word | mask : word & ~mask;
+}
+
+std::size_t index(BookSide side) { return side == BookSide::Yes ? 0 : 1; }
+
+} // namespace
+
+MarketSignals::MarketSignals(SignalOptions options) : options_(options) {
+  options_.depth_levels =
+      std::clamp<std::uint32_t>(options_.depth_levels, 1, SIGNAL_MAX_DEPTH);
+  options_.mid_alpha = std::clamp(options_.mid_alpha, 1e-9, 1.0);
+  options_.long_window =
+      std::clamp<std::uint32_t>(options_.long_window, 1, SIGNAL_VOL_CAPACITY);
+  options_.short_window =
+      std::clamp<std::uint32_t>(options_.short_window, 1, options_.long_window);
+  options_.flow_window =
+      std::clamp<std::uint32_t>(options_.flow_window, 1, SIGNAL_FLOW_CAPACITY);
+
+  auto capacity = static_cast<std::size_t>(options_.market_capacity);
+  states_ = std::make_unique<State[]>(capacity);
+  changes_ = std::make_unique<std::int16_t[]>(capacity * options_.long_window);
+  flows_ = std::make_unique<std::int32_t[]>(capacity * options_.flow_window);
+  for (auto *column : {&mid_, &ewma_mid_, &microprice_, &book_imbalance_,
+                       &flow_imbalance_, &short_volatility_, &long_volatility_}) {
+    *column = std::make_unique<double[]>(capacity);
+  }
+  std::fill_n(mid_.get(), capacity, NOT_A_PRICE);
+  std::fill_n(ewma_mid_.get(), capacity, NOT_A_PRICE);
+  std::fill_n(microprice_.get(), capacity, NOT_A_PRICE);
+  for (std::size_t id = 0; id < capacity; ++id) {
+    states_[id].mid2 = -1;
+  }
+}
+
+std::optional<MarketId> MarketSignals::market(std::string_view market_ticker) {
+  if (auto id = ids_.find(market_ticker)) {
+    return id;
+  }
+  if (ids_.size() == options_.market_capacity) {
+    return std::nullopt;
+  }
+  return ids_.intern(market_ticker);
+}
+
+void MarketSignals::rebuild_depth(State &state, std::size_t side) const {
+  auto bits = state.occupied[side];
+  const auto &levels = state.levels[side];
+  std::uint64_t depth = 0;
+  Price floor = 0;
+  std::uint32_t counted = 0;
+  while (counted < options_.depth_levels) {
+    auto price = highest(bits);
+    if (price < 0) {
+      break;
+    }
+    floor = static_cast<Price>(price);
+    depth += levels[floor];
+    set_bit(bits, floor, false);
+    ++counted;
+  }
+  state.depth[side] = depth;
+  // Short of levels, any new level belongs to the top ones.
+  state.floor[side] = counted == options_.depth_levels ? floor : Price{0};
+}
+
+void MarketSignals::push_change(MarketId id, State &state,
+                                std::int32_t change) {
+  auto window = options_.long_window;
+  auto *ring = changes_.get() + static_cast<std::size_t>(id) * window;
+  auto square = [](std::int32_t c) {
+    return static_cast<std::uint64_t>(c * c);
+  };
+  if (state.vol_count == window) {
+    state.long_sum -= square(ring[state.vol_head]);
+  }
+  auto short_window = options_.short_window;
+  if (state.vol_count >= short_window) {
+    auto leaving = state.vol_head >= short_window
+                       ? state.vol_head - short_window
+                       : state.vol_head + window - short_window;
+    state.short_sum -= square(ring[leaving]);
+  }
+  ring[state.vol_head] = static_cast<std::int16_t>(change);
+  state.vol_head = state.vol_head + 1 == window ? 0 : state.vol_head + 1;
+  state.vol_count = std::min(state.vol_count + 1, window);
+  state.short_sum += square(change);
+  state.long_sum += square(change);
+  // Changes are in half cents: mid = mid2 / 2.
+  short_volatility_[id] = std::sqrt(static_cast<double>(state.short_sum)) / 2.0;
+  long_volatility_[id] = std::sqrt(static_cast<double>(state.long_sum)) / 2.0;
+}
+
+void MarketSignals::refresh(MarketId id, State &state, bool count_change) {
+  auto total = state.depth[0] + state.depth[1];
+  book_imbalance_[id] =
+      total == 0 ? 0.0
+                 : (static_cast<double>(state.depth[0]) -
+                    static_cast<double>(state.depth[1])) /
+                       static_cast<double>(total);
+
+  auto yes = highest(state.occupied[0]);
+  auto no = highest(state.occupied[1]);
+  if (yes < 0 || no < 0) {
+    state.mid2 = -1;
+    mid_[id] = NOT_A_PRICE;
+    microprice_[id] = NOT_A_PRICE;
+    return;
+  }
+  auto bid = yes;
+  auto ask = static_cast<int>(PRICE_MAX) - no;
+  auto bid_size = static_cast<double>(state.levels[0][static_cast<std::size_t>(yes)]);
+  auto ask_size = static_cast<double>(state.levels[1][static_cast<std::size_t>(no)]);
+  auto mid2 = bid + ask;
+  auto mid = static_cast<double>(mid2) / 2.0;
+  mid_[id] = mid;
+  microprice_[id] = (bid * ask_size + ask * bid_size) / (bid_size + ask_size);
+  auto &ewma = ewma_mid_[id];
+  ewma = std::isnan(ewma) ? mid : ewma + options_.mid_alpha * (mid - ewma);
+  if (count_change && state.mid2 >= 0 && mid2 != state.mid2) {
+    push_change(id, state, mid2 - state.mid2);
+  }
+  state.mid2 = mid2;
+}
+
+MarketSignal MarketSignals::signal(MarketId id) const {
+  return MarketSignal{.mid = mid_[id],
+                      .ewma_mid = ewma_mid_[id],
+                      .microprice = microprice_[id],
+                      .book_imbalance = book_imbalance_[id],
+                      .flow_imbalance = flow_imbalance_[id],
+                      .short_volatility = short_volatility_[id],
+                      .long_volatility = long_volatility_[id]};
+}
+
+void MarketSignals::on_snapshot(const OrderbookSnapshot &s) {
+  auto id = market(s.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &state = states_[*id];
+  for (auto side : {BookSide::Yes, BookSide::No}) {
+    auto i = index(side);
+    state.levels[i].fill(0);
+    state.occupied[i] = {0, 0};
+    for (const auto &level : side == BookSide::Yes ? s.yes : s.no) {
+      state.levels[i][level.price] = level.size;
+      set_bit(state.occupied[i], level.price, level.size != 0);
+    }
+    rebuild_depth(state, i);
+  }
+  refresh(*id, state, false);
+}
+
+void MarketSignals::on_delta(const OrderbookDelta &d) {
+  auto id = market(d.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &state = states_[*id];
+  auto side = index(d.side);
+  auto &level = state.levels[side][d.price];
+  auto before = level;
+  auto updated = static_cast<std::int64_t>(before) + d.delta;
+  level = updated > 0 ? static_cast<Size>(updated) : Size{0};
+  if (d.price >= state.floor[side]) {
+    if ((before == 0) != (level == 0)) {
+      // A top level appeared or emptied: the set of top levels moved.
+      set_bit(state.occupied[side], d.price, level != 0);
+      rebuild_depth(state, side);
+    } else {
+      state.depth[side] = state.depth[side] + level - before;
+    }
+  } else if ((before == 0) != (level == 0)) {
+    set_bit(state.occupied[side], d.price, level != 0);
+  }
+  refresh(*id, state, true);
+}
+
+void MarketSignals::on_trade(const TradeEvent &t) {
+  auto id = market(t.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &state = states_[*id];
+  auto window = options_.flow_window;
+  auto *ring = flows_.get() + static_cast<std::size_t>(*id) * window;
+  if (state.flow_count == window) {
+    auto leaving = ring[state.flow_head];
+    state.flow_net -= leaving;
+    state.flow_total -= static_cast<std::uint64_t>(std::abs(leaving));
+  }
+  auto count = static_cast<std::int32_t>(
+      std::min<Count>(t.count, std::numeric_limits<std::int32_t>::max()));
+  auto signed_count = t.taker_side == BookSide::Yes ? count : -count;
+  ring[state.flow_head] = signed_count;
+  state.flow_head = state.flow_head + 1 == window ? 0 : state.flow_head + 1;
+  state.flow_count = std::min(state.flow_count + 1, window);
+  state.flow_net += signed_count;
+  state.flow_total += static_cast<std::uint64_t>(count);
+  flow_imbalance_[*id] =
+      state.flow_total == 0 ? 0.0
+                            : static_cast<double>(state.flow_net) /
+                                  static_cast<double>(state.flow_total);
+}
+
+} // namespace kalshi::md
@@ -1,20 +1,53 @@
 #include "kalshi/md/parse/message_parser.hpp"
 
+#include "kalshi/md/parse/json_document.hpp"
 #include "kalshi/md/parse/json_fields.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <string>
+
 #include <simdjson.h>
 
 namespace kalshi::md {
 
-std::expected<std::string, ParseError>
+namespace {
+
+/** Per-thread parser and padded buffer shared by all payload parsing. */
+struct ParseScratch {
+  simdjson::ondemand::parser parser;
+  std::string buffer;
+};
+
+} // namespace
+
+simdjson::simdjson_result<simdjson::ondemand::document>
+iterate_document(std::string_view json) {
+  thread_local ParseScratch scratch;
+  auto padded_size = json.size() + simdjson::SIMDJSON_PADDING;
+  if (scratch.buffer.size() < padded_size) {
+    // Grow geometrically, parser included, so a run of ever larger
+    // messages only reallocates a handful of times.
+    scratch.buffer.resize(std::max(padded_size, 2 * scratch.buffer.size()));
+    auto error = scratch.parser.allocate(scratch.buffer.size());
+    if (error) {
+      return error;
+    }
+  }
+  std::memcpy(scratch.buffer.data(), json.data(), json.size());
+  std::memset(scratch.buffer.data() + json.size(), 0,
+              simdjson::SIMDJSON_PADDING);
+  return scratch.parser.iterate(scratch.buffer.data(), json.size(),
+                                scratch.buffer.size());
+}
+
+std::expected<MessageType, ParseError>
 parse_message_type(std::string_view json) {
   if (json.empty()) {
     return std::unexpected(ParseError::EmptyMessage);
   }
 
-  simdjson::ondemand::parser parser;
-  simdjson::padded_string padded(json.data(), json.size());
-  auto doc = parser.iterate(padded);
+  auto doc = iterate_document(json);
   if (doc.error()) {
     return std::unexpected(ParseError::InvalidJson);
   }
@@ -29,7 +62,37 @@ parse_message_type(std::string_view json) {
     return std::unexpected(ParseError::MissingType);
   }
 
-  return std::string(type_str.value());
+  return classify_message_type(type_str.value());
+}
+
+std::expected<SequenceHeader, ParseError>
+parse_sequence_header(std::string_view json) {
+  if (json.empty()) {
+    return std::unexpected(ParseError::EmptyMessage);
+  }
+
+  auto doc = iterate_document(json);
+  if (doc.error()) {
+    return std::unexpected(ParseError::InvalidJson);
+  }
+
+  SequenceHeader header;
+  auto type = doc[FIELD_TYPE].get_string();
+  if (!type.error()) {
+    header.type = classify_message_type(type.value());
+  }
+
+  auto sid = doc[FIELD_SID].get_uint64();
+  if (sid.error()) {
+    return std::unexpected(ParseError::MissingField);
+  }
+  header.sid = sid.value();
+
+  auto seq = doc[FIELD_SEQ].get_uint64();
+  if (!seq.error()) {
+    header.seq = seq.value();
+  }
+  return header;
 }
 
 } // namespace kalshi::md
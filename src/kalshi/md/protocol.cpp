@@ -79,4 +79,34 @@ std::string SubscriptionCommand::build_json(const SubscribeRequest& req)
   return out.str();
 }
 
+std::string build_update_subscription_json(int id,
+                                           std::uint64_t sid,
+                                           UpdateAction action,
+                                           const std::vector<std::string>& market_tickers)
+{
+  std::ostringstream out;
+  out << "{\"id\":" << id << ",\"cmd\":\"update_subscription\",\"params\":{";
+  out << "\"sids\":[" << sid << "],\"market_tickers\":";
+  append_string_array(out, market_tickers);
+  out << ",\"action\":\""
+      << (action == UpdateAction::AddMarkets ? "add_markets" : "delete_markets") << "\"}}";
+  return out.str();
+}
+
+std::string build_unsubscribe_json(int id, const std::vector<std::uint64_t>& sids)
+{
+  std::ostringstream out;
+  out << "{\"id\":" << id << ",\"cmd\":\"unsubscribe\",\"params\":{\"sids\":[";
+  for (std::size_t i = 0; i < sids.size(); ++i)
+  {
+    out << sids[i];
+    if (i + 1 < sids.size())
+    {
+      out << ",";
+    }
+  }
+  out << "]}}";
+  return out.str();
+}
+
 } // namespace kalshi::md
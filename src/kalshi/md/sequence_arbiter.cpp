@@ -0,0 +1,225 @@
+#include "kalshi/md/sequence_arbiter.hpp"
+
+namespace kalshi::md {
+
+namespace {
+
+constexpr std::string_view MSG_KEY = "\"msg\":";
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+} // namespace
+
+std::uint64_t message_fingerprint(std::string_view json) {
+  auto pos = json.find(MSG_KEY);
+  if (pos != std::string_view::npos) {
+    json.remove_prefix(pos);
+  }
+  std::uint64_t hash = FNV_OFFSET;
+  for (char c : json) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+SequenceArbiter::SequenceArbiter(std::size_t legs)
+    : live_(legs, false), wins_(legs, 0), legs_(legs) {}
+
+bool SequenceArbiter::accept(std::size_t leg, std::uint64_t stream,
+                             std::optional<std::uint64_t> seq,
+                             std::uint64_t fingerprint) {
+  if (stream > ARBITER_MAX_STREAM) {
+    ++delivered_;
+    return true;
+  }
+  ensure_stream(stream);
+  live_[leg] = true;
+
+  auto &s = streams_[stream];
+  auto &l = legs_[leg][stream];
+
+  // Without a sequence there is nothing to arbitrate on; follow one leg.
+  if (!seq) {
+    if (!s.started || s.leader == leg || !live_[s.leader]) {
+      s.started = true;
+      s.leader = leg;
+      ++delivered_;
+      ++wins_[leg];
+      return true;
+    }
+    ++duplicates_;
+    return false;
+  }
+
+  if (!l.aligned) {
+    if (!s.started) {
+      l.aligned = true;
+      l.caught_up = true;
+      l.offset = 0;
+      s.started = true;
+      s.leader = leg;
+    } else if (!has_other_aligned_leg(leg, stream)) {
+      l.aligned = true;
+      l.caught_up = true;
+      l.offset = static_cast<std::int64_t>(s.high_water) + 1 -
+                 static_cast<std::int64_t>(*seq);
+      s.leader = leg;
+      ++epoch_restarts_;
+    } else if (!try_align(leg, stream, *seq, fingerprint)) {
+      ++unaligned_drops_;
+      return false;
+    }
+  }
+
+  auto canonical = static_cast<std::int64_t>(*seq) + l.offset;
+  auto next = static_cast<std::int64_t>(s.high_water) + 1;
+  if (!l.caught_up) {
+    if (canonical == next || !has_other_aligned_leg(leg, stream)) {
+      l.caught_up = true;
+    } else if (canonical > next) {
+      ++unaligned_drops_;
+      return false;
+    }
+  }
+  if (canonical < next) {
+    ++duplicates_;
+    return false;
+  }
+
+  s.high_water = static_cast<std::uint64_t>(canonical);
+  record(leg, stream, s.high_water, fingerprint);
+  ++delivered_;
+  ++wins_[leg];
+  return true;
+}
+
+void SequenceArbiter::on_leg_down(std::size_t leg) {
+  live_[leg] = false;
+  for (auto &state : legs_[leg]) {
+    state.aligned = false;
+    state.caught_up = false;
+    state.confirmations = 0;
+    state.pending_size = 0;
+    state.pending_next = 0;
+  }
+}
+
+void SequenceArbiter::reset_stream(std::size_t leg, std::uint64_t stream) {
+  if (stream >= streams_.size()) {
+    return;
+  }
+  auto &l = legs_[leg][stream];
+  l.aligned = false;
+  l.caught_up = false;
+  l.confirmations = 0;
+  l.pending_size = 0;
+  l.pending_next = 0;
+  if (!has_other_aligned_leg(leg, stream)) {
+    auto &s = streams_[stream];
+    s.started = false;
+    s.high_water = 0;
+    s.history.clear();
+    s.history_next = 0;
+  }
+}
+
+void SequenceArbiter::ensure_stream(std::uint64_t stream) {
+  if (stream < streams_.size()) {
+    return;
+  }
+  auto size = static_cast<std::size_t>(stream) + 1;
+  streams_.resize(size);
+  for (auto &leg : legs_) {
+    leg.resize(size);
+  }
+}
+
+bool SequenceArbiter::has_other_aligned_leg(std::size_t leg,
+                                            std::uint64_t stream) const {
+  for (std::size_t other = 0; other < legs_.size(); ++other) {
+    if (other != leg && live_[other] && legs_[other][stream].aligned) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SequenceArbiter::try_align(std::size_t leg, std::uint64_t stream,
+                                std::uint64_t seq, std::uint64_t fingerprint) {
+  auto &s = streams_[stream];
+  auto &l = legs_[leg][stream];
+
+  // Behind the leader: the message has already been delivered.
+  for (std::size_t i = 0; i < s.history.size(); ++i) {
+    auto idx = (s.history_next + s.history.size() - 1 - i) % s.history.size();
+    const auto &entry = s.history[idx];
+    if (entry.canonical == 0) {
+      break;
+    }
+    if (entry.fingerprint == fingerprint) {
+      note_candidate(l,
+                     static_cast<std::int64_t>(entry.canonical) -
+                         static_cast<std::int64_t>(seq),
+                     false);
+      return l.aligned;
+    }
+  }
+
+  // Possibly ahead of the leader: remember it and match on delivery.
+  if (l.pending.empty()) {
+    l.pending.resize(ARBITER_HISTORY);
+  }
+  l.pending[l.pending_next] = PendingEntry{fingerprint, seq};
+  l.pending_next = (l.pending_next + 1) % l.pending.size();
+  if (l.pending_size < l.pending.size()) {
+    ++l.pending_size;
+  }
+  return false;
+}
+
+void SequenceArbiter::note_candidate(LegStream &state, std::int64_t candidate,
+                                     bool ahead) {
+  if (state.confirmations > 0 && state.candidate == candidate) {
+    ++state.confirmations;
+  } else {
+    state.candidate = candidate;
+    state.confirmations = 1;
+  }
+  if (state.confirmations >= ARBITER_ALIGN_CONFIRMATIONS) {
+    state.aligned = true;
+    state.caught_up = !ahead;
+    state.offset = candidate;
+    state.pending_size = 0;
+    state.pending_next = 0;
+  }
+}
+
+void SequenceArbiter::record(std::size_t leg, std::uint64_t stream,
+                             std::uint64_t canonical,
+                             std::uint64_t fingerprint) {
+  auto &s = streams_[stream];
+  if (s.history.empty()) {
+    s.history.resize(ARBITER_HISTORY);
+  }
+  s.history[s.history_next] = HistoryEntry{fingerprint, canonical};
+  s.history_next = (s.history_next + 1) % s.history.size();
+
+  for (std::size_t other = 0; other < legs_.size(); ++other) {
+    auto &l = legs_[other][stream];
+    if (other == leg || l.aligned || !live_[other] || l.pending_size == 0) {
+      continue;
+    }
+    for (std::size_t i = 0; i < l.pending_size; ++i) {
+      if (l.pending[i].fingerprint == fingerprint) {
+        note_candidate(l,
+                       static_cast<std::int64_t>(canonical) -
+                           static_cast<std::int64_t>(l.pending[i].local),
+                       true);
+        break;
+      }
+    }
+  }
+}
+
+} // namespace kalshi::md
@@ -0,0 +1,214 @@
+#include "kalshi/md/shm/shm_publisher.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <utility>
+
+namespace kalshi::md {
+
+std::expected<ShmPublisher, ShmError>
+ShmPublisher::create(const std::string &name, Options options) {
+  if (options.market_capacity == 0 || options.ring_capacity < SHM_RING_MIN ||
+      !std::has_single_bit(options.ring_capacity)) {
+    return std::unexpected(ShmError::InvalidOptions);
+  }
+  auto layout = shm_layout(options.market_capacity, options.ring_capacity);
+  auto region = ShmRegion::create(name, layout.size);
+  if (!region) {
+    return std::unexpected(region.error());
+  }
+  return ShmPublisher(std::move(*region), options);
+}
+
+ShmPublisher::ShmPublisher(ShmRegion region, Options options)
+    : region_(std::move(region)), market_capacity_(options.market_capacity),
+      ring_mask_(options.ring_capacity - 1) {
+  auto layout = shm_layout(options.market_capacity, options.ring_capacity);
+  auto *base = region_.data();
+  header_ = new (base) ShmHeader{};
+  markets_ = reinterpret_cast<ShmMarket *>(base + layout.markets_offset);
+  ring_ = reinterpret_cast<ShmSlot *>(base + layout.ring_offset);
+  for (std::uint32_t i = 0; i < options.market_capacity; ++i) {
+    new (&markets_[i]) ShmMarket{};
+  }
+  for (std::uint64_t i = 0; i < options.ring_capacity; ++i) {
+    new (&ring_[i]) ShmSlot{};
+  }
+  header_->layout_version = SHM_LAYOUT_VERSION;
+  header_->market_capacity = options.market_capacity;
+  header_->ring_capacity = options.ring_capacity;
+  header_->segment_size = layout.size;
+  header_->magic.store(SHM_MAGIC, std::memory_order_release);
+}
+
+std::optional<MarketId> ShmPublisher::market(std::string_view market_ticker) {
+  if (auto id = ids_.find(market_ticker)) {
+    return id;
+  }
+  if (ids_.size() == market_capacity_ ||
+      market_ticker.size() > SHM_TICKER_CAPACITY) {
+    return std::nullopt;
+  }
+  auto id = ids_.intern(market_ticker);
+  states_.emplace_back();
+  auto &slot = markets_[id];
+  std::copy(market_ticker.begin(), market_ticker.end(), slot.ticker.begin());
+  slot.ticker_length = static_cast<std::uint32_t>(market_ticker.size());
+  slot.top.write(states_[id].top);
+  header_->market_count.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+void ShmPublisher::update_best(MarketState &state, BookSide side, Price price,
+                               Size size) {
+  auto yes = side == BookSide::Yes;
+  auto &best_price = yes ? state.top.yes_price : state.top.no_price;
+  auto &best_size = yes ? state.top.yes_size : state.top.no_size;
+  if (size > 0 && (price >= best_price || best_size == 0)) {
+    best_price = price;
+    best_size = size;
+  } else if (price == best_price) {
+    // The best level emptied: rescan below it.
+    auto best = state.book.best(side);
+    best_price = best.value_or(0);
+    best_size = best ? state.book.size(side, *best) : 0;
+  }
+}
+
+void ShmPublisher::publish_top(MarketId id, const MarketState &state) {
+  markets_[id].top.write(state.top);
+}
+
+void ShmPublisher::append(const ShmEvent &event) {
+  auto &slot = ring_[head_ & ring_mask_];
+  slot.version.store(2 * head_ + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.event.store(event);
+  slot.version.store(2 * head_ + 2, std::memory_order_release);
+  ++head_;
+  header_->head.store(head_, std::memory_order_release);
+}
+
+void ShmPublisher::on_snapshot(const OrderbookSnapshot &s) {
+  auto id = market(s.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &state = states_[*id];
+  state.book.apply(s);
+  for (auto side : {BookSide::Yes, BookSide::No}) {
+    auto best = state.book.best(side);
+    auto best_size = best ? state.book.size(side, *best) : Size{0};
+    if (side == BookSide::Yes) {
+      state.top.yes_price = best.value_or(0);
+      state.top.yes_size = best_size;
+    } else {
+      state.top.no_price = best.value_or(0);
+      state.top.no_size = best_size;
+    }
+  }
+  state.top.sequence = s.sequence;
+  state.top.ts_ns = s.ts.count();
+  publish_top(*id, state);
+
+  append(ShmEvent{.kind = ShmEventKind::Snapshot,
+                  .market = *id,
+                  .sequence = s.sequence,
+                  .ts_ns = s.ts.count(),
+                  .side = BookSide::Yes,
+                  .price = 0,
+                  .no_price = 0,
+                  .quantity = static_cast<std::int64_t>(s.yes.size() +
+                                                        s.no.size()),
+                  .status = MarketStatus::Unopened});
+  auto append_levels = [&](const PriceLevels &levels, BookSide side) {
+    for (const auto &level : levels) {
+      append(ShmEvent{.kind = ShmEventKind::SnapshotLevel,
+                      .market = *id,
+                      .sequence = s.sequence,
+                      .ts_ns = s.ts.count(),
+                      .side = side,
+                      .price = level.price,
+                      .no_price = 0,
+                      .quantity = level.size,
+                      .status = MarketStatus::Unopened});
+    }
+  };
+  append_levels(s.yes, BookSide::Yes);
+  append_levels(s.no, BookSide::No);
+}
+
+void ShmPublisher::on_delta(const OrderbookDelta &d) {
+  auto id = market(d.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &state = states_[*id];
+  auto size = state.book.apply(d);
+  update_best(state, d.side, d.price, size);
+  state.top.sequence = d.sequence;
+  state.top.ts_ns = d.ts.count();
+  publish_top(*id, state);
+  append(ShmEvent{.kind = ShmEventKind::BookDelta,
+                  .market = *id,
+                  .sequence = d.sequence,
+                  .ts_ns = d.ts.count(),
+                  .side = d.side,
+                  .price = d.price,
+                  .no_price = 0,
+                  .quantity = d.delta,
+                  .status = MarketStatus::Unopened});
+}
+
+void ShmPublisher::on_trade(const TradeEvent &t) {
+  auto id = market(t.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &state = states_[*id];
+  state.top.last_trade_price = t.yes_price;
+  state.top.last_trade_count = t.count;
+  state.top.ts_ns = t.ts.count();
+  publish_top(*id, state);
+  append(ShmEvent{.kind = ShmEventKind::Trade,
+                  .market = *id,
+                  .sequence = 0,
+                  .ts_ns = t.ts.count(),
+                  .side = t.taker_side,
+                  .price = t.yes_price,
+                  .no_price = t.no_price,
+                  .quantity = t.count,
+                  .status = MarketStatus::Unopened});
+}
+
+void ShmPublisher::on_status(const MarketStatusUpdate &u) {
+  auto id = market(u.market_ticker);
+  if (!id) {
+    ++dropped_;
+    return;
+  }
+  auto &state = states_[*id];
+  state.top.status = u.status;
+  state.top.has_status = true;
+  state.top.ts_ns = u.ts.count();
+  publish_top(*id, state);
+  append(ShmEvent{.kind = ShmEventKind::Status,
+                  .market = *id,
+                  .sequence = 0,
+                  .ts_ns = u.ts.count(),
+                  .side = BookSide::Yes,
+                  .price = 0,
+                  .no_price = 0,
+                  .quantity = 0,
+                  .status = u.status});
+}
+
+void ShmPublisher::close() {
+  header_->closed.store(1, std::memory_order_release);
+}
+
+} // namespace kalshi::md
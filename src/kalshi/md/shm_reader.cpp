@@ -0,0 +1,60 @@
+#include "kalshi/md/shm/shm_reader.hpp"
+
+#include <utility>
+
+namespace kalshi::md {
+
+std::expected<ShmReader, ShmError> ShmReader::open(const std::string &name) {
+  auto region = ShmRegion::open(name);
+  if (!region) {
+    return std::unexpected(region.error());
+  }
+  if (region->size() < sizeof(ShmHeader)) {
+    return std::unexpected(ShmError::NotReady);
+  }
+  const auto *header = reinterpret_cast<const ShmHeader *>(region->data());
+  if (header->magic.load(std::memory_order_acquire) != SHM_MAGIC) {
+    return std::unexpected(ShmError::NotReady);
+  }
+  auto layout = shm_layout(header->market_capacity, header->ring_capacity);
+  if (header->layout_version != SHM_LAYOUT_VERSION ||
+      header->segment_size != region->size() || layout.size != region->size()) {
+    return std::unexpected(ShmError::LayoutMismatch);
+  }
+  return ShmReader(std::move(*region));
+}
+
+ShmReader::ShmReader(ShmRegion region) : region_(std::move(region)) {
+  const auto *base = region_.data();
+  header_ = reinterpret_cast<const ShmHeader *>(base);
+  auto layout = shm_layout(header_->market_capacity, header_->ring_capacity);
+  markets_ = reinterpret_cast<const ShmMarket *>(base + layout.markets_offset);
+  ring_ = reinterpret_cast<const ShmSlot *>(base + layout.ring_offset);
+  ring_capacity_ = header_->ring_capacity;
+  ring_mask_ = ring_capacity_ - 1;
+  seek_latest();
+}
+
+std::optional<MarketId> ShmReader::find(std::string_view market_ticker) {
+  if (auto id = ids_.find(market_ticker)) {
+    return id;
+  }
+  // Ids are dense and assigned in order, so interning the new slots in
+  // order reproduces the publisher's ids.
+  auto count = market_count();
+  for (auto id = static_cast<MarketId>(ids_.size()); id < count; ++id) {
+    ids_.intern(ticker(id));
+  }
+  return ids_.find(market_ticker);
+}
+
+void ShmReader::skip_lapped() {
+  // Resume half a ring behind the head so the reader is not lapped again
+  // straight away.
+  auto head = header_->head.load(std::memory_order_acquire);
+  auto resume = head - ring_capacity_ / 2;
+  lost_ += resume - cursor_;
+  cursor_ = resume;
+}
+
+} // namespace kalshi::md
@@ -0,0 +1,102 @@
+#include "kalshi/md/shm/shm_layout.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kalshi::md {
+
+const char *to_string(ShmError error) {
+  switch (error) {
+  case ShmError::InvalidOptions:
+    return "invalid options";
+  case ShmError::OpenFailed:
+    return "shm_open failed";
+  case ShmError::ResizeFailed:
+    return "ftruncate failed";
+  case ShmError::MapFailed:
+    return "mmap failed";
+  case ShmError::NotReady:
+    return "segment not initialized";
+  case ShmError::LayoutMismatch:
+    return "segment layout mismatch";
+  }
+  return "unknown shm error";
+}
+
+std::expected<ShmRegion, ShmError> ShmRegion::create(const std::string &name,
+                                                     std::size_t size) {
+  // Readers of a stale segment keep their mapping; new readers get ours.
+  ::shm_unlink(name.c_str());
+  int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    return std::unexpected(ShmError::OpenFailed);
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    return std::unexpected(ShmError::ResizeFailed);
+  }
+  void *base =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    ::shm_unlink(name.c_str());
+    return std::unexpected(ShmError::MapFailed);
+  }
+  return ShmRegion(name, base, size);
+}
+
+std::expected<ShmRegion, ShmError> ShmRegion::open(const std::string &name) {
+  int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return std::unexpected(ShmError::OpenFailed);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return std::unexpected(ShmError::NotReady);
+  }
+  auto size = static_cast<std::size_t>(st.st_size);
+  void *base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    return std::unexpected(ShmError::MapFailed);
+  }
+  return ShmRegion({}, base, size);
+}
+
+ShmRegion::ShmRegion(ShmRegion &&other) noexcept
+    : owned_name_(std::move(other.owned_name_)),
+      base_(std::exchange(other.base_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {
+  other.owned_name_.clear();
+}
+
+ShmRegion &ShmRegion::operator=(ShmRegion &&other) noexcept {
+  if (this != &other) {
+    release();
+    owned_name_ = std::move(other.owned_name_);
+    other.owned_name_.clear();
+    base_ = std::exchange(other.base_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+ShmRegion::~ShmRegion() { release(); }
+
+void ShmRegion::release() {
+  if (base_ != nullptr) {
+    ::munmap(base_, size_);
+    base_ = nullptr;
+    size_ = 0;
+  }
+  if (!owned_name_.empty()) {
+    ::shm_unlink(owned_name_.c_str());
+    owned_name_.clear();
+  }
+}
+
+} // namespace kalshi::md
@@ -0,0 +1,287 @@
+#include "kalshi/md/protocol/subscription_manager.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "kalshi/md/protocol/message_types.hpp"
+
+namespace kalshi::md
+{
+
+namespace
+{
+
+std::vector<std::string> difference(const std::set<std::string>& lhs,
+                                    const std::set<std::string>& rhs)
+{
+  std::vector<std::string> out;
+  std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(out));
+  return out;
+}
+
+} // namespace
+
+SubscriptionManager::SubscriptionManager(const SubscribeRequest& initial) : next_id_(initial.id)
+{
+  for (const auto& name : initial.channels)
+  {
+    channels_.push_back(Channel{.name = name,
+                                .all_markets = initial.market_tickers.empty(),
+                                .desired = {initial.market_tickers.begin(),
+                                            initial.market_tickers.end()},
+                                .active = {},
+                                .sid = std::nullopt,
+                                .pending = false,
+                                .request_id = 0,
+                                .removed = false});
+  }
+}
+
+std::vector<std::string> SubscriptionManager::on_connected()
+{
+  on_disconnected();
+  connected_ = true;
+
+  // Channels sharing a market set go out in one subscribe command, which
+  // keeps the initial config-driven subscription a single request.
+  std::vector<std::string> out;
+  std::vector<bool> grouped(channels_.size(), false);
+  for (std::size_t i = 0; i < channels_.size(); ++i)
+  {
+    if (grouped[i])
+    {
+      continue;
+    }
+    std::vector<Channel*> group{&channels_[i]};
+    for (std::size_t j = i + 1; j < channels_.size(); ++j)
+    {
+      if (!grouped[j] && channels_[j].all_markets == channels_[i].all_markets &&
+          channels_[j].desired == channels_[i].desired)
+      {
+        grouped[j] = true;
+        group.push_back(&channels_[j]);
+      }
+    }
+    subscribe(out, std::move(group));
+  }
+  return out;
+}
+
+void SubscriptionManager::on_disconnected()
+{
+  connected_ = false;
+  for (auto& channel : channels_)
+  {
+    channel.pending = false;
+  }
+  erase_removed();
+  for (auto& channel : channels_)
+  {
+    channel.sid.reset();
+    channel.active.clear();
+  }
+}
+
+std::vector<std::string> SubscriptionManager::on_subscribed(std::string_view channel,
+                                                            std::uint64_t sid)
+{
+  std::vector<std::string> out;
+  auto* entry = find(channel);
+  if (!entry || !entry->pending)
+  {
+    return out;
+  }
+  entry->sid = sid;
+  entry->pending = false;
+  reconcile(out, *entry);
+  return out;
+}
+
+std::vector<std::string> SubscriptionManager::on_command_failed(std::int64_t id)
+{
+  std::vector<std::string> rejected;
+  for (auto& channel : channels_)
+  {
+    if (channel.pending && channel.request_id == id)
+    {
+      rejected.push_back(channel.name);
+      channel.pending = false;
+      channel.removed = true;
+    }
+  }
+  erase_removed();
+  return rejected;
+}
+
+std::expected<std::vector<std::string>, SubscribeError> SubscriptionManager::add_markets(
+    std::string_view channel, const std::vector<std::string>& market_tickers)
+{
+  std::vector<std::string> out;
+  auto* entry = find(channel);
+  if (!entry)
+  {
+    if (market_tickers.empty() && channel == ORDERBOOK_DELTA)
+    {
+      return std::unexpected(SubscribeError::MissingMarketTickers);
+    }
+    channels_.push_back(Channel{.name = std::string(channel),
+                                .all_markets = market_tickers.empty(),
+                                .desired = {market_tickers.begin(), market_tickers.end()},
+                                .active = {},
+                                .sid = std::nullopt,
+                                .pending = false,
+                                .request_id = 0,
+                                .removed = false});
+    if (connected_)
+    {
+      subscribe(out, {&channels_.back()});
+    }
+    return out;
+  }
+
+  if (entry->removed)
+  {
+    // Re-added before the pending unsubscribe went out.
+    entry->removed = false;
+    entry->all_markets = market_tickers.empty();
+    entry->desired.clear();
+  }
+  if (entry->all_markets)
+  {
+    return out;
+  }
+  entry->desired.insert(market_tickers.begin(), market_tickers.end());
+  reconcile(out, *entry);
+  return out;
+}
+
+std::expected<std::vector<std::string>, SubscribeError> SubscriptionManager::remove_markets(
+    std::string_view channel, const std::vector<std::string>& market_tickers)
+{
+  std::vector<std::string> out;
+  auto* entry = find(channel);
+  if (!entry || entry->removed)
+  {
+    return std::unexpected(SubscribeError::UnknownChannel);
+  }
+  if (entry->all_markets)
+  {
+    return out;
+  }
+  for (const auto& ticker : market_tickers)
+  {
+    entry->desired.erase(ticker);
+  }
+  if (entry->desired.empty())
+  {
+    entry->removed = true;
+  }
+  reconcile(out, *entry);
+  return out;
+}
+
+std::expected<std::vector<std::string>, SubscribeError> SubscriptionManager::remove_channel(
+    std::string_view channel)
+{
+  std::vector<std::string> out;
+  auto* entry = find(channel);
+  if (!entry || entry->removed)
+  {
+    return std::unexpected(SubscribeError::UnknownChannel);
+  }
+  entry->removed = true;
+  reconcile(out, *entry);
+  return out;
+}
+
+std::optional<std::string_view> SubscriptionManager::channel_for_sid(std::uint64_t sid) const
+{
+  for (const auto& channel : channels_)
+  {
+    if (channel.sid == sid)
+    {
+      return std::string_view(channel.name);
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<std::string> SubscriptionManager::markets(std::string_view channel) const
+{
+  const auto* entry = find(channel);
+  if (!entry || entry->removed)
+  {
+    return {};
+  }
+  return {entry->desired.begin(), entry->desired.end()};
+}
+
+SubscriptionManager::Channel* SubscriptionManager::find(std::string_view channel)
+{
+  auto it = std::find_if(channels_.begin(),
+                         channels_.end(),
+                         [channel](const Channel& entry) { return entry.name == channel; });
+  return it == channels_.end() ? nullptr : &*it;
+}
+
+const SubscriptionManager::Channel* SubscriptionManager::find(std::string_view channel) const
+{
+  auto it = std::find_if(channels_.begin(),
+                         channels_.end(),
+                         [channel](const Channel& entry) { return entry.name == channel; });
+  return it == channels_.end() ? nullptr : &*it;
+}
+
+void SubscriptionManager::subscribe(std::vector<std::string>& out, std::vector<Channel*> group)
+{
+  SubscribeRequest request{.id = next_id_++, .channels = {}, .market_tickers = {}};
+  auto request_id = request.id;
+  const auto& desired = group.front()->desired;
+  request.market_tickers.assign(desired.begin(), desired.end());
+  for (auto* channel : group)
+  {
+    request.channels.push_back(channel->name);
+    channel->pending = true;
+    channel->request_id = request_id;
+    channel->active = channel->desired;
+  }
+  out.push_back(SubscriptionCommand(std::move(request)).json());
+}
+
+void SubscriptionManager::reconcile(std::vector<std::string>& out, Channel& channel)
+{
+  // Without a connection, or while the subscribe is in flight, only the
+  // desired set changes; on_connected/on_subscribed pick it up.
+  if (connected_ && !channel.pending && channel.sid)
+  {
+    if (channel.removed)
+    {
+      out.push_back(build_unsubscribe_json(next_id_++, {*channel.sid}));
+    }
+    else
+    {
+      auto added = difference(channel.desired, channel.active);
+      auto deleted = difference(channel.active, channel.desired);
+      if (!added.empty())
+      {
+        out.push_back(build_update_subscription_json(
+            next_id_++, *channel.sid, UpdateAction::AddMarkets, added));
+      }
+      if (!deleted.empty())
+      {
+        out.push_back(build_update_subscription_json(
+            next_id_++, *channel.sid, UpdateAction::DeleteMarkets, deleted));
+      }
+      channel.active = channel.desired;
+    }
+  }
+  erase_removed();
+}
+
+void SubscriptionManager::erase_removed()
+{
+  std::erase_if(channels_,
+                [](const Channel& channel) { return channel.removed && !channel.pending; });
+}
+
+} // namespace kalshi::md
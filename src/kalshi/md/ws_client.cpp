@@ -3,6 +3,7 @@
 #include <utility>
 
 #include <boost/asio/connect.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 
@@ -52,7 +53,12 @@ std::expected<WsUrl, WsError> parse_ws_url(std::string_view url) {
 
 WsClient::WsClient(boost::asio::io_context &ioc,
                    boost::asio::ssl::context &ssl_ctx)
-    : resolver_(ioc), ws_(ioc, ssl_ctx) {}
+    : resolver_(ioc), ws_(ioc, ssl_ctx), outbound_(OUTBOUND_QUEUE_CAPACITY),
+      throttle_timer_(ioc) {
+  for (auto &slot : outbound_) {
+    slot.reserve(OUTBOUND_SLOT_RESERVE);
+  }
+}
 
 void WsClient::set_message_callback(MessageCallback cb) {
   on_message_ = std::move(cb);
@@ -64,6 +70,17 @@ void WsClient::set_open_callback(OpenCallback cb) { on_open_ = std::move(cb); }
 void WsClient::set_control_callback(ControlCallback cb) {
   on_control_ = std::move(cb);
 }
+void WsClient::set_read_idle_callback(ReadIdleCallback cb) {
+  on_read_idle_ = std::move(cb);
+}
+
+void WsClient::set_connection_cache(ConnectionCache *cache) {
+  cache_ = cache;
+}
+
+void WsClient::set_rate_limit(kalshi::TokenBucket *bucket) {
+  rate_limit_ = bucket;
+}
 
 void WsClient::set_timeouts(std::chrono::seconds handshake_timeout,
                             std::chrono::seconds idle_timeout,
@@ -83,21 +100,32 @@ void WsClient::connect(const std::string &url,
 
   headers_ = headers;
   host_ = std::move(parsed->host);
+  port_ = std::move(parsed->port);
   target_ = std::move(parsed->target);
-  std::string port = parsed->port;
 
   configure_timeouts();
   configure_headers();
   configure_control_callback();
-  resolve_host(std::move(port));
+  resolve_host(port_);
 }
 
-void WsClient::send_text(std::string payload) {
-  ws_.async_write(boost::asio::buffer(payload),
-                  boost::beast::bind_front_handler(&WsClient::on_write, this));
+std::expected<void, WsError> WsClient::send_text(std::string_view payload) {
+  if (out_size_ == outbound_.size()) {
+    return std::unexpected(WsError::WriteQueueFull);
+  }
+  auto &slot = outbound_[(out_head_ + out_size_) % outbound_.size()];
+  slot.assign(payload.data(), payload.size());
+  ++out_size_;
+  if (open_ && !writing_) {
+    do_write();
+  }
+  return {};
 }
 
 void WsClient::close() {
+  stopped_ = true;
+  open_ = false;
+  throttle_timer_.cancel();
   boost::system::error_code ec;
   ws_.close(boost::beast::websocket::close_code::normal, ec);
 }
@@ -109,42 +137,57 @@ void WsClient::on_resolve(
     fail(WsError::ResolveFailed, ec.message());
     return;
   }
+  if (cache_ && !used_cached_endpoints_) {
+    cache_->store_endpoints(host_, port_, results);
+  }
 
   boost::beast::get_lowest_layer(ws_).expires_after(CONNECT_TIMEOUT);
   boost::beast::get_lowest_layer(ws_).async_connect(
-      results, boost::beast::bind_front_handler(&WsClient::on_connect, this));
+      results, boost::beast::bind_front_handler(&WsClient::on_connect, shared_from_this()));
 }
 
 void WsClient::on_connect(
     boost::system::error_code ec,
     boost::asio::ip::tcp::resolver::results_type::endpoint_type) {
   if (ec) {
+    if (cache_) {
+      cache_->invalidate_endpoints();
+    }
     fail(WsError::ConnectFailed, ec.message());
     return;
   }
 
-  if (!SSL_set_tlsext_host_name(ws_.next_layer().native_handle(),
-                                host_.c_str())) {
+  SSL *ssl = ws_.next_layer().native_handle();
+  if (!SSL_set_tlsext_host_name(ssl, host_.c_str())) {
     boost::system::error_code ssl_ec{static_cast<int>(::ERR_get_error()),
                                      boost::asio::error::get_ssl_category()};
     fail(WsError::SslHandshakeFailed, ssl_ec.message());
     return;
   }
+  if (cache_ && cache_->session()) {
+    SSL_set_session(ssl, cache_->session());
+  }
 
   ws_.next_layer().async_handshake(
       boost::asio::ssl::stream_base::client,
-      boost::beast::bind_front_handler(&WsClient::on_ssl_handshake, this));
+      boost::beast::bind_front_handler(&WsClient::on_ssl_handshake,
+                                        shared_from_this()));
 }
 
 void WsClient::on_ssl_handshake(boost::system::error_code ec) {
   if (ec) {
+    if (cache_) {
+      cache_->clear_session();
+    }
     fail(WsError::SslHandshakeFailed, ec.message());
     return;
   }
+  session_resumed_ = SSL_session_reused(ws_.next_layer().native_handle()) == 1;
 
   ws_.async_handshake(
       host_, target_,
-      boost::beast::bind_front_handler(&WsClient::on_ws_handshake, this));
+      boost::beast::bind_front_handler(&WsClient::on_ws_handshake,
+                                        shared_from_this()));
 }
 
 void WsClient::on_ws_handshake(boost::system::error_code ec) {
@@ -153,15 +196,21 @@ void WsClient::on_ws_handshake(boost::system::error_code ec) {
     return;
   }
 
+  open_ = true;
+  ws_.text(true);
   if (on_open_) {
     on_open_();
   }
+  if (out_size_ > 0 && !writing_) {
+    do_write();
+  }
   do_read();
 }
 
 void WsClient::do_read() {
   ws_.async_read(buffer_,
-                 boost::beast::bind_front_handler(&WsClient::on_read, this));
+                 boost::beast::bind_front_handler(&WsClient::on_read,
+                                        shared_from_this()));
 }
 
 void WsClient::on_read(boost::system::error_code ec, std::size_t) {
@@ -170,21 +219,101 @@ void WsClient::on_read(boost::system::error_code ec, std::size_t) {
     return;
   }
 
+  // TLS 1.3 tickets arrive after the handshake, so the session becomes
+  // resumable only once application data has flowed.
+  if (!session_saved_) {
+    save_session();
+  }
+
   if (on_message_) {
     auto msg = boost::beast::buffers_to_string(buffer_.data());
     on_message_(std::move(msg));
   }
   buffer_.consume(buffer_.size());
   do_read();
+
+  // A read whose data is already buffered completes through the executor
+  // queue ahead of this check; the check re-queues itself until a read
+  // actually has to wait for the network.
+  if (on_read_idle_) {
+    if (idle_check_posted_) {
+      read_since_idle_check_ = true;
+    } else {
+      idle_check_posted_ = true;
+      read_since_idle_check_ = false;
+      boost::asio::post(ws_.get_executor(),
+                        [self = shared_from_this()] { self->check_read_idle(); });
+    }
+  }
+}
+
+void WsClient::check_read_idle() {
+  if (read_since_idle_check_) {
+    read_since_idle_check_ = false;
+    boost::asio::post(ws_.get_executor(),
+                        [self = shared_from_this()] { self->check_read_idle(); });
+    return;
+  }
+  idle_check_posted_ = false;
+  on_read_idle_();
+}
+
+void WsClient::do_write() {
+  writing_ = true;
+  if (rate_limit_ != nullptr) {
+    // The queue holds the message, so any wait is acceptable; the token is
+    // committed now and the write goes out when it is due.
+    auto wait = rate_limit_->reserve(kalshi::TokenBucket::Clock::now(), 1,
+                                     std::chrono::nanoseconds::max());
+    if (wait && wait->count() > 0) {
+      throttle_timer_.expires_after(*wait);
+      throttle_timer_.async_wait(
+          [self = shared_from_this()](boost::system::error_code ec) {
+            if (ec || !self->open_) {
+              // Reconnect restarts the drain from on_ws_handshake.
+              self->writing_ = false;
+              return;
+            }
+            self->start_write();
+          });
+      return;
+    }
+  }
+  start_write();
+}
+
+void WsClient::start_write() {
+  ws_.async_write(boost::asio::buffer(outbound_[out_head_]),
+                  boost::beast::bind_front_handler(&WsClient::on_write,
+                                        shared_from_this()));
 }
 
 void WsClient::on_write(boost::system::error_code ec, std::size_t) {
+  writing_ = false;
   if (ec) {
+    out_head_ = 0;
+    out_size_ = 0;
     fail(WsError::WriteFailed, ec.message());
+    return;
+  }
+
+  out_head_ = (out_head_ + 1) % outbound_.size();
+  --out_size_;
+  // Drain everything that queued up behind the completed write back to back.
+  if (out_size_ > 0 && open_) {
+    do_write();
   }
 }
 
 void WsClient::fail(WsError err, std::string_view msg) {
+  // Report once: after the first failure or a close, operations still in
+  // flight complete with errors that say nothing new.
+  if (stopped_) {
+    return;
+  }
+  stopped_ = true;
+  open_ = false;
+  throttle_timer_.cancel();
   if (on_error_) {
     on_error_(err, msg);
   }
@@ -217,9 +346,24 @@ void WsClient::configure_control_callback() {
 }
 
 void WsClient::resolve_host(std::string port) {
+  if (cache_) {
+    if (auto cached = cache_->endpoints(host_, port)) {
+      used_cached_endpoints_ = true;
+      on_resolve({}, std::move(*cached));
+      return;
+    }
+  }
   resolver_.async_resolve(
       host_, port,
-      boost::beast::bind_front_handler(&WsClient::on_resolve, this));
+      boost::beast::bind_front_handler(&WsClient::on_resolve,
+                                        shared_from_this()));
+}
+
+void WsClient::save_session() {
+  session_saved_ = true;
+  if (cache_) {
+    cache_->store_session(SSL_get1_session(ws_.next_layer().native_handle()));
+  }
 }
 
 } // namespace kalshi::md
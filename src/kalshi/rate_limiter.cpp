@@ -0,0 +1,94 @@
+#include "kalshi/core/rate_limiter.hpp"
+
+#include <algorithm>
+
+namespace kalshi
+{
+
+  TokenBucket::TokenBucket(RateLimit limit)
+      : limit_(limit),
+        interval_ns_(1'000'000'000 / std::max<std::int64_t>(1, limit.per_second)),
+        tolerance_ns_(interval_ns_ * limit.burst),
+        full_at_ns_(0)
+  {
+  }
+
+  bool TokenBucket::try_acquire(Clock::time_point now, std::uint32_t tokens)
+  {
+    return reserve(now, tokens, std::chrono::nanoseconds::zero()).has_value();
+  }
+
+  std::optional<std::chrono::nanoseconds> TokenBucket::reserve(Clock::time_point now,
+                                                               std::uint32_t tokens,
+                                                               std::chrono::nanoseconds max_wait)
+  {
+    auto now_ns = ticks(now);
+    auto cost = interval_ns_ * tokens;
+    auto full_at = full_at_ns_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      auto next = std::max(full_at, now_ns) + cost;
+      auto wait = next - now_ns - tolerance_ns_;
+      if (wait > max_wait.count())
+      {
+        throttled_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+      }
+      if (full_at_ns_.compare_exchange_weak(full_at, next, std::memory_order_relaxed))
+      {
+        if (wait <= 0)
+        {
+          granted_.fetch_add(tokens, std::memory_order_relaxed);
+          return std::chrono::nanoseconds::zero();
+        }
+        delayed_.fetch_add(tokens, std::memory_order_relaxed);
+        waited_ns_.fetch_add(wait, std::memory_order_relaxed);
+        return std::chrono::nanoseconds(wait);
+      }
+    }
+  }
+
+  std::chrono::nanoseconds TokenBucket::available_in(Clock::time_point now, std::uint32_t tokens) const
+  {
+    auto now_ns = ticks(now);
+    auto next = std::max(full_at_ns_.load(std::memory_order_relaxed), now_ns) + interval_ns_ * tokens;
+    return std::chrono::nanoseconds(std::max<std::int64_t>(0, next - now_ns - tolerance_ns_));
+  }
+
+  RateLimitStats TokenBucket::stats() const
+  {
+    return RateLimitStats{.granted = granted_.load(std::memory_order_relaxed),
+                          .delayed = delayed_.load(std::memory_order_relaxed),
+                          .throttled = throttled_.load(std::memory_order_relaxed),
+                          .waited = std::chrono::nanoseconds(waited_ns_.load(std::memory_order_relaxed))};
+  }
+
+  std::int64_t TokenBucket::ticks(Clock::time_point t)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+  }
+
+  const char *to_string(RateLimitEndpoint endpoint)
+  {
+    switch (endpoint)
+    {
+    case RateLimitEndpoint::RestRead:
+      return "rest_read";
+    case RateLimitEndpoint::RestWrite:
+      return "rest_write";
+    case RateLimitEndpoint::WsCommand:
+      return "ws_command";
+    case RateLimitEndpoint::Count_:
+      break;
+    }
+    return "unknown";
+  }
+
+  RateLimiter::RateLimiter(RateLimits limits)
+      : buckets_{std::make_unique<TokenBucket>(limits.rest_read),
+                 std::make_unique<TokenBucket>(limits.rest_write),
+                 std::make_unique<TokenBucket>(limits.ws_command)}
+  {
+  }
+
+} // namespace kalshi
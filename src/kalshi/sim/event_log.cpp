@@ -0,0 +1,255 @@
+#include "kalshi/sim/event_log.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <utility>
+
+#include "kalshi/md/dispatcher.hpp"
+
+namespace kalshi::sim {
+
+namespace {
+
+constexpr std::size_t EVENTS_ALIGN = 64;
+
+constexpr std::uint64_t align_up(std::uint64_t value, std::uint64_t align) {
+  return (value + align - 1) / align * align;
+}
+
+} // namespace
+
+const char *to_string(EventLogError error) {
+  switch (error) {
+  case EventLogError::CaptureOpenFailed:
+    return "capture open failed";
+  case EventLogError::OutputOpenFailed:
+    return "output open failed";
+  case EventLogError::WriteFailed:
+    return "write failed";
+  case EventLogError::OpenFailed:
+    return "open failed";
+  case EventLogError::MapFailed:
+    return "mmap failed";
+  case EventLogError::LayoutMismatch:
+    return "event log layout mismatch";
+  }
+  return "unknown event log error";
+}
+
+void EventLogWriter::on_snapshot(const md::OrderbookSnapshot &s) {
+  auto id = market(s.market_ticker);
+  events_.push_back(md::ShmEvent{
+      .kind = md::ShmEventKind::Snapshot,
+      .market = id,
+      .sequence = s.sequence,
+      .ts_ns = s.ts.count(),
+      .side = md::BookSide::Yes,
+      .price = 0,
+      .no_price = 0,
+      .quantity = static_cast<std::int64_t>(s.yes.size() + s.no.size()),
+      .status = md::MarketStatus::Unopened});
+  auto append_levels = [&](const md::PriceLevels &levels, md::BookSide side) {
+    for (const auto &level : levels) {
+      events_.push_back(md::ShmEvent{.kind = md::ShmEventKind::SnapshotLevel,
+                                     .market = id,
+                                     .sequence = s.sequence,
+                                     .ts_ns = s.ts.count(),
+                                     .side = side,
+                                     .price = level.price,
+                                     .no_price = 0,
+                                     .quantity = level.size,
+                                     .status = md::MarketStatus::Unopened});
+    }
+  };
+  append_levels(s.yes, md::BookSide::Yes);
+  append_levels(s.no, md::BookSide::No);
+}
+
+void EventLogWriter::on_delta(const md::OrderbookDelta &d) {
+  events_.push_back(md::ShmEvent{.kind = md::ShmEventKind::BookDelta,
+                                 .market = market(d.market_ticker),
+                                 .sequence = d.sequence,
+                                 .ts_ns = d.ts.count(),
+                                 .side = d.side,
+                                 .price = d.price,
+                                 .no_price = 0,
+                                 .quantity = d.delta,
+                                 .status = md::MarketStatus::Unopened});
+}
+
+void EventLogWriter::on_trade(const md::TradeEvent &t) {
+  events_.push_back(md::ShmEvent{.kind = md::ShmEventKind::Trade,
+                                 .market = market(t.market_ticker),
+                                 .sequence = 0,
+                                 .ts_ns = t.ts.count(),
+                                 .side = t.taker_side,
+                                 .price = t.yes_price,
+                                 .no_price = t.no_price,
+                                 .quantity = t.count,
+                                 .status = md::MarketStatus::Unopened});
+}
+
+void EventLogWriter::on_status(const md::MarketStatusUpdate &u) {
+  events_.push_back(md::ShmEvent{.kind = md::ShmEventKind::Status,
+                                 .market = market(u.market_ticker),
+                                 .sequence = 0,
+                                 .ts_ns = u.ts.count(),
+                                 .side = md::BookSide::Yes,
+                                 .price = 0,
+                                 .no_price = 0,
+                                 .quantity = 0,
+                                 .status = u.status});
+}
+
+std::expected<void, EventLogError>
+EventLogWriter::write(const std::string &path) const {
+  auto market_count = static_cast<std::uint32_t>(ids_.size());
+  std::vector<EventLogTicker> table;
+  table.reserve(market_count);
+  std::uint32_t chars = 0;
+  for (md::MarketId id = 0; id < market_count; ++id) {
+    auto length = static_cast<std::uint32_t>(ids_.ticker(id).size());
+    table.push_back(EventLogTicker{.offset = chars, .length = length});
+    chars += length;
+  }
+
+  auto events_offset = align_up(sizeof(EventLogHeader), EVENTS_ALIGN);
+  auto tickers_offset =
+      events_offset + events_.size() * sizeof(md::ShmEvent);
+  auto file_size =
+      tickers_offset + table.size() * sizeof(EventLogTicker) + chars;
+  EventLogHeader header{.magic = EVENT_LOG_MAGIC,
+                        .version = EVENT_LOG_VERSION,
+                        .market_count = market_count,
+                        .event_count = events_.size(),
+                        .events_offset = events_offset,
+                        .tickers_offset = tickers_offset,
+                        .file_size = file_size};
+
+  std::ofstream out{path, std::ios::out | std::ios::binary | std::ios::trunc};
+  if (!out.is_open()) {
+    return std::unexpected(EventLogError::OutputOpenFailed);
+  }
+  const char padding[EVENTS_ALIGN] = {};
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(padding,
+            static_cast<std::streamsize>(events_offset - sizeof(header)));
+  out.write(reinterpret_cast<const char *>(events_.data()),
+            static_cast<std::streamsize>(events_.size() * sizeof(md::ShmEvent)));
+  out.write(reinterpret_cast<const char *>(table.data()),
+            static_cast<std::streamsize>(table.size() * sizeof(EventLogTicker)));
+  for (md::MarketId id = 0; id < market_count; ++id) {
+    const auto &ticker = ids_.ticker(id);
+    out.write(ticker.data(), static_cast<std::streamsize>(ticker.size()));
+  }
+  out.flush();
+  if (!out) {
+    return std::unexpected(EventLogError::WriteFailed);
+  }
+  return {};
+}
+
+std::expected<CaptureStats, EventLogError>
+convert_capture(const std::string &capture_path, const std::string &log_path) {
+  std::ifstream in{capture_path, std::ios::in | std::ios::binary};
+  if (!in.is_open()) {
+    return std::unexpected(EventLogError::CaptureOpenFailed);
+  }
+  EventLogWriter writer;
+  md::Dispatcher<EventLogWriter> dispatcher(writer);
+  CaptureStats stats{.messages = 0, .rejected = 0, .events = 0};
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    ++stats.messages;
+    if (!dispatcher.on_message(line)) {
+      ++stats.rejected;
+    }
+  }
+  stats.events = writer.event_count();
+  if (auto written = writer.write(log_path); !written) {
+    return std::unexpected(written.error());
+  }
+  return stats;
+}
+
+std::expected<EventLog, EventLogError> EventLog::open(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::unexpected(EventLogError::OpenFailed);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) < sizeof(EventLogHeader)) {
+    ::close(fd);
+    return std::unexpected(EventLogError::LayoutMismatch);
+  }
+  auto size = static_cast<std::size_t>(st.st_size);
+  void *base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    return std::unexpected(EventLogError::MapFailed);
+  }
+  EventLog log(base, size);
+
+  const auto *bytes = static_cast<const std::byte *>(base);
+  const auto &header = *reinterpret_cast<const EventLogHeader *>(bytes);
+  auto table_end = header.tickers_offset +
+                   std::uint64_t{header.market_count} * sizeof(EventLogTicker);
+  if (header.magic != EVENT_LOG_MAGIC || header.version != EVENT_LOG_VERSION ||
+      header.file_size != size || header.events_offset % EVENTS_ALIGN != 0 ||
+      header.events_offset + header.event_count * sizeof(md::ShmEvent) !=
+          header.tickers_offset ||
+      table_end > size) {
+    return std::unexpected(EventLogError::LayoutMismatch);
+  }
+  log.events_ = {reinterpret_cast<const md::ShmEvent *>(bytes + header.events_offset),
+                 header.event_count};
+  const auto *table =
+      reinterpret_cast<const EventLogTicker *>(bytes + header.tickers_offset);
+  const auto *chars = reinterpret_cast<const char *>(bytes + table_end);
+  log.tickers_.reserve(header.market_count);
+  for (std::uint32_t i = 0; i < header.market_count; ++i) {
+    if (table_end + table[i].offset + table[i].length > size) {
+      return std::unexpected(EventLogError::LayoutMismatch);
+    }
+    log.tickers_.emplace_back(chars + table[i].offset, table[i].length);
+  }
+  return log;
+}
+
+EventLog::EventLog(void *base, std::size_t size) : base_(base), size_(size) {}
+
+EventLog::EventLog(EventLog &&other) noexcept
+    : base_(std::exchange(other.base_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      events_(std::exchange(other.events_, {})),
+      tickers_(std::move(other.tickers_)) {}
+
+EventLog &EventLog::operator=(EventLog &&other) noexcept {
+  if (this != &other) {
+    release();
+    base_ = std::exchange(other.base_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    events_ = std::exchange(other.events_, {});
+    tickers_ = std::move(other.tickers_);
+  }
+  return *this;
+}
+
+EventLog::~EventLog() { release(); }
+
+void EventLog::release() {
+  if (base_ != nullptr) {
+    ::munmap(base_, size_);
+    base_ = nullptr;
+  }
+}
+
+} // namespace kalshi::sim
@@ -0,0 +1,282 @@
+#include "kalshi/sim/matching_engine.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace kalshi::sim {
+
+namespace {
+
+std::size_t side_index(md::BookSide side) {
+  return side == md::BookSide::Yes ? 0 : 1;
+}
+
+md::BookSide other(md::BookSide side) {
+  return side == md::BookSide::Yes ? md::BookSide::No : md::BookSide::Yes;
+}
+
+} // namespace
+
+MatchingEngine::MatchingEngine(MatchingOptions options)
+    : market_capacity_(options.market_capacity),
+      markets_(std::make_unique<Market[]>(options.market_capacity)),
+      orders_(options.order_capacity, options.client_id_prefix),
+      open_(options.market_capacity, options.order_capacity),
+      resting_(std::make_unique<Resting[]>(options.order_capacity)) {}
+
+void MatchingEngine::on_snapshot(const md::OrderbookSnapshot &s) {
+  auto id = market(s.market_ticker);
+  if (!id) {
+    return;
+  }
+  ++stats_.snapshots;
+  auto &m = markets_[*id];
+  m.book.apply(s);
+  m.traded = {};
+  open_.for_each(*id, [&](trade::OrderHandle handle) {
+    auto &r = resting_[handle.index];
+    r.ahead = std::min<std::uint64_t>(r.ahead, m.book.size(r.side, r.price));
+  });
+}
+
+void MatchingEngine::on_delta(const md::OrderbookDelta &d) {
+  auto id = market(d.market_ticker);
+  if (!id) {
+    return;
+  }
+  ++stats_.deltas;
+  if (d.ts.count() != 0) {
+    now_ = d.ts;
+  }
+  auto &m = markets_[*id];
+  if (open_.empty(*id)) {
+    m.book.apply(d);
+    return;
+  }
+  auto before = m.book.size(d.side, d.price);
+  auto after = m.book.apply(d);
+  if (after < before) {
+    level_reduced(*id, m, d.side, d.price, before, after);
+  } else if (after > before) {
+    level_added(*id, d.side, d.price, after - before);
+  }
+}
+
+void MatchingEngine::on_trade(const md::TradeEvent &t) {
+  auto id = ids_.find(t.market_ticker);
+  if (!id) {
+    return;
+  }
+  ++stats_.trades;
+  if (t.ts.count() != 0) {
+    now_ = t.ts;
+  }
+  if (open_.empty(*id)) {
+    return;
+  }
+  // The taker bought its side from bids on the other side.
+  auto side = other(t.taker_side);
+  auto price = side == md::BookSide::Yes ? t.yes_price : t.no_price;
+  std::uint64_t available = t.count;
+  bool at_level = false;
+  open_.for_each(*id, [&](trade::OrderHandle handle) {
+    auto &r = resting_[handle.index];
+    if (available == 0 || r.side != side || r.price < price) {
+      return;
+    }
+    auto reach = available;
+    if (r.price == price) {
+      at_level = true;
+      auto eaten = std::min(r.ahead, reach);
+      r.ahead -= eaten;
+      reach -= eaten;
+    }
+    const auto *order = orders_.get(handle);
+    auto take = static_cast<std::uint32_t>(
+        std::min<std::uint64_t>(reach, order->count - order->filled));
+    if (take != 0) {
+      available -= take;
+      (void)fill(handle, r.price, take, false);
+    }
+  });
+  if (at_level) {
+    markets_[*id].traded[side_index(side)][price] += t.count;
+  }
+}
+
+void MatchingEngine::on_status(const md::MarketStatusUpdate &u) {
+  auto id = ids_.find(u.market_ticker);
+  if (id && u.status != md::MarketStatus::Open) {
+    (void)cancel_market(*id);
+  }
+}
+
+std::expected<trade::OrderHandle, trade::GatewayError>
+MatchingEngine::place(const trade::OrderSpec &spec) {
+  if (spec.market >= ids_.size()) {
+    return std::unexpected(trade::GatewayError::UnknownMarket);
+  }
+  if (spec.count == 0 || spec.price == 0 || spec.price >= md::PRICE_MAX) {
+    return std::unexpected(trade::GatewayError::InvalidOrder);
+  }
+  auto created = orders_.create(spec);
+  if (!created) {
+    return std::unexpected(trade::GatewayError::PoolExhausted);
+  }
+  auto handle = *created;
+  (void)orders_.on_ack(handle, orders_.get(handle)->client_order_id.view());
+  if (risk_ != nullptr) {
+    risk_->on_sent(spec);
+  }
+  ++stats_.placed;
+
+  // Buying NO or selling YES is a NO bid, and the reverse a YES bid.
+  auto &m = markets_[spec.market];
+  auto yes_bid = (spec.side == md::BookSide::Yes) == (spec.action == trade::OrderAction::Buy);
+  auto side = yes_bid ? md::BookSide::Yes : md::BookSide::No;
+  auto price = spec.action == trade::OrderAction::Buy
+                   ? spec.price
+                   : static_cast<md::Price>(md::PRICE_MAX - spec.price);
+  resting_[handle.index] =
+      Resting{.side = side, .price = price, .ahead = m.book.size(side, price)};
+  open_.insert(spec.market, handle);
+  m.traded[side_index(side)][price] = 0;
+
+  // Take crossed bids on the other side, best first, at their price.
+  const auto &crossed = m.book.levels(other(side));
+  auto remaining = spec.count;
+  for (auto level = static_cast<int>(md::PRICE_MAX);
+       remaining != 0 && level + static_cast<int>(price) >= static_cast<int>(md::PRICE_MAX);
+       --level) {
+    auto size = crossed[static_cast<std::size_t>(level)];
+    if (size == 0) {
+      continue;
+    }
+    auto take = std::min(size, remaining);
+    remaining -= take;
+    if (!fill(handle, static_cast<md::Price>(md::PRICE_MAX - level), take, true)) {
+      break;
+    }
+  }
+  return handle;
+}
+
+std::expected<void, trade::GatewayError>
+MatchingEngine::cancel(trade::OrderHandle handle) {
+  const auto *order = orders_.get(handle);
+  if (order == nullptr || !orders_.on_cancel(handle)) {
+    return std::unexpected(trade::GatewayError::UnknownOrder);
+  }
+  ++stats_.canceled;
+  close(handle, *order);
+  return {};
+}
+
+std::size_t MatchingEngine::cancel_market(md::MarketId market) {
+  std::size_t canceled = 0;
+  if (market >= market_capacity_) {
+    return canceled;
+  }
+  open_.for_each(market, [&](trade::OrderHandle handle) {
+    if (cancel(handle)) {
+      ++canceled;
+    }
+  });
+  return canceled;
+}
+
+std::optional<std::uint64_t>
+MatchingEngine::queue_ahead(trade::OrderHandle handle) const {
+  if (orders_.get(handle) == nullptr) {
+    return std::nullopt;
+  }
+  return resting_[handle.index].ahead;
+}
+
+std::optional<md::MarketId>
+MatchingEngine::market(std::string_view market_ticker) {
+  if (auto id = ids_.find(market_ticker)) {
+    return id;
+  }
+  if (ids_.size() >= market_capacity_) {
+    ++stats_.dropped;
+    return std::nullopt;
+  }
+  return ids_.intern(market_ticker);
+}
+
+void MatchingEngine::level_reduced(md::MarketId id, Market &m,
+                                   md::BookSide side, md::Price price,
+                                   md::Size before, md::Size after) {
+  auto &traded = m.traded[side_index(side)][price];
+  auto decrease = before - after;
+  auto explained = std::min(decrease, traded);
+  traded -= explained;
+  std::uint64_t canceled = decrease - explained;
+  open_.for_each(id, [&](trade::OrderHandle handle) {
+    auto &r = resting_[handle.index];
+    if (r.side != side || r.price != price) {
+      return;
+    }
+    r.ahead -= r.ahead * canceled / before;
+    r.ahead = std::min<std::uint64_t>(r.ahead, after);
+  });
+}
+
+void MatchingEngine::level_added(md::MarketId id, md::BookSide side,
+                                 md::Price price, md::Size added) {
+  open_.for_each(id, [&](trade::OrderHandle handle) {
+    const auto &r = resting_[handle.index];
+    if (added == 0 || r.side == side ||
+        static_cast<int>(r.price) + static_cast<int>(price) < static_cast<int>(md::PRICE_MAX)) {
+      return;
+    }
+    const auto *order = orders_.get(handle);
+    auto take = std::min(added, order->count - order->filled);
+    added -= take;
+    (void)fill(handle, r.price, take, false);
+  });
+}
+
+bool MatchingEngine::fill(trade::OrderHandle handle, md::Price book_price,
+                          std::uint32_t count, bool taker) {
+  const auto *order = orders_.get(handle);
+  auto state = orders_.on_fill(handle, count);
+  if (risk_ != nullptr) {
+    risk_->on_fill(trade::spec_of(*order), count);
+  }
+  ++(taker ? stats_.taker_fills : stats_.maker_fills);
+  stats_.filled_contracts += count;
+  if (on_fill_) {
+    auto yes_price = resting_[handle.index].side == md::BookSide::Yes
+                         ? book_price
+                         : static_cast<md::Price>(md::PRICE_MAX - book_price);
+    on_fill_(md::FillEvent{
+        .market_ticker = ids_.ticker(order->market),
+        .trade_id = std::to_string(stats_.maker_fills + stats_.taker_fills),
+        .order_id = std::string(order->order_id.view()),
+        .client_order_id = std::string(order->client_order_id.view()),
+        .side = order->side,
+        .action = order->action,
+        .yes_price = yes_price,
+        .count = count,
+        .is_taker = taker,
+        .ts = now_});
+  }
+  if (state && *state == trade::OrderState::Filled) {
+    close(handle, *order);
+    return false;
+  }
+  return true;
+}
+
+void MatchingEngine::close(trade::OrderHandle handle,
+                           const trade::Order &order) {
+  if (risk_ != nullptr) {
+    risk_->on_closed(trade::spec_of(order), order.count - order.filled);
+  }
+  open_.erase(order.market, handle);
+  orders_.release(handle);
+}
+
+} // namespace kalshi::sim
@@ -0,0 +1,193 @@
+#include "kalshi/trade/live_gateway.hpp"
+
+#include <utility>
+
+namespace kalshi::trade {
+
+LiveGateway::LiveGateway(RestClient &rest, TickerLookup ticker,
+                         std::uint32_t market_capacity,
+                         std::uint32_t order_capacity,
+                         std::string_view client_id_prefix)
+    : rest_(rest), ticker_(std::move(ticker)),
+      orders_(order_capacity, client_id_prefix),
+      open_(market_capacity, order_capacity) {}
+
+std::expected<OrderHandle, GatewayError>
+LiveGateway::place(const OrderSpec &spec) {
+  auto ticker =
+      spec.market < open_.market_capacity() ? ticker_(spec.market) : std::string_view{};
+  if (ticker.empty()) {
+    return std::unexpected(GatewayError::UnknownMarket);
+  }
+  if (spec.count == 0 || spec.price == 0 || spec.price >= md::PRICE_MAX) {
+    return std::unexpected(GatewayError::InvalidOrder);
+  }
+  auto created = orders_.create(spec);
+  if (!created) {
+    return std::unexpected(GatewayError::PoolExhausted);
+  }
+  auto handle = *created;
+  open_.insert(spec.market, handle);
+  if (risk_ != nullptr) {
+    risk_->on_sent(spec);
+  }
+
+  auto request = orders_.request(handle, ticker);
+  auto sent = rest_.create_order(
+      *request, [this, handle](std::expected<RestResponse, RestError> response) {
+        // Success is confirmed by the user_orders ack, not the response.
+        // Without a response the exchange may still have taken the order,
+        // so it is not released here.
+        if (!response) {
+          ++stats_.unconfirmed;
+        } else if (response->status >= 400) {
+          reject(handle);
+        }
+      });
+  if (!sent) {
+    (void)orders_.on_reject(handle);
+    close(handle, *orders_.get(handle));
+    return std::unexpected(GatewayError::SendFailed);
+  }
+  ++stats_.placed;
+  return handle;
+}
+
+std::expected<void, GatewayError> LiveGateway::cancel(OrderHandle handle) {
+  const auto *order = orders_.get(handle);
+  if (order == nullptr) {
+    return std::unexpected(GatewayError::UnknownOrder);
+  }
+  if (!orders_.request_cancel(handle)) {
+    return std::unexpected(GatewayError::AlreadyCanceling);
+  }
+  if (order->order_id.view().empty()) {
+    // Cancels need the exchange order id; on_user_order sends it on ack.
+    return {};
+  }
+  return send_cancel(handle, *order);
+}
+
+std::size_t LiveGateway::cancel_market(md::MarketId market) {
+  std::size_t asked = 0;
+  if (market >= open_.market_capacity()) {
+    return asked;
+  }
+  open_.for_each(market, [&](OrderHandle handle) {
+    if (cancel(handle)) {
+      ++asked;
+    }
+  });
+  return asked;
+}
+
+void LiveGateway::on_user_order(const md::UserOrderEvent &event) {
+  OrderHandle handle{};
+  const auto *order = lookup(event.client_order_id, handle);
+  if (order == nullptr) {
+    return;
+  }
+  switch (event.status) {
+  case md::UserOrderStatus::Resting:
+  case md::UserOrderStatus::Executed: {
+    if (!order->order_id.view().empty()) {
+      return;
+    }
+    // Also taken after a fill overtook the ack: it only supplies the id.
+    if (!orders_.on_ack(handle, event.order_id)) {
+      return;
+    }
+    // A cancel requested without an id was deferred to here. An executed
+    // order has nothing left to cancel.
+    if (order->cancel_requested && !is_terminal(order->state) &&
+        event.status == md::UserOrderStatus::Resting) {
+      (void)send_cancel(handle, *order); // failures are counted and cleared
+    }
+    return;
+  }
+  case md::UserOrderStatus::Canceled:
+    if (orders_.on_cancel(handle)) {
+      close(handle, *order);
+    }
+    return;
+  case md::UserOrderStatus::Pending:
+    return;
+  }
+}
+
+void LiveGateway::on_fill(const md::FillEvent &event) {
+  OrderHandle handle{};
+  const auto *order = lookup(event.client_order_id, handle);
+  if (order == nullptr) {
+    return;
+  }
+  auto state = orders_.on_fill(handle, event.count);
+  if (!state) {
+    ++stats_.unmatched;
+    return;
+  }
+  ++stats_.fills;
+  if (risk_ != nullptr) {
+    risk_->on_fill(spec_of(*order), event.count);
+  }
+  if (*state == OrderState::Filled) {
+    close(handle, *order);
+  }
+}
+
+std::expected<void, GatewayError>
+LiveGateway::send_cancel(OrderHandle handle, const Order &order) {
+  auto sent = rest_.cancel_order(
+      order.order_id.view(),
+      [this, handle](std::expected<RestResponse, RestError> response) {
+        // Success is confirmed by the user_orders cancel, not the response.
+        if (!response || response->status >= 300) {
+          cancel_failed(handle);
+        }
+      });
+  if (!sent) {
+    cancel_failed(handle);
+    return std::unexpected(GatewayError::SendFailed);
+  }
+  ++stats_.cancels_sent;
+  return {};
+}
+
+void LiveGateway::cancel_failed(OrderHandle handle) {
+  // Stale once the order closed; then there is nothing left to retry.
+  if (orders_.clear_cancel(handle)) {
+    ++stats_.cancels_failed;
+  }
+}
+
+void LiveGateway::reject(OrderHandle handle) {
+  const auto *order = orders_.get(handle);
+  if (order == nullptr || order->state != OrderState::Pending) {
+    return;
+  }
+  (void)orders_.on_reject(handle);
+  ++stats_.rejected;
+  close(handle, *order);
+}
+
+void LiveGateway::close(OrderHandle handle, const Order &order) {
+  if (risk_ != nullptr) {
+    risk_->on_closed(spec_of(order), order.count - order.filled);
+  }
+  open_.erase(order.market, handle);
+  orders_.release(handle);
+}
+
+const Order *
+LiveGateway::lookup(const std::optional<std::string> &client_order_id,
+                    OrderHandle &handle) {
+  auto found = client_order_id ? orders_.find(*client_order_id) : std::nullopt;
+  if (!found) {
+    ++stats_.unmatched;
+    return nullptr;
+  }
+  handle = *found;
+  return orders_.get(handle);
+}
+
+} // namespace kalshi::trade
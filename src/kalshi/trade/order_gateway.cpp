@@ -0,0 +1,23 @@
+#include "kalshi/trade/order_gateway.hpp"
+
+namespace kalshi::trade {
+
+const char *to_string(GatewayError error) {
+  switch (error) {
+  case GatewayError::UnknownMarket:
+    return "unknown_market";
+  case GatewayError::InvalidOrder:
+    return "invalid_order";
+  case GatewayError::PoolExhausted:
+    return "pool_exhausted";
+  case GatewayError::UnknownOrder:
+    return "unknown_order";
+  case GatewayError::AlreadyCanceling:
+    return "already_canceling";
+  case GatewayError::SendFailed:
+    return "send_failed";
+  }
+  return "unknown";
+}
+
+} // namespace kalshi::trade
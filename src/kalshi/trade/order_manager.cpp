@@ -0,0 +1,314 @@
+#include "kalshi/trade/order_manager.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <functional>
+
+namespace kalshi::trade {
+
+namespace {
+
+constexpr std::size_t STATE_COUNT = 6;
+
+// ALLOWED[from][to], in OrderState order.
+constexpr bool ALLOWED[STATE_COUNT][STATE_COUNT] = {
+    // Pending
+    {false, true, true, true, true, true},
+    // Acked
+    {false, false, true, true, true, false},
+    // PartiallyFilled
+    {false, false, true, true, true, false},
+    // Filled, Canceled, Rejected are terminal
+    {false, false, false, false, false, false},
+    {false, false, false, false, false, false},
+    {false, false, false, false, false, false},
+};
+
+} // namespace
+
+const char *to_string(OrderState state) {
+  switch (state) {
+  case OrderState::Pending:
+    return "pending";
+  case OrderState::Acked:
+    return "acked";
+  case OrderState::PartiallyFilled:
+    return "partially_filled";
+  case OrderState::Filled:
+    return "filled";
+  case OrderState::Canceled:
+    return "canceled";
+  case OrderState::Rejected:
+    return "rejected";
+  }
+  return "unknown";
+}
+
+const char *to_string(OrderError error) {
+  switch (error) {
+  case OrderError::PoolExhausted:
+    return "pool_exhausted";
+  case OrderError::IdTooLong:
+    return "id_too_long";
+  case OrderError::DuplicateClientOrderId:
+    return "duplicate_client_order_id";
+  case OrderError::UnknownOrder:
+    return "unknown_order";
+  case OrderError::InvalidTransition:
+    return "invalid_transition";
+  case OrderError::Overfill:
+    return "overfill";
+  }
+  return "unknown";
+}
+
+bool can_transition(OrderState from, OrderState to) {
+  return ALLOWED[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)];
+}
+
+OrderManager::OrderManager(std::uint32_t capacity,
+                           std::string_view client_id_prefix)
+    : capacity_(capacity), slots_(std::make_unique<Slot[]>(capacity)),
+      free_head_(capacity == 0 ? NONE : 0) {
+  for (std::uint32_t i = 0; i < capacity; ++i) {
+    slots_[i].generation = 0;
+    slots_[i].next_free = i + 1 == capacity ? NONE : i + 1;
+  }
+  // Twice the pool keeps probe sequences short and guarantees an empty
+  // bucket, so probing always terminates.
+  auto buckets = std::bit_ceil(std::max<std::uint32_t>(2, 2 * capacity));
+  index_ = std::make_unique<Bucket[]>(buckets);
+  std::fill_n(index_.get(), buckets, Bucket{NONE, 0});
+  index_mask_ = buckets - 1;
+  prefix_.assign(client_id_prefix.substr(0, CLIENT_ID_PREFIX_CAPACITY));
+}
+
+std::expected<OrderHandle, OrderError>
+OrderManager::create(const OrderSpec &spec) {
+  // Prefix plus sequence, built on the stack.
+  std::array<char, ORDER_ID_CAPACITY> chars;
+  auto prefix = prefix_.view();
+  prefix.copy(chars.data(), prefix.size());
+  auto [end, ec] = std::to_chars(chars.data() + prefix.size(),
+                                 chars.data() + chars.size(), next_sequence_);
+  ++next_sequence_;
+  return adopt(spec, std::string_view(chars.data(), end));
+}
+
+std::expected<OrderHandle, OrderError>
+OrderManager::adopt(const OrderSpec &spec, std::string_view client_order_id) {
+  if (client_order_id.size() > ORDER_ID_CAPACITY) {
+    return std::unexpected(OrderError::IdTooLong);
+  }
+  // One probe run serves both the duplicate check and the insert.
+  auto h = hash(client_order_id);
+  auto b = h & index_mask_;
+  for (; index_[b].slot != NONE; b = (b + 1) & index_mask_) {
+    if (index_[b].hash == h &&
+        slots_[index_[b].slot].order.client_order_id.view() == client_order_id) {
+      return std::unexpected(OrderError::DuplicateClientOrderId);
+    }
+  }
+  if (free_head_ == NONE) {
+    return std::unexpected(OrderError::PoolExhausted);
+  }
+
+  auto index = free_head_;
+  auto &slot = slots_[index];
+  free_head_ = slot.next_free;
+  slot.next_free = NONE;
+  slot.order = Order{.client_order_id = {},
+                     .order_id = {},
+                     .market = spec.market,
+                     .side = spec.side,
+                     .action = spec.action,
+                     .state = OrderState::Pending,
+                     .cancel_requested = false,
+                     .price = spec.price,
+                     .count = spec.count,
+                     .filled = 0};
+  slot.order.client_order_id.assign(client_order_id);
+
+  slot.hash = h;
+  index_[b] = Bucket{index, h};
+  ++live_;
+  return OrderHandle{index, slot.generation};
+}
+
+std::optional<OrderHandle>
+OrderManager::find(std::string_view client_order_id) const {
+  auto b = find_bucket(client_order_id);
+  if (!b) {
+    return std::nullopt;
+  }
+  auto index = index_[*b].slot;
+  return OrderHandle{index, slots_[index].generation};
+}
+
+const Order *OrderManager::get(OrderHandle handle) const {
+  return const_cast<OrderManager *>(this)->live_order(handle);
+}
+
+Order *OrderManager::live_order(OrderHandle handle) {
+  if (handle.index >= capacity_) {
+    return nullptr;
+  }
+  auto &slot = slots_[handle.index];
+  if (slot.generation != handle.generation || slot.next_free != NONE) {
+    return nullptr;
+  }
+  return &slot.order;
+}
+
+std::expected<OrderState, OrderError>
+OrderManager::transition(OrderHandle handle, OrderState to) {
+  auto *order = live_order(handle);
+  if (order == nullptr) {
+    return std::unexpected(OrderError::UnknownOrder);
+  }
+  if (!can_transition(order->state, to)) {
+    return std::unexpected(OrderError::InvalidTransition);
+  }
+  order->state = to;
+  return to;
+}
+
+std::expected<OrderState, OrderError>
+OrderManager::on_ack(OrderHandle handle, std::string_view order_id) {
+  auto *order = live_order(handle);
+  if (order == nullptr) {
+    return std::unexpected(OrderError::UnknownOrder);
+  }
+  // A fill can overtake the ack; the ack then only supplies the exchange id.
+  auto late = order->state == OrderState::PartiallyFilled ||
+              order->state == OrderState::Filled;
+  if (order->state != OrderState::Pending && !late) {
+    return std::unexpected(OrderError::InvalidTransition);
+  }
+  if (!order->order_id.assign(order_id)) {
+    return std::unexpected(OrderError::IdTooLong);
+  }
+  if (!late) {
+    order->state = OrderState::Acked;
+  }
+  return order->state;
+}
+
+std::expected<OrderState, OrderError>
+OrderManager::on_fill(OrderHandle handle, std::uint32_t count) {
+  auto *order = live_order(handle);
+  if (order == nullptr) {
+    return std::unexpected(OrderError::UnknownOrder);
+  }
+  if (count > order->count - order->filled) {
+    return std::unexpected(OrderError::Overfill);
+  }
+  auto filled = order->filled + count;
+  auto to = filled == order->count ? OrderState::Filled
+                                   : OrderState::PartiallyFilled;
+  if (!can_transition(order->state, to)) {
+    return std::unexpected(OrderError::InvalidTransition);
+  }
+  order->filled = filled;
+  order->state = to;
+  return to;
+}
+
+std::expected<OrderState, OrderError>
+OrderManager::on_cancel(OrderHandle handle) {
+  return transition(handle, OrderState::Canceled);
+}
+
+std::expected<OrderState, OrderError>
+OrderManager::on_reject(OrderHandle handle) {
+  return transition(handle, OrderState::Rejected);
+}
+
+bool OrderManager::request_cancel(OrderHandle handle) {
+  auto *order = live_order(handle);
+  if (order == nullptr || is_terminal(order->state) ||
+      order->cancel_requested) {
+    return false;
+  }
+  order->cancel_requested = true;
+  return true;
+}
+
+bool OrderManager::clear_cancel(OrderHandle handle) {
+  auto *order = live_order(handle);
+  if (order == nullptr || !order->cancel_requested) {
+    return false;
+  }
+  order->cancel_requested = false;
+  return true;
+}
+
+bool OrderManager::release(OrderHandle handle) {
+  auto *order = live_order(handle);
+  if (order == nullptr) {
+    return false;
+  }
+  // Probe from the stored hash for the slot index: no hashing and no
+  // string compares.
+  auto &slot = slots_[handle.index];
+  auto b = slot.hash & index_mask_;
+  while (index_[b].slot != handle.index) {
+    b = (b + 1) & index_mask_;
+  }
+  erase_bucket(b);
+  ++slot.generation;
+  slot.next_free = free_head_;
+  free_head_ = handle.index;
+  --live_;
+  return true;
+}
+
+std::optional<OrderRequest>
+OrderManager::request(OrderHandle handle, std::string_view ticker) const {
+  const auto *order = get(handle);
+  if (order == nullptr) {
+    return std::nullopt;
+  }
+  return OrderRequest{.ticker = ticker,
+                      .client_order_id = order->client_order_id.view(),
+                      .side = order->side,
+                      .action = order->action,
+                      .count = order->count,
+                      .price = order->price};
+}
+
+std::uint32_t OrderManager::hash(std::string_view client_order_id) {
+  return static_cast<std::uint32_t>(
+      std::hash<std::string_view>{}(client_order_id));
+}
+
+std::optional<std::size_t>
+OrderManager::find_bucket(std::string_view client_order_id) const {
+  auto h = hash(client_order_id);
+  for (auto b = h & index_mask_; index_[b].slot != NONE;
+       b = (b + 1) & index_mask_) {
+    if (index_[b].hash == h &&
+        slots_[index_[b].slot].order.client_order_id.view() == client_order_id) {
+      return b;
+    }
+  }
+  return std::nullopt;
+}
+
+void OrderManager::erase_bucket(std::size_t hole) {
+  // Backward-shift deletion: pull later entries of the probe run into the
+  // hole unless that would move them before their home bucket. No
+  // tombstones, so lookups stay short however long the manager runs.
+  for (auto next = (hole + 1) & index_mask_; index_[next].slot != NONE;
+       next = (next + 1) & index_mask_) {
+    auto home = index_[next].hash & index_mask_;
+    if (((next - home) & index_mask_) >= ((next - hole) & index_mask_)) {
+      index_[hole] = index_[next];
+      hole = next;
+    }
+  }
+  index_[hole] = Bucket{NONE, 0};
+}
+
+} // namespace kalshi::trade
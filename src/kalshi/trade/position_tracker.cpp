@@ -0,0 +1,132 @@
+#include "kalshi/trade/position_tracker.hpp"
+
+#include <algorithm>
+
+namespace kalshi::trade {
+
+PositionTracker::PositionTracker(const md::BookViews &views, FeeSchedule fees)
+    : views_(views), view_index_(views), fee_schedule_(fees) {}
+
+const MarketPosition &PositionTracker::on_fill(const md::FillEvent &fill) {
+  auto &p = record(fill.market_ticker);
+  auto count = static_cast<std::int64_t>(fill.count);
+  auto raises = (fill.side == md::BookSide::Yes) ==
+                (fill.action == md::OrderAction::Buy);
+  auto delta = raises ? count : -count;
+  auto price = static_cast<std::int64_t>(fill.yes_price);
+  auto position = static_cast<std::int64_t>(p.position);
+
+  if (position != 0 && (position > 0) != (delta > 0)) {
+    // The part of the fill against the position closes at the average
+    // entry price. Closing all of it releases the whole cost, so a flat
+    // position always has zero cost.
+    auto held = position > 0 ? position : -position;
+    auto closing = std::min(count, held);
+    auto closed_cost = p.cost * closing / held;
+    auto closing_delta = delta > 0 ? closing : -closing;
+    auto pnl = -closing_delta * price - closed_cost;
+    p.realized += pnl;
+    realized_ += pnl;
+    p.cost -= closed_cost;
+    position += closing_delta;
+    delta -= closing_delta;
+  }
+  p.cost += delta * price;
+  p.position = static_cast<std::int32_t>(position + delta);
+  p.volume += fill.count;
+
+  auto charged = fee(fee_schedule_, fill.yes_price, fill.count, fill.is_taker);
+  p.fees += charged;
+  fees_ += charged;
+  return p;
+}
+
+void PositionTracker::set_position(std::string_view market_ticker,
+                                   std::int32_t position, std::int64_t cost) {
+  auto &p = record(market_ticker);
+  p.position = position;
+  p.cost = position == 0 ? 0 : cost;
+}
+
+std::optional<md::MarketId>
+PositionTracker::find(std::string_view market_ticker) const {
+  return ids_.find(market_ticker);
+}
+
+PositionMark PositionTracker::mark(md::MarketId id) {
+  auto &p = positions_[id];
+  auto mid = mid_x2(p);
+  auto unrealized =
+      mid == 0 ? 0 : (static_cast<std::int64_t>(p.position) * mid - 2 * p.cost) / 2;
+  return PositionMark{.position = p.position,
+                      .realized = p.realized,
+                      .unrealized = unrealized,
+                      .fees = p.fees,
+                      .marked = mid != 0};
+}
+
+PositionMark PositionTracker::mark_all() {
+  PositionMark total{.position = 0,
+                     .realized = realized_,
+                     .unrealized = 0,
+                     .fees = fees_,
+                     .marked = true};
+  for (md::MarketId id = 0; id < positions_.size(); ++id) {
+    if (positions_[id].position == 0) {
+      continue;
+    }
+    auto m = mark(id);
+    total.position += m.position;
+    total.unrealized += m.unrealized;
+    total.marked = total.marked && m.marked;
+  }
+  return total;
+}
+
+std::int64_t PositionTracker::fee(const FeeSchedule &schedule,
+                                  md::Price yes_price, md::Count count,
+                                  bool is_taker) {
+  // rate * C * P * (1 - P) dollars with P = price / 100 and rate = bps /
+  // 10000, in cents and rounded up.
+  constexpr std::uint64_t SCALE = 10'000 * 100;
+  auto bps = is_taker ? schedule.taker_bps : schedule.maker_bps;
+  auto p = static_cast<std::uint64_t>(yes_price);
+  auto scaled = static_cast<std::uint64_t>(bps) * count * p * (md::PRICE_MAX - p);
+  return static_cast<std::int64_t>((scaled + SCALE - 1) / SCALE);
+}
+
+MarketPosition &PositionTracker::record(std::string_view market_ticker) {
+  auto id = ids_.intern(market_ticker);
+  if (id == positions_.size()) {
+    positions_.push_back(MarketPosition{.position = 0,
+                                        .cost = 0,
+                                        .realized = 0,
+                                        .fees = 0,
+                                        .volume = 0,
+                                        .view = NO_VIEW,
+                                        .mid_x2 = 0});
+  }
+  return positions_[id];
+}
+
+std::uint16_t PositionTracker::mid_x2(MarketPosition &p) {
+  if (p.view == NO_VIEW) {
+    auto view = view_index_.find(ids_.ticker(
+        static_cast<md::MarketId>(&p - positions_.data())));
+    if (!view) {
+      return 0;
+    }
+    p.view = *view;
+  }
+  md::TopOfBook top;
+  if (views_.top_lock(p.view).try_read(top)) {
+    // YES bid plus YES ask, where the YES ask is 100 minus the NO bid.
+    p.mid_x2 = top.yes_size == 0 || top.no_size == 0
+                   ? 0
+                   : static_cast<std::uint16_t>(top.yes_price + md::PRICE_MAX -
+                                                top.no_price);
+  }
+  return p.mid_x2;
+}
+
+} // namespace kalshi::trade
@@ -0,0 +1,497 @@
+#include "kalshi/trade/rest_client.hpp"
+
+#include <charconv>
+#include <optional>
+#include <utility>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+
+#include <openssl/err.h>
+
+namespace kalshi::trade {
+
+namespace {
+
+enum class ConnState { Closed, Connecting, Idle, Busy };
+
+void append_uint(std::string &out, std::uint64_t value) {
+  char digits[20];
+  auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+  out.append(digits, end);
+}
+
+} // namespace
+
+struct RestClient::Connection {
+  explicit Connection(boost::asio::io_context &ioc)
+      : keepalive_timer(ioc), retry_timer(ioc) {
+    request.reserve(REQUEST_RESERVE);
+  }
+
+  // Re-created per connect: an SSL stream cannot be reused after a close.
+  std::optional<boost::beast::ssl_stream<boost::beast::tcp_stream>> stream;
+  boost::asio::steady_timer keepalive_timer;
+  boost::asio::steady_timer retry_timer;
+  boost::beast::flat_buffer buffer;
+  boost::beast::http::response<boost::beast::http::string_body> response;
+  std::string request;
+  ResponseCallback callback;
+  ConnState state = ConnState::Closed;
+  bool keepalive_armed = false;
+  bool session_saved = false;
+  std::chrono::steady_clock::time_point last_used;
+};
+
+const char *to_string(RestError error) {
+  switch (error) {
+  case RestError::InvalidUrl:
+    return "invalid_url";
+  case RestError::NotStarted:
+    return "not_started";
+  case RestError::NoIdleConnection:
+    return "no_idle_connection";
+  case RestError::ResolveFailed:
+    return "resolve_failed";
+  case RestError::ConnectFailed:
+    return "connect_failed";
+  case RestError::TlsHandshakeFailed:
+    return "tls_handshake_failed";
+  case RestError::SigningFailed:
+    return "signing_failed";
+  case RestError::WriteFailed:
+    return "write_failed";
+  case RestError::ReadFailed:
+    return "read_failed";
+  case RestError::RateLimited:
+    return "rate_limited";
+  }
+  return "unknown";
+}
+
+std::expected<RestUrl, RestError> parse_rest_url(std::string_view url) {
+  if (!url.starts_with(HTTPS_PREFIX)) {
+    return std::unexpected(RestError::InvalidUrl);
+  }
+
+  std::string_view rest = url.substr(HTTPS_PREFIX.size());
+  auto slash = rest.find('/');
+  std::string_view host_port = rest.substr(0, slash);
+  std::string_view base =
+      slash == std::string_view::npos ? "" : rest.substr(slash);
+  while (base.ends_with('/')) {
+    base.remove_suffix(1);
+  }
+
+  std::string_view host = host_port;
+  std::string_view port = "443";
+  auto colon = host_port.find(':');
+  if (colon != std::string_view::npos) {
+    host = host_port.substr(0, colon);
+    port = host_port.substr(colon + 1);
+  }
+
+  if (host.empty() || port.empty()) {
+    return std::unexpected(RestError::InvalidUrl);
+  }
+
+  return RestUrl{std::string(host), std::string(port), std::string(base)};
+}
+
+void serialize_order(const OrderRequest &order, std::string &out) {
+  // Tickers and client order ids are plain ASCII identifiers, so nothing
+  // needs escaping.
+  out.append("{\"ticker\":\"").append(order.ticker);
+  out.append("\",\"client_order_id\":\"").append(order.client_order_id);
+  out.append("\",\"side\":\"").append(to_wire(order.side));
+  out.append("\",\"action\":\"").append(to_wire(order.action));
+  out.append("\",\"count\":");
+  append_uint(out, order.count);
+  out.append(",\"type\":\"limit\",\"");
+  out.append(to_wire(order.side)).append("_price\":");
+  append_uint(out, order.price);
+  out.push_back('}');
+}
+
+RestClient::RestClient(boost::asio::io_context &ioc,
+                       boost::asio::ssl::context &ssl_ctx,
+                       std::shared_ptr<kalshi::AuthSigner> signer,
+                       RestClientOptions options)
+    : ioc_(ioc), ssl_ctx_(ssl_ctx), resolver_(ioc), signer_(std::move(signer)),
+      options_(std::move(options)) {}
+
+RestClient::~RestClient() = default;
+
+void RestClient::set_error_callback(ErrorCallback cb) {
+  on_error_ = std::move(cb);
+}
+
+void RestClient::set_connection_cache(md::ConnectionCache *cache) {
+  cache_ = cache;
+}
+
+void RestClient::set_rate_limiter(kalshi::RateLimiter *limiter) {
+  rate_limiter_ = limiter;
+}
+
+std::expected<void, RestError> RestClient::start() {
+  auto parsed = parse_rest_url(options_.base_url);
+  if (!parsed) {
+    return std::unexpected(parsed.error());
+  }
+  url_ = std::move(*parsed);
+  orders_path_ = url_.base_path + std::string(ORDERS_PATH);
+
+  header_block_.clear();
+  header_block_.append("Host: ").append(url_.host);
+  if (url_.port != "443") {
+    header_block_.append(":").append(url_.port);
+  }
+  header_block_.append("\r\nUser-Agent: kalshi-autotrader\r\n"
+                       "Accept: application/json\r\n"
+                       "Content-Type: application/json\r\n"
+                       "Connection: keep-alive\r\n");
+
+  started_ = true;
+  stopped_ = false;
+  pool_.clear();
+  for (std::size_t i = 0; i < options_.pool_size; ++i) {
+    pool_.push_back(std::make_unique<Connection>(ioc_));
+    connect(*pool_.back());
+  }
+  return {};
+}
+
+void RestClient::stop() {
+  stopped_ = true;
+  resolver_.cancel();
+  for (auto &conn : pool_) {
+    conn->keepalive_timer.cancel();
+    conn->retry_timer.cancel();
+    if (conn->stream) {
+      boost::system::error_code ec;
+      boost::beast::get_lowest_layer(*conn->stream).socket().close(ec);
+    }
+  }
+}
+
+std::expected<void, RestError>
+RestClient::create_order(const OrderRequest &order, ResponseCallback cb) {
+  body_scratch_.clear();
+  serialize_order(order, body_scratch_);
+  return send("POST", ORDERS_PATH, body_scratch_, std::move(cb));
+}
+
+std::expected<void, RestError>
+RestClient::cancel_order(std::string_view order_id, ResponseCallback cb) {
+  path_scratch_.assign(ORDERS_PATH).append("/").append(order_id);
+  return send("DELETE", path_scratch_, {}, std::move(cb));
+}
+
+std::expected<void, RestError> RestClient::send(std::string_view method,
+                                                std::string_view path,
+                                                std::string_view body,
+                                                ResponseCallback cb) {
+  if (!started_ || stopped_) {
+    return std::unexpected(RestError::NotStarted);
+  }
+  auto *conn = idle_connection();
+  if (conn == nullptr) {
+    return std::unexpected(RestError::NoIdleConnection);
+  }
+
+  full_path_.assign(url_.base_path).append(path);
+  auto &out = conn->request;
+  out.clear();
+  begin_request(out, method, full_path_);
+  if (auto auth = append_auth(out, method); !auth) {
+    return std::unexpected(auth.error());
+  }
+  end_request(out, body);
+  // Spend a token only on a request that will go out.
+  if (rate_limiter_ != nullptr) {
+    auto endpoint = method == "GET" ? kalshi::RateLimitEndpoint::RestRead
+                                    : kalshi::RateLimitEndpoint::RestWrite;
+    if (!rate_limiter_->bucket(endpoint).try_acquire()) {
+      return std::unexpected(RestError::RateLimited);
+    }
+  }
+  issue(*conn, std::move(cb));
+  return {};
+}
+
+std::size_t RestClient::idle_connections() const {
+  std::size_t idle = 0;
+  for (const auto &conn : pool_) {
+    idle += conn->state == ConnState::Idle ? 1 : 0;
+  }
+  return idle;
+}
+
+RestClient::Connection *RestClient::idle_connection() {
+  // First idle connection: the front of the pool stays the most used, so
+  // its TCP window and TLS state are the warmest.
+  for (auto &conn : pool_) {
+    if (conn->state == ConnState::Idle) {
+      return conn.get();
+    }
+  }
+  return nullptr;
+}
+
+void RestClient::begin_request(std::string &out, std::string_view method,
+                               std::string_view path) {
+  out.append(method).append(" ").append(path).append(" HTTP/1.1\r\n");
+  out.append(header_block_);
+}
+
+std::expected<void, RestError> RestClient::append_auth(std::string &out,
+                                                       std::string_view method) {
+  auto append = [&out](const std::vector<kalshi::Header> &headers) {
+    for (const auto &[name, value] : headers) {
+      out.append(name).append(": ").append(value).append("\r\n");
+    }
+  };
+  auto now = kalshi::unix_time_ms();
+  if (signer_->with_presigned(method, full_path_, now,
+                              options_.presigned_max_age.count(), append)) {
+    return {};
+  }
+  auto headers = signer_->build_headers(method, full_path_, now);
+  if (!headers) {
+    return std::unexpected(RestError::SigningFailed);
+  }
+  ++inline_signatures_;
+  append(*headers);
+  return {};
+}
+
+void RestClient::end_request(std::string &out, std::string_view body) {
+  if (!body.empty()) {
+    out.append("Content-Length: ");
+    append_uint(out, body.size());
+    out.append("\r\n");
+  }
+  out.append("\r\n").append(body);
+}
+
+void RestClient::connect(Connection &conn) {
+  if (stopped_) {
+    return;
+  }
+  conn.state = ConnState::Connecting;
+  conn.stream.emplace(ioc_, ssl_ctx_);
+  conn.buffer.clear();
+  conn.session_saved = false;
+  ++connects_;
+
+  if (cache_) {
+    if (auto cached = cache_->endpoints(url_.host, url_.port)) {
+      on_resolve(conn, std::move(*cached));
+      return;
+    }
+  }
+  resolver_.async_resolve(
+      url_.host, url_.port,
+      [this, &conn](boost::system::error_code ec,
+                    boost::asio::ip::tcp::resolver::results_type results) {
+        if (ec) {
+          fail(conn, RestError::ResolveFailed, ec.message());
+          return;
+        }
+        if (cache_) {
+          cache_->store_endpoints(url_.host, url_.port, results);
+        }
+        on_resolve(conn, std::move(results));
+      });
+}
+
+void RestClient::on_resolve(
+    Connection &conn, boost::asio::ip::tcp::resolver::results_type results) {
+  auto &tcp = boost::beast::get_lowest_layer(*conn.stream);
+  tcp.expires_after(options_.connect_timeout);
+  tcp.async_connect(
+      results,
+      [this, &conn](boost::system::error_code ec,
+                    boost::asio::ip::tcp::resolver::results_type::endpoint_type) {
+        on_connect(conn, ec);
+      });
+}
+
+void RestClient::on_connect(Connection &conn, boost::system::error_code ec) {
+  if (ec) {
+    if (cache_) {
+      cache_->invalidate_endpoints();
+    }
+    fail(conn, RestError::ConnectFailed, ec.message());
+    return;
+  }
+  // Requests are single small writes; Nagle would hold them for the ACK of
+  // the previous response.
+  boost::system::error_code opt_ec;
+  boost::beast::get_lowest_layer(*conn.stream)
+      .socket()
+      .set_option(boost::asio::ip::tcp::no_delay(true), opt_ec);
+
+  SSL *ssl = conn.stream->native_handle();
+  if (!SSL_set_tlsext_host_name(ssl, url_.host.c_str())) {
+    boost::system::error_code ssl_ec{static_cast<int>(::ERR_get_error()),
+                                     boost::asio::error::get_ssl_category()};
+    fail(conn, RestError::TlsHandshakeFailed, ssl_ec.message());
+    return;
+  }
+  if (cache_ && cache_->session()) {
+    SSL_set_session(ssl, cache_->session());
+  }
+  conn.stream->async_handshake(
+      boost::asio::ssl::stream_base::client,
+      [this, &conn](boost::system::error_code hs_ec) {
+        on_handshake(conn, hs_ec);
+      });
+}
+
+void RestClient::on_handshake(Connection &conn, boost::system::error_code ec) {
+  if (ec) {
+    if (cache_) {
+      cache_->clear_session();
+    }
+    fail(conn, RestError::TlsHandshakeFailed, ec.message());
+    return;
+  }
+  boost::beast::get_lowest_layer(*conn.stream).expires_never();
+  conn.state = ConnState::Idle;
+  conn.last_used = std::chrono::steady_clock::now();
+  arm_keepalive(conn);
+}
+
+void RestClient::issue(Connection &conn, ResponseCallback cb) {
+  conn.state = ConnState::Busy;
+  conn.callback = std::move(cb);
+  conn.last_used = std::chrono::steady_clock::now();
+  boost::beast::get_lowest_layer(*conn.stream)
+      .expires_after(options_.request_timeout);
+  boost::asio::async_write(
+      *conn.stream, boost::asio::buffer(conn.request),
+      [this, &conn](boost::system::error_code ec, std::size_t) {
+        on_write(conn, ec);
+      });
+}
+
+void RestClient::on_write(Connection &conn, boost::system::error_code ec) {
+  if (ec) {
+    fail(conn, RestError::WriteFailed, ec.message());
+    return;
+  }
+  conn.response = {};
+  boost::beast::http::async_read(
+      *conn.stream, conn.buffer, conn.response,
+      [this, &conn](boost::system::error_code read_ec, std::size_t) {
+        on_read(conn, read_ec);
+      });
+}
+
+void RestClient::on_read(Connection &conn, boost::system::error_code ec) {
+  if (ec) {
+    fail(conn, RestError::ReadFailed, ec.message());
+    return;
+  }
+  boost::beast::get_lowest_layer(*conn.stream).expires_never();
+
+  // TLS 1.3 tickets arrive after the handshake, so the session becomes
+  // resumable only once a response has been read.
+  if (!conn.session_saved) {
+    conn.session_saved = true;
+    if (cache_) {
+      cache_->store_session(SSL_get1_session(conn.stream->native_handle()));
+    }
+  }
+
+  // Mark the connection before the callback so a request issued from the
+  // callback can reuse it, or skips it if the server is closing it.
+  auto reusable = conn.response.keep_alive();
+  conn.state = reusable ? ConnState::Idle : ConnState::Closed;
+  conn.last_used = std::chrono::steady_clock::now();
+  auto cb = std::move(conn.callback);
+  conn.callback = nullptr;
+  if (cb) {
+    cb(RestResponse{conn.response.result_int(), conn.response.body()});
+  }
+  if (!reusable) {
+    close(conn);
+    schedule_reconnect(conn);
+    return;
+  }
+  arm_keepalive(conn);
+}
+
+void RestClient::arm_keepalive(Connection &conn) {
+  if (conn.keepalive_armed || options_.keepalive_interval.count() <= 0) {
+    return;
+  }
+  conn.keepalive_armed = true;
+  conn.keepalive_timer.expires_at(conn.last_used + options_.keepalive_interval);
+  conn.keepalive_timer.async_wait([this, &conn](boost::system::error_code ec) {
+    if (ec == boost::asio::error::operation_aborted) {
+      return;
+    }
+    conn.keepalive_armed = false;
+    on_keepalive(conn);
+  });
+}
+
+void RestClient::on_keepalive(Connection &conn) {
+  // Busy and closed connections re-arm when they next become idle.
+  if (stopped_ || conn.state != ConnState::Idle) {
+    return;
+  }
+  if (std::chrono::steady_clock::now() <
+      conn.last_used + options_.keepalive_interval) {
+    arm_keepalive(conn);
+    return;
+  }
+  full_path_.assign(url_.base_path).append(EXCHANGE_STATUS_PATH);
+  conn.request.clear();
+  begin_request(conn.request, "GET", full_path_);
+  end_request(conn.request, {});
+  issue(conn, nullptr);
+}
+
+void RestClient::fail(Connection &conn, RestError err, std::string_view msg) {
+  close(conn);
+  auto cb = std::move(conn.callback);
+  conn.callback = nullptr;
+  if (cb) {
+    cb(std::unexpected(err));
+  } else if (on_error_ && !stopped_) {
+    on_error_(err, msg);
+  }
+  schedule_reconnect(conn);
+}
+
+void RestClient::close(Connection &conn) {
+  conn.state = ConnState::Closed;
+  conn.keepalive_timer.cancel();
+  conn.keepalive_armed = false;
+  if (conn.stream) {
+    boost::system::error_code ec;
+    boost::beast::get_lowest_layer(*conn.stream).socket().close(ec);
+  }
+}
+
+void RestClient::schedule_reconnect(Connection &conn) {
+  if (stopped_) {
+    return;
+  }
+  conn.retry_timer.expires_after(options_.reconnect_delay);
+  conn.retry_timer.async_wait([this, &conn](boost::system::error_code ec) {
+    if (!ec) {
+      connect(conn);
+    }
+  });
+}
+
+} // namespace kalshi::trade
@@ -0,0 +1,86 @@
+#include "kalshi/trade/risk_engine.hpp"
+
+namespace kalshi::trade {
+
+const char *to_string(RiskReject reject) {
+  switch (reject) {
+  case RiskReject::UnknownMarket:
+    return "unknown_market";
+  case RiskReject::MarketHalted:
+    return "market_halted";
+  case RiskReject::PriceOutOfRange:
+    return "price_out_of_range";
+  case RiskReject::OrderSize:
+    return "order_size";
+  case RiskReject::NoReference:
+    return "no_reference";
+  case RiskReject::PriceBand:
+    return "price_band";
+  case RiskReject::PositionLimit:
+    return "position_limit";
+  case RiskReject::MarketNotional:
+    return "market_notional";
+  case RiskReject::TotalNotional:
+    return "total_notional";
+  case RiskReject::MarketOpenOrders:
+    return "market_open_orders";
+  case RiskReject::TotalOpenOrders:
+    return "total_open_orders";
+  }
+  return "unknown";
+}
+
+RiskEngine::RiskEngine(std::uint32_t market_capacity, RiskLimits limits)
+    : market_capacity_(market_capacity), limits_(limits),
+      markets_(std::make_unique<MarketRisk[]>(market_capacity)) {}
+
+void RiskEngine::on_sent(const OrderSpec &order) {
+  auto &m = markets_[order.market];
+  auto count = static_cast<std::int32_t>(order.count);
+  (raises_position(order) ? m.open_long : m.open_short) += count;
+  auto cost = notional(order, order.count);
+  m.open_notional += cost;
+  total_notional_ += cost;
+  ++m.open_orders;
+  ++total_open_orders_;
+}
+
+void RiskEngine::on_fill(const OrderSpec &order, std::uint32_t count) {
+  auto &m = markets_[order.market];
+  auto filled = static_cast<std::int32_t>(count);
+  if (raises_position(order)) {
+    m.open_long -= filled;
+    m.position += filled;
+  } else {
+    m.open_short -= filled;
+    m.position -= filled;
+  }
+  auto cost = notional(order, count);
+  m.open_notional -= cost;
+  total_notional_ -= cost;
+}
+
+void RiskEngine::on_closed(const OrderSpec &order, std::uint32_t remaining) {
+  auto &m = markets_[order.market];
+  (raises_position(order) ? m.open_long : m.open_short) -=
+      static_cast<std::int32_t>(remaining);
+  auto cost = notional(order, remaining);
+  m.open_notional -= cost;
+  total_notional_ -= cost;
+  --m.open_orders;
+  --total_open_orders_;
+}
+
+void RiskEngine::set_reference(md::MarketId market, md::Price yes_price) {
+  markets_[market].reference = yes_price;
+}
+
+void RiskEngine::set_halted(md::MarketId market, bool halted) {
+  markets_[market].halted = halted;
+}
+
+void RiskEngine::set_position(md::MarketId market, std::int32_t position) {
+  markets_[market].position = position;
+}
+
+} // namespace kalshi::trade
@@ -0,0 +1,133 @@
+#include "kalshi/core/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace kalshi
+{
+
+  namespace
+  {
+    // Pool and deque of the worker running on this thread, if any.
+    thread_local const WorkStealingPool *current_pool = nullptr;
+    thread_local std::size_t current_queue = 0;
+  } // namespace
+
+  WorkStealingPool::WorkStealingPool(std::size_t threads)
+  {
+    if (threads == 0)
+    {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queue_count_ = threads;
+    queues_ = std::make_unique<Queue[]>(threads);
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+      threads_.emplace_back([this, i] { work(i); });
+    }
+  }
+
+  WorkStealingPool::~WorkStealingPool()
+  {
+    wait();
+    {
+      std::lock_guard lock(state_mutex_);
+      stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto &thread : threads_)
+    {
+      thread.join();
+    }
+  }
+
+  void WorkStealingPool::submit(Task task)
+  {
+    auto local = current_pool == this;
+    auto target = local ? current_queue
+                        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queue_count_;
+    {
+      // Counted before the task becomes visible, so it cannot finish
+      // first; and raising queued_ under the lock a sleeping worker checks
+      // it under means the notify cannot fall between its check and wait.
+      std::lock_guard state(state_mutex_);
+      ++unfinished_;
+      queued_.fetch_add(1, std::memory_order_relaxed);
+      std::lock_guard lock(queues_[target].mutex);
+      auto &tasks = queues_[target].tasks;
+      if (local)
+      {
+        tasks.push_front(std::move(task));
+      }
+      else
+      {
+        tasks.push_back(std::move(task));
+      }
+    }
+    work_cv_.notify_one();
+  }
+
+  void WorkStealingPool::wait()
+  {
+    std::unique_lock lock(state_mutex_);
+    idle_cv_.wait(lock, [this] { return unfinished_ == 0; });
+  }
+
+  void WorkStealingPool::work(std::size_t self)
+  {
+    current_pool = this;
+    current_queue = self;
+    for (;;)
+    {
+      Task task;
+      if (take(self, task))
+      {
+        task();
+        std::lock_guard lock(state_mutex_);
+        if (--unfinished_ == 0)
+        {
+          idle_cv_.notify_all();
+        }
+        continue;
+      }
+      std::unique_lock lock(state_mutex_);
+      work_cv_.wait(lock,
+                    [this] { return stopping_ || queued_.load(std::memory_order_relaxed) != 0; });
+      if (stopping_ && queued_.load(std::memory_order_relaxed) == 0)
+      {
+        return;
+      }
+    }
+  }
+
+  bool WorkStealingPool::take(std::size_t self, Task &task)
+  {
+    {
+      auto &own = queues_[self];
+      std::lock_guard lock(own.mutex);
+      if (!own.tasks.empty())
+      {
+        task = std::move(own.tasks.front());
+        own.tasks.pop_front();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    for (std::size_t i = 1; i < queue_count_; ++i)
+    {
+      auto &victim = queues_[(self + i) % queue_count_];
+      std::lock_guard lock(victim.mutex);
+      if (!victim.tasks.empty())
+      {
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        steals_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+} // namespace kalshi